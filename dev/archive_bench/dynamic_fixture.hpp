@@ -0,0 +1,568 @@
+#pragma once
+
+//
+// gzip-файл, сжатый zlib (уровень 9), для проверки распаковки блоков
+// deflate с динамическими кодами Хаффмана. Сам archive_bench сжимает
+// только фиксированными кодами.
+//
+// Внутри 163840 байт текста: строки, случайно выбранные из 48 строк-шаблонов
+// со случайными английскими словами. Каждые 40 КБ текста завершают
+// блок, поэтому в потоке несколько динамических блоков, а распакованные
+// данные больше буфера inflater-а и отдаются несколькими порциями.
+//
+// Получен так (Python 3):
+//
+//   z = zlib.compressobj( 9, zlib.DEFLATED, 31 )
+//   для каждых 40 КБ текста: z.compress( part ) + z.flush( zlib.Z_BLOCK )
+//   в конце: z.flush()
+//
+
+#include <cstddef>
+#include <cstdint>
+
+const std::uint32_t dynamic_fixture_crc = 0x7953161b;
+const std::size_t dynamic_fixture_size = 163840;
+
+const unsigned char dynamic_fixture_gz[] = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xcc, 0x5d, 0xdb, 0x76, 0xea, 0x38,
+  0x0c, 0x7d, 0xe7, 0x2b, 0xf2, 0x6b, 0xa1, 0xa4, 0x87, 0xac, 0x03, 0x49, 0x17, 0xd0, 0x61, 0xf5,
+  0xef, 0x47, 0x92, 0x4d, 0xd7, 0x3c, 0x80, 0xec, 0xbd, 0x65, 0x87, 0x79, 0x38, 0x33, 0x6d, 0x21,
+  0x8e, 0xac, 0xfb, 0xcd, 0xf2, 0xc7, 0x78, 0x3a, 0x0d, 0xe3, 0x7e, 0xfd, 0xbe, 0x0d, 0xb7, 0xe3,
+  0xa4, 0xff, 0xce, 0xc3, 0xba, 0x4c, 0xc3, 0x75, 0x9c, 0x0f, 0xc3, 0x41, 0xfe, 0xc9, 0x5f, 0xae,
+  0xd3, 0x70, 0x5f, 0x2f, 0x87, 0xdd, 0x7d, 0xfd, 0x3e, 0x1d, 0x86, 0xfb, 0xf8, 0x23, 0xdf, 0x18,
+  0xe6, 0xab, 0x7e, 0xb4, 0xd8, 0x27, 0xc3, 0x51, 0x7e, 0x3b, 0x8f, 0xcb, 0xcf, 0xee, 0x38, 0x9f,
+  0x87, 0x83, 0x7c, 0x61, 0x59, 0xef, 0xc3, 0x61, 0xbd, 0xcb, 0xc7, 0xd3, 0x45, 0x9e, 0x3e, 0xce,
+  0x1f, 0xc7, 0x61, 0x3f, 0xc9, 0xd7, 0x8f, 0xf2, 0x81, 0xbc, 0xe7, 0xb4, 0x2e, 0x7f, 0x76, 0xfb,
+  0x69, 0xf8, 0xb3, 0xca, 0x2a, 0xf2, 0xf0, 0x69, 0x5d, 0xff, 0xda, 0x7b, 0x6d, 0x4d, 0x83, 0x67,
+  0x67, 0x90, 0x2d, 0xfa, 0xed, 0xe3, 0x74, 0x19, 0xa6, 0x51, 0x96, 0x90, 0x4f, 0x65, 0x39, 0x5d,
+  0x78, 0x77, 0x9f, 0xf2, 0x6f, 0xf3, 0x4d, 0x20, 0x99, 0xcf, 0xd3, 0xf0, 0xfd, 0x35, 0x7c, 0x24,
+  0x08, 0xed, 0x75, 0x77, 0x5d, 0x69, 0x59, 0x77, 0xb6, 0x93, 0xeb, 0x31, 0x3d, 0xa6, 0x90, 0xeb,
+  0x5e, 0xd3, 0x1b, 0x14, 0x8a, 0xf4, 0x46, 0xdd, 0xfb, 0xcf, 0xfa, 0x7d, 0x19, 0xd6, 0xf9, 0x64,
+  0x3b, 0x31, 0x04, 0xec, 0x3e, 0x00, 0xec, 0x7c, 0x4d, 0xeb, 0xd7, 0x49, 0xf7, 0xba, 0xda, 0xee,
+  0x3f, 0xd7, 0x4b, 0x06, 0x30, 0xa3, 0x4d, 0xfe, 0xae, 0x7b, 0xd8, 0x9d, 0x57, 0xf9, 0xdb, 0xb2,
+  0xde, 0x86, 0xfb, 0x2c, 0x8b, 0x7f, 0x5e, 0xd6, 0xb3, 0xbc, 0xf0, 0x30, 0x0d, 0x9f, 0xf3, 0xe5,
+  0x7a, 0xcb, 0xb0, 0xcb, 0x83, 0xf3, 0xe5, 0xb1, 0x1b, 0xfb, 0xef, 0x5e, 0x40, 0xb0, 0xdf, 0x77,
+  0x8a, 0x8f, 0xf1, 0x1f, 0x59, 0x76, 0xbc, 0x09, 0x5a, 0x74, 0x59, 0x43, 0xde, 0x28, 0x20, 0xae,
+  0x3b, 0x43, 0xf7, 0x59, 0x08, 0xa0, 0xff, 0x12, 0xc2, 0x33, 0x4e, 0xff, 0xac, 0x8a, 0x6f, 0xc1,
+  0xe7, 0xfd, 0x32, 0xdf, 0xf4, 0x87, 0x43, 0xc2, 0xf7, 0x5d, 0x29, 0x30, 0x25, 0x8a, 0x9d, 0xc7,
+  0xbf, 0x93, 0xfd, 0x90, 0xd0, 0x73, 0x3b, 0x8e, 0x4b, 0x06, 0x25, 0x7d, 0x6d, 0x4c, 0xc8, 0xcb,
+  0x24, 0x3f, 0x67, 0x90, 0xed, 0x29, 0x43, 0xcd, 0x7c, 0xdb, 0x19, 0xd6, 0x15, 0x16, 0x79, 0xc0,
+  0xb0, 0x77, 0x1f, 0xaf, 0x8f, 0x4d, 0x3d, 0xd6, 0x98, 0x6f, 0x0f, 0xe0, 0x47, 0xe5, 0x98, 0xab,
+  0x6c, 0xec, 0x9c, 0x58, 0x22, 0xa1, 0x5e, 0xf7, 0xba, 0xac, 0xc3, 0xfa, 0x99, 0x78, 0x63, 0x55,
+  0x34, 0x66, 0x64, 0xd8, 0x1f, 0x6c, 0xfb, 0xc6, 0x6e, 0x0a, 0xab, 0xe0, 0x79, 0x5e, 0x8c, 0xc0,
+  0xb6, 0x0f, 0x03, 0x4e, 0x48, 0x59, 0xa4, 0xbb, 0x00, 0x99, 0x50, 0x21, 0x3c, 0x38, 0x67, 0x80,
+  0x15, 0x8e, 0xef, 0xab, 0x22, 0xf8, 0x60, 0x9c, 0x90, 0x37, 0x9f, 0xd6, 0x35, 0xe4, 0xcb, 0x6e,
+  0xd2, 0xae, 0x33, 0xf3, 0x2d, 0xb7, 0x35, 0xff, 0xa8, 0xd8, 0xb4, 0x85, 0xf7, 0x8a, 0xcc, 0x9b,
+  0x4f, 0x0a, 0xe1, 0xd5, 0xfb, 0x51, 0x20, 0xd0, 0xed, 0x2c, 0x6b, 0x7e, 0x8f, 0x02, 0xab, 0x6f,
+  0xdf, 0x27, 0x00, 0x0e, 0x02, 0xd7, 0xa7, 0xe1, 0x4f, 0xe1, 0xc2, 0x31, 0x9b, 0x7e, 0x32, 0x90,
+  0x94, 0x19, 0x95, 0x5d, 0x0d, 0x26, 0x43, 0x4c, 0xe6, 0xd6, 0xfc, 0x3f, 0x95, 0x4a, 0xe3, 0x44,
+  0x5d, 0x57, 0xf0, 0x31, 0x5e, 0xa6, 0xdd, 0xa8, 0xe0, 0xff, 0xfc, 0xe2, 0x5d, 0xc8, 0x2b, 0x1b,
+  0x4b, 0xb2, 0x60, 0xcb, 0x3c, 0xb8, 0xf3, 0x92, 0x50, 0x95, 0x57, 0x3a, 0xcd, 0x7f, 0x43, 0x8f,
+  0xba, 0x58, 0x93, 0x35, 0x6d, 0x35, 0xfd, 0x4c, 0x76, 0x64, 0xcc, 0x62, 0xcc, 0x70, 0x4c, 0x5b,
+  0x48, 0xf4, 0x54, 0xfd, 0xa3, 0x88, 0x33, 0xd4, 0x18, 0xb1, 0x76, 0xc6, 0x36, 0x99, 0xf1, 0x0d,
+  0x0c, 0xc3, 0x81, 0xfd, 0x35, 0x4b, 0x71, 0x52, 0x01, 0x82, 0xf2, 0xc4, 0x6d, 0x19, 0x24, 0x13,
+  0x62, 0xd5, 0x2d, 0x86, 0xcb, 0x9d, 0xae, 0x6c, 0xdc, 0x74, 0x30, 0x14, 0x0d, 0x57, 0xe5, 0x97,
+  0xe5, 0xfb, 0xbc, 0x9f, 0x2e, 0x99, 0x01, 0x4d, 0x95, 0x95, 0x55, 0x9b, 0xc7, 0xb7, 0xf5, 0x2f,
+  0x11, 0x6a, 0xdb, 0xe2, 0xf6, 0xe8, 0xd7, 0x78, 0xb9, 0x25, 0x9d, 0x67, 0x0a, 0x26, 0x31, 0x69,
+  0xda, 0x4c, 0xda, 0xb8, 0xb0, 0x4b, 0x41, 0xa5, 0xd6, 0xbf, 0xd9, 0x5f, 0xe7, 0xa6, 0x9c, 0x6d,
+  0xdc, 0x69, 0x1c, 0x2a, 0xbf, 0xd8, 0xaa, 0xba, 0x84, 0x31, 0x99, 0x30, 0x7c, 0x56, 0x7b, 0x3f,
+  0x89, 0x51, 0x6b, 0x55, 0x79, 0x8d, 0x01, 0xaa, 0x17, 0x50, 0xdd, 0x44, 0x96, 0xbf, 0xac, 0x7b,
+  0xec, 0xef, 0x2a, 0x63, 0x49, 0xc1, 0x26, 0xfa, 0xcb, 0xff, 0x04, 0x73, 0x19, 0x0d, 0x09, 0xa1,
+  0x42, 0x37, 0xdd, 0x5a, 0x56, 0xdb, 0xa2, 0x49, 0x65, 0x29, 0x65, 0xce, 0xc3, 0x9a, 0x14, 0xbb,
+  0x01, 0x6d, 0x4b, 0xc9, 0x17, 0xe7, 0xdb, 0xd1, 0x58, 0x52, 0x35, 0xb5, 0xd0, 0x57, 0x64, 0x77,
+  0x19, 0xcc, 0x36, 0x8c, 0x49, 0x1a, 0x3c, 0x45, 0x55, 0x7e, 0x6b, 0xd1, 0x84, 0xdd, 0x4d, 0x3a,
+  0x92, 0x2e, 0xd8, 0x4f, 0x86, 0x3c, 0x92, 0x79, 0x32, 0x30, 0xf6, 0x35, 0x91, 0x2f, 0x65, 0x92,
+  0xc5, 0x58, 0x56, 0x31, 0x66, 0x3c, 0xa0, 0x18, 0x4c, 0x4b, 0x09, 0x55, 0x29, 0xeb, 0x31, 0x99,
+  0x3c, 0xea, 0x9a, 0xaa, 0x01, 0xff, 0x23, 0xc2, 0xbf, 0xb6, 0xf4, 0x52, 0xb0, 0x80, 0xbc, 0x6e,
+  0xf7, 0x99, 0x1a, 0xd1, 0xfc, 0x31, 0xc5, 0x5b, 0x87, 0x04, 0xe3, 0x2b, 0xb5, 0xe8, 0xf2, 0xa0,
+  0x1a, 0x4c, 0xd5, 0x9e, 0xca, 0x3c, 0xf6, 0xda, 0xb4, 0x79, 0xfb, 0x93, 0x59, 0x0a, 0x5b, 0x22,
+  0x5b, 0x17, 0x25, 0xa5, 0xe2, 0x4c, 0xf8, 0xd5, 0xc8, 0xa1, 0xeb, 0x3c, 0x36, 0x2b, 0x08, 0x11,
+  0x20, 0x74, 0xfb, 0x86, 0x17, 0xa5, 0x52, 0xfa, 0x68, 0xcd, 0x1a, 0x30, 0x64, 0xad, 0x43, 0x20,
+  0x87, 0x6c, 0xca, 0x73, 0x11, 0x80, 0x9c, 0x55, 0x5a, 0xbc, 0xe9, 0x07, 0x51, 0x35, 0x5a, 0xeb,
+  0x80, 0xc2, 0xea, 0x19, 0x75, 0x3c, 0xa2, 0x1e, 0x6e, 0x23, 0x6b, 0x6d, 0xbc, 0xa0, 0xbb, 0x36,
+  0x2d, 0x6e, 0xa6, 0xc2, 0xa4, 0x75, 0x3e, 0x99, 0xe2, 0xba, 0xe6, 0x15, 0xe6, 0x93, 0x32, 0x48,
+  0x72, 0xb3, 0x14, 0x0e, 0x7d, 0x85, 0xd8, 0x1f, 0x63, 0x00, 0x13, 0xf2, 0xf4, 0x0e, 0xe3, 0x4c,
+  0xa5, 0x51, 0x12, 0x88, 0xfb, 0x5a, 0x70, 0xc4, 0x0d, 0xfc, 0xfd, 0x4f, 0xfe, 0xd4, 0x16, 0xda,
+  0x9b, 0xdd, 0x32, 0x7c, 0x98, 0x9b, 0xf7, 0xad, 0x98, 0x37, 0xda, 0x2b, 0xbd, 0xe4, 0xd3, 0xf3,
+  0x8f, 0x29, 0xa1, 0xc4, 0x7b, 0x63, 0x02, 0xd1, 0xde, 0x7b, 0x34, 0x99, 0x05, 0xc9, 0x80, 0x04,
+  0x2f, 0xd5, 0x26, 0x18, 0x8d, 0x21, 0x38, 0xd4, 0xb2, 0xd8, 0x83, 0x24, 0xda, 0xa5, 0x1f, 0x6c,
+  0xec, 0x94, 0x9d, 0xd3, 0xb7, 0x6f, 0x09, 0x19, 0xc2, 0xad, 0x7b, 0xc3, 0xea, 0xc3, 0x85, 0x32,
+  0x19, 0x48, 0xbc, 0x6e, 0x18, 0xce, 0x38, 0x59, 0xcb, 0x81, 0xee, 0x53, 0xed, 0x45, 0x3b, 0xc3,
+  0x1c, 0x49, 0x92, 0x39, 0x7b, 0x58, 0x21, 0xd9, 0xac, 0xbe, 0x63, 0x9f, 0x78, 0xeb, 0x3a, 0x15,
+  0xf6, 0xe0, 0xb8, 0x38, 0x95, 0xd6, 0x8e, 0x64, 0x88, 0x02, 0xd4, 0x10, 0xbf, 0x78, 0x4e, 0x7b,
+  0x24, 0x58, 0x72, 0x31, 0x57, 0xda, 0x80, 0x9f, 0x0c, 0x78, 0xce, 0x39, 0x5b, 0xe4, 0x01, 0x6c,
+  0x2d, 0x21, 0x87, 0x61, 0x31, 0x21, 0xc2, 0x00, 0xb5, 0xdf, 0x93, 0xf7, 0x7a, 0xf9, 0xf5, 0x82,
+  0x12, 0x76, 0x54, 0x4d, 0x1f, 0x7f, 0x95, 0x77, 0xc4, 0x57, 0x20, 0xa2, 0x6b, 0xe2, 0x11, 0x97,
+  0xa9, 0x9d, 0x28, 0x36, 0xa4, 0x2b, 0x32, 0x9b, 0xd8, 0x53, 0x89, 0x6b, 0xd4, 0xc5, 0x52, 0x71,
+  0x57, 0x84, 0xdd, 0x93, 0x02, 0x4f, 0x68, 0xad, 0x57, 0xea, 0x78, 0x2c, 0xe0, 0x6e, 0x90, 0x34,
+  0xa7, 0x88, 0x2c, 0x72, 0xaf, 0x70, 0x25, 0xd8, 0x15, 0x43, 0x43, 0x8a, 0xbc, 0x30, 0x91, 0x5a,
+  0x24, 0xd8, 0x58, 0xd8, 0x80, 0xc3, 0x0d, 0xb3, 0xb7, 0x98, 0xc3, 0x54, 0x8c, 0x18, 0x16, 0xf2,
+  0x10, 0xb0, 0x2b, 0x98, 0x3c, 0xb5, 0x5f, 0x1e, 0x14, 0x50, 0x94, 0x64, 0x0a, 0x4a, 0x44, 0x05,
+  0xfa, 0x5a, 0xac, 0xda, 0x8d, 0x0b, 0x05, 0x27, 0xb5, 0xde, 0x33, 0xc6, 0xa6, 0x6c, 0x9c, 0x05,
+  0xe5, 0x26, 0x60, 0x06, 0xac, 0x4f, 0xf4, 0xb0, 0x76, 0x37, 0xa4, 0xbe, 0x21, 0x14, 0xe3, 0xba,
+  0x0b, 0xf1, 0x8b, 0x1b, 0x71, 0x66, 0xa3, 0x88, 0x06, 0x8f, 0xdc, 0x48, 0xf6, 0xf3, 0x34, 0x54,
+  0xa3, 0xbd, 0xbc, 0x0e, 0x74, 0x22, 0x91, 0x7e, 0x35, 0x45, 0x6a, 0xc5, 0x9d, 0x33, 0x34, 0x05,
+  0xb5, 0x4b, 0x38, 0x1b, 0xd1, 0x98, 0xda, 0x35, 0xd8, 0x05, 0x27, 0xd3, 0xd3, 0xfa, 0xe5, 0xfc,
+  0x23, 0xab, 0x41, 0x02, 0x01, 0xb4, 0x13, 0x4c, 0x45, 0x14, 0xf2, 0xeb, 0x65, 0x51, 0x8f, 0xba,
+  0x00, 0xa4, 0x92, 0x78, 0x7d, 0x90, 0xee, 0xe1, 0x06, 0x2a, 0xc3, 0x18, 0x33, 0x25, 0xf5, 0x64,
+  0x2b, 0xa6, 0x8f, 0x1e, 0x64, 0x5d, 0xd6, 0x0a, 0x32, 0x7b, 0xb4, 0xfa, 0x65, 0x81, 0x9f, 0xcc,
+  0x0d, 0x4a, 0xe6, 0x8f, 0xfc, 0x8e, 0x83, 0xfa, 0x91, 0xca, 0xfe, 0x2a, 0xfe, 0x0a, 0xa1, 0xfc,
+  0xb8, 0x02, 0x75, 0x58, 0xc0, 0xe8, 0xc4, 0xf2, 0xa7, 0xb0, 0x96, 0xe4, 0xd1, 0x7d, 0xcc, 0xdb,
+  0x30, 0x2d, 0x65, 0x3a, 0x52, 0x45, 0x54, 0xe9, 0x6c, 0x7e, 0x88, 0x11, 0x40, 0x59, 0x4e, 0xc1,
+  0x14, 0x1f, 0xc4, 0xd4, 0xea, 0xbe, 0x36, 0xc3, 0x5b, 0x8f, 0x30, 0x30, 0x59, 0x81, 0x9b, 0xcc,
+  0x4d, 0xca, 0x95, 0xe5, 0xe2, 0x8e, 0xe7, 0xbf, 0x17, 0x54, 0x6e, 0xc5, 0xea, 0x05, 0x2d, 0x58,
+  0xd6, 0x74, 0x35, 0xed, 0x11, 0x01, 0x0f, 0x15, 0x27, 0x1b, 0x9f, 0x22, 0x62, 0xd5, 0x64, 0x20,
+  0x29, 0xd5, 0x2b, 0x62, 0x6e, 0xe4, 0xaf, 0x80, 0x32, 0xe6, 0x3b, 0x8e, 0x01, 0x05, 0x1f, 0x71,
+  0xac, 0x51, 0xcd, 0xc8, 0xd7, 0xd2, 0x0a, 0xe4, 0x6c, 0xe5, 0x0d, 0xe3, 0x05, 0x46, 0xd6, 0x1b,
+  0xd9, 0x26, 0x08, 0x05, 0x8a, 0x8c, 0x3c, 0x6d, 0x9c, 0x14, 0x43, 0xdf, 0x60, 0x0a, 0x0b, 0x6a,
+  0x5f, 0x24, 0x2f, 0x4b, 0x6d, 0x3d, 0x05, 0x05, 0xce, 0x75, 0xfd, 0x00, 0x49, 0xb7, 0x58, 0x85,
+  0x94, 0xd5, 0xbb, 0x15, 0xb6, 0xa7, 0x55, 0x55, 0x8d, 0xcb, 0xbc, 0x15, 0x1b, 0x19, 0x48, 0x57,
+  0x0a, 0xe2, 0x29, 0x30, 0xf2, 0x67, 0xe0, 0x01, 0x24, 0xb8, 0x36, 0x04, 0x75, 0x73, 0x8f, 0x31,
+  0x73, 0x10, 0x49, 0x44, 0x23, 0x49, 0x9a, 0xa2, 0xef, 0x54, 0x8b, 0x8b, 0x82, 0x88, 0x87, 0xab,
+  0x0e, 0x14, 0x73, 0x87, 0xf0, 0x58, 0xf4, 0x5b, 0x6b, 0x0d, 0x0f, 0x13, 0xbc, 0xb5, 0x8d, 0x5b,
+  0x7b, 0x35, 0x20, 0x34, 0xb1, 0x1b, 0x0c, 0x7a, 0x18, 0x0f, 0xc3, 0x4f, 0x9d, 0x85, 0xd9, 0xf3,
+  0x45, 0x23, 0x4b, 0xc0, 0xe6, 0xf0, 0x66, 0xb1, 0x4b, 0x83, 0x41, 0xb0, 0x8c, 0x50, 0x5d, 0x1b,
+  0x83, 0xc3, 0xd3, 0x88, 0xa6, 0xe5, 0x71, 0x1c, 0xd2, 0x2d, 0xd5, 0x35, 0x0d, 0x00, 0x71, 0x9d,
+  0xaa, 0xe0, 0xfd, 0xba, 0x05, 0x79, 0x9f, 0x2a, 0x54, 0xc3, 0xe0, 0xdc, 0x87, 0x6e, 0x7e, 0x12,
+  0xaa, 0x73, 0xa3, 0xf9, 0x66, 0xbc, 0x59, 0x14, 0x6d, 0x19, 0x7e, 0xaa, 0x09, 0x81, 0x56, 0xe2,
+  0xea, 0xe6, 0x30, 0x36, 0x64, 0x44, 0x35, 0x0c, 0x63, 0xa1, 0xb0, 0x6a, 0x24, 0xdb, 0x55, 0xc5,
+  0xb2, 0x5c, 0x40, 0x75, 0x45, 0x52, 0x24, 0x70, 0x3d, 0xbe, 0x52, 0x4d, 0x62, 0xfd, 0xf1, 0xcf,
+  0x8b, 0x5b, 0x6e, 0x5e, 0xa8, 0xd0, 0x81, 0x0c, 0x35, 0xb7, 0x61, 0x7d, 0xf0, 0x6e, 0x69, 0xa3,
+  0x9c, 0x57, 0x7d, 0x5e, 0x1b, 0x8a, 0x24, 0xd6, 0xeb, 0xc1, 0x0f, 0x9d, 0x22, 0xf3, 0xac, 0x59,
+  0xc4, 0x68, 0x37, 0x0a, 0xb5, 0xfd, 0x9c, 0x68, 0xc8, 0x97, 0x64, 0x0c, 0x2e, 0xdf, 0x23, 0x53,
+  0x2f, 0x3a, 0x88, 0x2f, 0x52, 0x0c, 0x2b, 0x1d, 0x39, 0x44, 0x84, 0x09, 0x0a, 0x40, 0x0a, 0x21,
+  0x2a, 0x77, 0x68, 0xa7, 0x3e, 0xfc, 0xe1, 0x65, 0x2e, 0xa6, 0xaf, 0x3b, 0x17, 0x3f, 0x68, 0x2f,
+  0x8e, 0x97, 0xe2, 0xae, 0xd5, 0xd0, 0x00, 0x9d, 0x22, 0x11, 0x52, 0x84, 0x04, 0xf4, 0x41, 0x06,
+  0xd7, 0xe6, 0xf1, 0x25, 0xd4, 0xf6, 0x4d, 0xcc, 0xad, 0xe2, 0xa0, 0xba, 0xc0, 0x84, 0xe7, 0xcc,
+  0x5a, 0x87, 0x25, 0x5e, 0x13, 0x7d, 0x53, 0x36, 0xfb, 0x95, 0x77, 0x1f, 0x6b, 0x0c, 0xd8, 0x58,
+  0x15, 0x94, 0xb1, 0xcb, 0x94, 0xd5, 0x3b, 0x04, 0x38, 0x8e, 0x0b, 0x57, 0xea, 0x2f, 0x8f, 0x9e,
+  0xd6, 0xc3, 0xad, 0x21, 0xd7, 0x8c, 0x8e, 0x76, 0x84, 0x04, 0x22, 0x7f, 0xcf, 0x0d, 0xea, 0xdc,
+  0xd9, 0xd8, 0xf6, 0x7c, 0x2c, 0xad, 0xef, 0x09, 0xc0, 0xe9, 0x36, 0xd3, 0x48, 0xeb, 0xce, 0x6b,
+  0xb6, 0x0c, 0x1c, 0x34, 0xc7, 0xb9, 0x93, 0xd0, 0x02, 0x80, 0x3b, 0x8d, 0x70, 0x1c, 0x74, 0xbe,
+  0x1d, 0x3b, 0x06, 0x56, 0x6a, 0x21, 0xe4, 0x4e, 0xec, 0xf2, 0x9e, 0x10, 0x81, 0x74, 0x97, 0x63,
+  0x42, 0xce, 0xb3, 0xeb, 0x4b, 0x74, 0xe9, 0x83, 0x74, 0xdf, 0x48, 0x1f, 0x0e, 0x06, 0x8e, 0x48,
+  0x07, 0x73, 0xab, 0xaf, 0x09, 0xe1, 0xf4, 0x07, 0x78, 0x9a, 0x39, 0x3c, 0x95, 0x05, 0x4a, 0xc4,
+  0x39, 0xd2, 0x10, 0x62, 0xa4, 0xe8, 0x2e, 0xfc, 0xe2, 0x15, 0x78, 0x1c, 0xd9, 0x59, 0xab, 0xe0,
+  0x87, 0x97, 0x4f, 0xad, 0x30, 0xb5, 0x82, 0xde, 0x67, 0x92, 0x70, 0xb3, 0x47, 0x46, 0x98, 0xcf,
+  0x7d, 0x63, 0x56, 0x6a, 0x3d, 0x55, 0xd0, 0x28, 0x91, 0xe5, 0xb1, 0x42, 0xa4, 0xdb, 0x9f, 0xde,
+  0x32, 0xd8, 0xcb, 0x17, 0x1a, 0x51, 0x54, 0xac, 0xe8, 0xe0, 0x7c, 0x53, 0x38, 0x95, 0xe2, 0x64,
+  0x64, 0x23, 0xcd, 0x3b, 0xb5, 0xe8, 0x42, 0xca, 0xc2, 0xf4, 0xf8, 0x12, 0xb8, 0xbe, 0xd4, 0x26,
+  0x23, 0x1b, 0x9a, 0x60, 0x01, 0xe5, 0xf1, 0xea, 0x1b, 0x0e, 0x7b, 0x8c, 0x21, 0x40, 0x32, 0x21,
+  0xa8, 0x2f, 0xd8, 0xbe, 0xdc, 0x02, 0x38, 0x1e, 0x58, 0x61, 0x01, 0xf3, 0x71, 0x37, 0x2c, 0x59,
+  0xb1, 0x59, 0x33, 0xd7, 0xf1, 0xa0, 0x02, 0x6b, 0xbc, 0x41, 0xa6, 0x92, 0xfc, 0x65, 0xc5, 0xd9,
+  0xfe, 0x10, 0x30, 0xd4, 0x86, 0x46, 0x85, 0x2c, 0xa0, 0xde, 0x0a, 0x58, 0xc7, 0x16, 0x73, 0x06,
+  0x6b, 0x55, 0x00, 0x93, 0xc8, 0xe2, 0xa5, 0xe5, 0x2d, 0x01, 0xe3, 0x7b, 0x1e, 0x6d, 0x31, 0x00,
+  0x8c, 0xf5, 0x92, 0xf8, 0x4e, 0xeb, 0xed, 0xce, 0x19, 0x38, 0x30, 0x76, 0x39, 0x60, 0x4a, 0x27,
+  0x86, 0xa0, 0x16, 0xf2, 0x77, 0xf4, 0x5b, 0xb4, 0xcf, 0x2b, 0x47, 0xe1, 0x61, 0xe6, 0x06, 0xe1,
+  0x5d, 0x7d, 0xdb, 0xd9, 0x6c, 0x6f, 0x5e, 0x08, 0xe9, 0xa6, 0x95, 0xd5, 0x43, 0xb4, 0x4d, 0xc0,
+  0xf5, 0x2e, 0xb9, 0xfa, 0x45, 0x45, 0xcd, 0xc0, 0x43, 0x15, 0x4f, 0x31, 0xa8, 0x09, 0x81, 0x72,
+  0xaf, 0x58, 0x55, 0x1b, 0x12, 0x95, 0x82, 0x32, 0xee, 0xde, 0x56, 0xe6, 0x67, 0x1a, 0xe9, 0x2a,
+  0x42, 0xd1, 0xb0, 0xf9, 0x43, 0xa5, 0x9a, 0x4d, 0x14, 0xa5, 0x55, 0x7e, 0x2c, 0xc9, 0x15, 0x19,
+  0xef, 0xd5, 0xb5, 0xf8, 0xdc, 0xbe, 0x71, 0x28, 0x56, 0x64, 0xe6, 0x0c, 0x85, 0x97, 0x24, 0x89,
+  0x55, 0x99, 0x91, 0xf4, 0xc7, 0x06, 0x07, 0x92, 0xfa, 0x1e, 0xe9, 0xf3, 0xe7, 0x40, 0x79, 0x48,
+  0xee, 0x52, 0xd6, 0x28, 0x88, 0x1c, 0xb2, 0x33, 0x30, 0x50, 0xc3, 0x3d, 0x8f, 0x2a, 0x31, 0xf5,
+  0xb7, 0x5b, 0x1c, 0x1c, 0x48, 0xb9, 0x50, 0xb4, 0x0d, 0x6b, 0x93, 0x62, 0x23, 0x19, 0x83, 0xd6,
+  0x97, 0xdc, 0xc1, 0xa0, 0x36, 0x7b, 0x45, 0x99, 0xa6, 0xec, 0xef, 0xfd, 0xef, 0x32, 0x18, 0xd5,
+  0xa6, 0xb8, 0x53, 0x91, 0xc0, 0x6f, 0xc7, 0x08, 0x19, 0x1e, 0x47, 0xf5, 0x21, 0x6d, 0x16, 0xd1,
+  0x9a, 0x5d, 0xfd, 0xa9, 0x3b, 0xd8, 0x6e, 0xd3, 0x42, 0x85, 0xe6, 0x4e, 0x19, 0x21, 0x0c, 0x1f,
+  0x51, 0x69, 0x90, 0x08, 0x44, 0x33, 0x1d, 0xa5, 0x8e, 0xbc, 0x16, 0xc2, 0xe2, 0x99, 0xdd, 0xde,
+  0x56, 0x8d, 0x0a, 0x36, 0xea, 0x65, 0x25, 0x7c, 0x80, 0xb2, 0x4b, 0x1b, 0x0a, 0x8c, 0xa5, 0x50,
+  0xb8, 0x47, 0x95, 0x0b, 0xa9, 0xa3, 0xec, 0x40, 0xca, 0xaa, 0xcf, 0xdc, 0x17, 0x7a, 0x55, 0x3a,
+  0xe8, 0x84, 0x6a, 0x74, 0x38, 0x25, 0xd8, 0x96, 0xbe, 0x97, 0xcd, 0x99, 0xd4, 0xc8, 0x84, 0x40,
+  0xc5, 0x3d, 0x36, 0x6e, 0xa0, 0x89, 0xd3, 0xe4, 0x77, 0x93, 0x83, 0x43, 0x64, 0x9f, 0xb7, 0x52,
+  0xbc, 0xeb, 0x0c, 0x45, 0xaf, 0x21, 0xec, 0x9b, 0x48, 0x32, 0x3f, 0x5c, 0xb7, 0xdb, 0x34, 0xbc,
+  0xe8, 0xa4, 0xe5, 0xee, 0x03, 0x49, 0xa0, 0x2f, 0x43, 0x77, 0x4f, 0xbd, 0x3a, 0x1e, 0xeb, 0x68,
+  0x5b, 0xf2, 0x32, 0xad, 0x5e, 0xf9, 0x8e, 0xf7, 0x5c, 0x70, 0x12, 0x1e, 0xce, 0xdd, 0x60, 0x5a,
+  0x2c, 0x3c, 0x95, 0x83, 0x57, 0xe8, 0xc4, 0x75, 0x0e, 0x75, 0x2a, 0x8a, 0x77, 0x08, 0x82, 0x97,
+  0xe7, 0xf4, 0x4b, 0xec, 0x41, 0x95, 0xaf, 0xe8, 0x9c, 0x8f, 0x3a, 0x2c, 0x47, 0x5f, 0x04, 0xb7,
+  0x6a, 0xbd, 0xce, 0xad, 0xd5, 0x47, 0x4c, 0x1b, 0x0c, 0xb4, 0x88, 0x13, 0xc0, 0xd1, 0x93, 0xc0,
+  0x54, 0x8d, 0x8d, 0xdd, 0xb3, 0xff, 0x5b, 0x14, 0xfd, 0xae, 0x93, 0x8a, 0xad, 0xda, 0x56, 0xb7,
+  0x60, 0xe9, 0xe8, 0x04, 0xaf, 0x18, 0x9f, 0x07, 0x35, 0x62, 0xf0, 0x71, 0xf8, 0x62, 0x29, 0x36,
+  0xac, 0x43, 0x14, 0x6a, 0x80, 0x94, 0xec, 0x29, 0xa6, 0x17, 0xde, 0x5a, 0xc1, 0x2f, 0x66, 0x8f,
+  0xed, 0x95, 0x2e, 0x6f, 0xec, 0x76, 0x93, 0x51, 0x21, 0xf9, 0xc5, 0xdc, 0x42, 0xd2, 0x3c, 0x80,
+  0x63, 0x2b, 0xff, 0xfc, 0x1b, 0xcb, 0xa9, 0x3c, 0x7f, 0x26, 0x32, 0x98, 0xd1, 0x43, 0xbc, 0x50,
+  0xf7, 0x0a, 0xd3, 0x7e, 0x17, 0x62, 0xb2, 0x72, 0x44, 0x1e, 0xa7, 0x20, 0x8a, 0x64, 0xdd, 0x1a,
+  0x5f, 0x5e, 0x72, 0x34, 0x5b, 0x2e, 0x7d, 0xc3, 0xe9, 0x8a, 0x02, 0xe3, 0x44, 0xee, 0xe3, 0xee,
+  0x71, 0xfa, 0x39, 0x14, 0x66, 0xc6, 0x66, 0x96, 0xe3, 0x33, 0xa5, 0x19, 0xdd, 0xe4, 0x29, 0x98,
+  0x6d, 0x20, 0x28, 0xd2, 0xb5, 0xe5, 0x35, 0x6d, 0x21, 0x82, 0xb6, 0xa8, 0x09, 0x81, 0x39, 0x48,
+  0x27, 0xd2, 0xa0, 0x14, 0x5a, 0xf0, 0xd6, 0xef, 0xc2, 0xf5, 0x19, 0x78, 0x97, 0x03, 0xd3, 0x83,
+  0xd0, 0x23, 0x31, 0x0b, 0x17, 0xea, 0xb0, 0xc4, 0x48, 0x83, 0xd1, 0x14, 0x9e, 0x00, 0xbc, 0x63,
+  0x6e, 0x0b, 0x72, 0xca, 0x3c, 0x52, 0x48, 0xdf, 0xfa, 0x1a, 0xa5, 0x20, 0xad, 0x36, 0xb9, 0x66,
+  0x8c, 0x6a, 0xa1, 0xf7, 0x54, 0x2c, 0xe1, 0xb2, 0x30, 0x65, 0x86, 0x97, 0x51, 0x07, 0x39, 0x7f,
+  0x97, 0xb8, 0x9e, 0xce, 0x35, 0xc7, 0xf5, 0x33, 0x4b, 0x6a, 0x0b, 0x26, 0xd1, 0x18, 0xbc, 0xd1,
+  0x30, 0x9f, 0xf2, 0x2c, 0x34, 0xde, 0x15, 0xf4, 0x3b, 0x6d, 0x19, 0x05, 0xcf, 0x2b, 0xf2, 0x1e,
+  0xe7, 0x69, 0x61, 0xb3, 0xd6, 0xad, 0x62, 0xc5, 0x0c, 0xe4, 0xae, 0x2e, 0x20, 0x35, 0xbb, 0x77,
+  0x23, 0x78, 0xa4, 0xa0, 0xfd, 0x88, 0x7c, 0x7e, 0x64, 0x05, 0x72, 0x2c, 0x07, 0xa8, 0xbf, 0xc5,
+  0x2c, 0x4c, 0x8b, 0xa3, 0x7b, 0xce, 0xa4, 0x92, 0x7e, 0x67, 0x36, 0xdf, 0x55, 0xab, 0x2d, 0xf4,
+  0x97, 0xfb, 0x43, 0xac, 0x1c, 0x07, 0xdc, 0x53, 0x7c, 0x1b, 0xe7, 0x3e, 0xf9, 0x2b, 0xd1, 0xa3,
+  0xb3, 0xe1, 0x0b, 0x37, 0xaa, 0x38, 0x5e, 0x6b, 0xbd, 0xc0, 0x10, 0x3a, 0x3b, 0x86, 0xff, 0x72,
+  0x23, 0x1e, 0x61, 0xd6, 0x7a, 0xce, 0xfe, 0xa7, 0x3a, 0xeb, 0x02, 0x73, 0x22, 0xa2, 0x93, 0xdd,
+  0x5a, 0xf9, 0xea, 0x15, 0x23, 0xcd, 0x00, 0x1d, 0xbe, 0x61, 0xa9, 0xdc, 0xd1, 0x1d, 0xd0, 0x45,
+  0x05, 0xa4, 0xdc, 0x97, 0x73, 0x69, 0xa1, 0xc4, 0x57, 0xf3, 0xb4, 0x05, 0x25, 0x70, 0x9b, 0xce,
+  0x69, 0x8b, 0x5f, 0x50, 0x08, 0xf1, 0x0f, 0x1d, 0xb6, 0x37, 0x2c, 0xea, 0x87, 0xc7, 0x74, 0xd5,
+  0x72, 0x39, 0x02, 0x73, 0xbb, 0x8b, 0xac, 0x2a, 0x73, 0xc9, 0x31, 0x4b, 0x43, 0x04, 0xde, 0x0d,
+  0xc7, 0xd4, 0xbe, 0x61, 0xb2, 0x22, 0x1c, 0xb5, 0x07, 0x8e, 0x82, 0x55, 0xc7, 0x3e, 0xee, 0xc0,
+  0xbb, 0xb2, 0x60, 0xc7, 0x6e, 0xa5, 0xe1, 0x4e, 0xf3, 0x77, 0x1f, 0xbd, 0xc5, 0x28, 0xc1, 0x8a,
+  0x71, 0x13, 0xdc, 0x99, 0xa6, 0xea, 0x02, 0xe6, 0x5b, 0x5b, 0x16, 0xb6, 0xbe, 0x46, 0xa5, 0x7d,
+  0x01, 0xf8, 0xf5, 0x58, 0x0c, 0x70, 0x30, 0x4f, 0xc7, 0xab, 0x5d, 0x2a, 0x7c, 0x4f, 0xea, 0x32,
+  0xdc, 0xc0, 0x41, 0x74, 0xf2, 0x16, 0xd4, 0x4a, 0x13, 0x53, 0x33, 0xc7, 0xa1, 0xd7, 0xfd, 0x48,
+  0x6d, 0xc7, 0xb5, 0xbd, 0x55, 0x3a, 0xdf, 0x70, 0x90, 0x7c, 0x73, 0x85, 0x10, 0xf1, 0xc8, 0xbc,
+  0x74, 0xc6, 0x96, 0x17, 0x88, 0xd6, 0xf6, 0x62, 0xe1, 0x2c, 0x4f, 0xcd, 0x13, 0xef, 0x7a, 0x19,
+  0x61, 0x85, 0x04, 0xf6, 0x3c, 0xd5, 0x06, 0x5c, 0x22, 0x5f, 0x38, 0xbf, 0x81, 0x5d, 0x80, 0xe2,
+  0x29, 0x89, 0x6d, 0x67, 0xed, 0x6e, 0x91, 0x1a, 0x26, 0x4e, 0x00, 0xf6, 0x70, 0xbd, 0x08, 0x47,
+  0xfa, 0x5f, 0xe6, 0xae, 0x65, 0x31, 0x8e, 0x18, 0x84, 0xfd, 0xff, 0x5f, 0xf7, 0xd0, 0xeb, 0x8e,
+  0xd0, 0x03, 0xe1, 0x5c, 0x9b, 0x66, 0x37, 0x33, 0xb6, 0x31, 0x08, 0x21, 0xfd, 0xe7, 0x1f, 0x16,
+  0x7d, 0x86, 0x40, 0xcc, 0x49, 0x3f, 0xba, 0xe6, 0xfd, 0x6b, 0x5e, 0xb6, 0x64, 0x39, 0xb9, 0xc2,
+  0x2d, 0x97, 0xdd, 0x77, 0xbf, 0xcb, 0xc9, 0xf4, 0x38, 0xf6, 0x59, 0xb9, 0x67, 0xd2, 0x27, 0x28,
+  0x06, 0xf2, 0x91, 0x54, 0x20, 0x9f, 0x3d, 0xcc, 0x77, 0x82, 0x92, 0x76, 0x42, 0x8d, 0x64, 0x35,
+  0xd3, 0xe4, 0x39, 0x7c, 0x03, 0x21, 0x0e, 0xe2, 0xf6, 0x75, 0x56, 0x61, 0x36, 0x35, 0xbd, 0xc3,
+  0x75, 0x9e, 0x02, 0xca, 0x12, 0xa4, 0x48, 0x9a, 0x5f, 0xdf, 0xf7, 0xab, 0xbd, 0x4c, 0x6b, 0x13,
+  0x62, 0x01, 0xad, 0xe8, 0x40, 0x46, 0x7e, 0xdc, 0x56, 0x38, 0x55, 0xad, 0x8b, 0x34, 0xc4, 0x44,
+  0x62, 0x4f, 0x6b, 0x76, 0x72, 0xca, 0x7d, 0x3a, 0xa6, 0x1e, 0x01, 0xa4, 0x00, 0xfd, 0x36, 0x13,
+  0x75, 0xf2, 0x73, 0x84, 0x33, 0x99, 0x99, 0x20, 0x0f, 0x4b, 0xdb, 0x6c, 0x31, 0x30, 0x38, 0x63,
+  0x86, 0x01, 0xfe, 0xa2, 0x78, 0x3b, 0x9a, 0x56, 0xc9, 0xa9, 0xf4, 0x49, 0x3b, 0xba, 0xa1, 0x83,
+  0x29, 0x8d, 0xdc, 0x1b, 0xf0, 0x91, 0x8a, 0x26, 0x7c, 0xce, 0x89, 0xfd, 0x86, 0x74, 0x5f, 0xcf,
+  0x07, 0xa2, 0xe0, 0x4a, 0x28, 0xf9, 0x59, 0x11, 0x32, 0x81, 0x6b, 0x91, 0x3a, 0x82, 0x86, 0x7a,
+  0xd3, 0x8c, 0x29, 0x36, 0x3f, 0x98, 0xf3, 0x45, 0xba, 0x96, 0x02, 0xa3, 0x81, 0xfe, 0x25, 0xd0,
+  0xbb, 0xd2, 0x93, 0xfa, 0x92, 0x42, 0xdf, 0xfe, 0xde, 0x1f, 0x4e, 0x7f, 0x85, 0x33, 0x88, 0xd6,
+  0xbd, 0xb4, 0xe4, 0xee, 0x50, 0x62, 0x77, 0x65, 0x8b, 0x4c, 0x24, 0x37, 0x95, 0x9e, 0x54, 0x24,
+  0x23, 0x6f, 0x89, 0xef, 0x00, 0x16, 0x66, 0x4e, 0x3b, 0x11, 0x17, 0xc0, 0xaa, 0xde, 0x3c, 0x9c,
+  0x43, 0x38, 0xe8, 0xb2, 0xed, 0xf6, 0xc2, 0xcc, 0xf4, 0x6d, 0xc1, 0xd9, 0x5d, 0x7a, 0x67, 0xe2,
+  0x89, 0x3d, 0xb4, 0x05, 0x8d, 0xae, 0xa3, 0x95, 0x66, 0x55, 0xf3, 0x78, 0x4e, 0xb0, 0xec, 0x93,
+  0xe0, 0x16, 0xfd, 0x72, 0x1f, 0x09, 0xf6, 0x06, 0xaf, 0x7f, 0x66, 0xcd, 0x74, 0x86, 0xe6, 0x76,
+  0x55, 0x98, 0x8e, 0xaa, 0x75, 0x52, 0x41, 0x00, 0xfb, 0x2e, 0x05, 0x82, 0x68, 0xe4, 0x5f, 0xd0,
+  0x7b, 0x2d, 0xe3, 0x4b, 0x25, 0xeb, 0x00, 0x98, 0x88, 0xe4, 0xc9, 0x0d, 0x86, 0xa8, 0xcb, 0x7e,
+  0xbd, 0xe2, 0x66, 0xc3, 0xaa, 0x1e, 0xfc, 0xcc, 0xe9, 0xe3, 0x5f, 0x3d, 0x93, 0xba, 0x4c, 0x4e,
+  0x37, 0xb1, 0x6d, 0x14, 0x1e, 0xcd, 0xc8, 0x8f, 0x51, 0x48, 0xfa, 0xeb, 0x11, 0x29, 0x25, 0x28,
+  0x55, 0x1c, 0xb7, 0x57, 0x0f, 0xc7, 0x3c, 0x30, 0x50, 0xad, 0x0e, 0xf5, 0xdb, 0x04, 0x55, 0x9d,
+  0x38, 0x83, 0x67, 0xb4, 0x78, 0xb6, 0x45, 0xb5, 0x82, 0xb5, 0xc6, 0x17, 0xe4, 0x71, 0x2e, 0xf7,
+  0x19, 0xd2, 0xb2, 0xcd, 0x87, 0xc7, 0x34, 0x5f, 0x10, 0xeb, 0x00, 0xf2, 0x70, 0xeb, 0x9c, 0x3c,
+  0x9b, 0x99, 0x68, 0x7e, 0xd2, 0x3e, 0xf2, 0x2f, 0xdb, 0x29, 0xe5, 0x23, 0x7f, 0x55, 0x4e, 0x0c,
+  0x69, 0x23, 0x98, 0xab, 0x3b, 0xd6, 0xda, 0x53, 0xb0, 0xef, 0x90, 0x8c, 0x48, 0x59, 0x47, 0xc1,
+  0x28, 0x43, 0x94, 0xd3, 0x63, 0xa1, 0x7a, 0x62, 0x00, 0x62, 0x57, 0x14, 0xbe, 0xf8, 0xa8, 0x73,
+  0x9c, 0x92, 0x1f, 0x78, 0x94, 0xf4, 0x95, 0xe2, 0x79, 0x21, 0xa1, 0xd8, 0xf0, 0x22, 0xaf, 0xb9,
+  0x3f, 0xf8, 0x90, 0x85, 0xbb, 0x91, 0xb4, 0x19, 0xa0, 0xad, 0x49, 0x89, 0x37, 0xa0, 0xb5, 0x94,
+  0x55, 0xab, 0x4b, 0xed, 0xb7, 0x9a, 0x2f, 0x72, 0x47, 0xa2, 0xe4, 0x40, 0x6d, 0xad, 0x29, 0xdc,
+  0xf0, 0x81, 0x64, 0xb2, 0x3a, 0x74, 0xeb, 0xf1, 0x44, 0xfb, 0x20, 0x08, 0x6e, 0x29, 0xfd, 0x50,
+  0xd8, 0x90, 0x05, 0x2d, 0x9f, 0xa6, 0xb4, 0x01, 0x1e, 0x9d, 0x3f, 0x74, 0x8d, 0xe5, 0x7d, 0xe2,
+  0x76, 0x71, 0xbf, 0x13, 0xa7, 0x63, 0x3b, 0x4d, 0xa7, 0x8c, 0x6f, 0x5f, 0x34, 0x16, 0xed, 0x71,
+  0xdb, 0x68, 0x18, 0x7f, 0x9b, 0x2b, 0x5a, 0xa0, 0xd2, 0x5c, 0x4a, 0xd5, 0xab, 0x08, 0x5d, 0x60,
+  0x28, 0xff, 0x6d, 0x32, 0x7e, 0x3d, 0x67, 0xe9, 0x0b, 0xc4, 0x28, 0x69, 0xc5, 0xac, 0x66, 0xda,
+  0x34, 0xa3, 0xe6, 0xf1, 0x81, 0x91, 0x7d, 0x09, 0x07, 0x94, 0x6c, 0xf4, 0xe0, 0x4a, 0x2f, 0x01,
+  0x5e, 0x4f, 0x07, 0xbc, 0x13, 0x07, 0xd3, 0x8e, 0x22, 0xb2, 0x51, 0x12, 0xdf, 0x78, 0x31, 0x3d,
+  0x21, 0xaa, 0x25, 0xdb, 0xec, 0x04, 0xde, 0xac, 0xcc, 0x31, 0x45, 0x65, 0x7c, 0xa9, 0xa5, 0x37,
+  0xe4, 0x89, 0xa7, 0x34, 0xa3, 0x3d, 0x01, 0xfd, 0xe0, 0x4d, 0x3f, 0xa3, 0x15, 0x79, 0x5c, 0x6f,
+  0x64, 0x84, 0x20, 0xeb, 0x16, 0x70, 0x11, 0xe3, 0x3b, 0x33, 0xc8, 0xe6, 0xb3, 0xed, 0xa4, 0x15,
+  0x7c, 0xad, 0x01, 0x99, 0x00, 0x9f, 0xb7, 0x60, 0xc4, 0x60, 0x5f, 0x33, 0x12, 0x2a, 0xc2, 0x58,
+  0xed, 0x8b, 0x50, 0x63, 0x06, 0x2d, 0x83, 0xed, 0xad, 0x27, 0xbc, 0xb8, 0x41, 0x12, 0xcf, 0x30,
+  0x4f, 0x2f, 0xa6, 0x82, 0x21, 0xf7, 0xe0, 0xa6, 0xdd, 0xd8, 0xa9, 0xf5, 0x23, 0x3d, 0x12, 0x4b,
+  0xe2, 0x62, 0x49, 0x36, 0x56, 0x8b, 0xa7, 0x5e, 0xc6, 0x17, 0x6d, 0x2a, 0x7e, 0xac, 0xcf, 0x4e,
+  0xb1, 0x8d, 0xa7, 0x7a, 0xe0, 0x02, 0x20, 0x44, 0x0d, 0xe7, 0xaf, 0x4b, 0x12, 0x39, 0xd7, 0xf5,
+  0xc8, 0x44, 0xaa, 0x75, 0xb2, 0x4f, 0xb6, 0x05, 0x0f, 0x64, 0xda, 0x13, 0xfa, 0xc4, 0xef, 0x4e,
+  0xf4, 0x5a, 0xdb, 0x7e, 0xf1, 0x0a, 0xc2, 0xd7, 0x22, 0xd9, 0x10, 0x47, 0x20, 0x01, 0x6a, 0x8c,
+  0xa2, 0x9f, 0x25, 0xb9, 0xb5, 0xdf, 0x5f, 0x53, 0x27, 0xf2, 0xd1, 0x51, 0xaa, 0x14, 0x77, 0x5c,
+  0x8b, 0x87, 0xbd, 0xb3, 0x5f, 0xc4, 0x4c, 0xf4, 0xca, 0x88, 0xa7, 0x13, 0x32, 0x5c, 0xb0, 0xbb,
+  0x04, 0xcf, 0x8e, 0x6e, 0x8c, 0xbf, 0xe0, 0x30, 0x1c, 0x38, 0x9b, 0x38, 0x00, 0xef, 0xf5, 0x95,
+  0xf8, 0x11, 0x96, 0x15, 0xc1, 0x92, 0x5e, 0x71, 0x39, 0xef, 0xfc, 0xc4, 0xab, 0x39, 0xd6, 0x0f,
+  0xfa, 0xbd, 0x82, 0x0b, 0x02, 0xfc, 0x4e, 0xb2, 0xb1, 0xa1, 0xfb, 0xcf, 0x46, 0xc8, 0xf5, 0x01,
+  0x55, 0x2a, 0x80, 0x3b, 0x6f, 0x45, 0xba, 0x46, 0x34, 0x40, 0x51, 0x96, 0x35, 0x33, 0x1b, 0xc6,
+  0x12, 0x75, 0xf2, 0x10, 0x00, 0x8b, 0xd4, 0xd0, 0xb7, 0x32, 0xb5, 0xa6, 0x5c, 0x41, 0x4f, 0x33,
+  0x4d, 0xbd, 0xab, 0x86, 0xed, 0x23, 0xea, 0x4e, 0x9c, 0x11, 0xb3, 0x22, 0xd8, 0x2a, 0x88, 0xec,
+  0x3b, 0xb4, 0x79, 0x19, 0x80, 0x89, 0xfc, 0x4b, 0x6a, 0x22, 0x8e, 0x99, 0x9f, 0x6d, 0x92, 0x95,
+  0x1e, 0xf0, 0x12, 0x8e, 0x9d, 0xf6, 0xa8, 0xba, 0x90, 0xc5, 0xbb, 0x0b, 0x3c, 0x89, 0xb9, 0xee,
+  0x24, 0x2f, 0xee, 0xe3, 0x2c, 0xb4, 0x77, 0x97, 0x04, 0xb6, 0xda, 0x06, 0xda, 0xb9, 0xef, 0xb3,
+  0xf2, 0x48, 0x95, 0xc9, 0x2e, 0x8e, 0x14, 0xd1, 0x9b, 0x58, 0xb4, 0x67, 0xd5, 0x63, 0xf0, 0xc6,
+  0xcd, 0x36, 0x62, 0xff, 0x99, 0x17, 0xa2, 0x69, 0xa9, 0xf2, 0xb3, 0x2e, 0xb4, 0x93, 0x81, 0xac,
+  0x46, 0x6d, 0x4d, 0x5e, 0xc5, 0x3e, 0x50, 0xa7, 0xf8, 0x6e, 0x09, 0x19, 0x1c, 0x9a, 0x80, 0x67,
+  0xfe, 0xc9, 0x4c, 0x5b, 0xce, 0xce, 0xb8, 0x5d, 0xbd, 0x11, 0x3e, 0x9e, 0xa9, 0x3d, 0x2a, 0x95,
+  0xb2, 0x45, 0xdb, 0x54, 0x81, 0x31, 0xb2, 0x6d, 0x4d, 0x7f, 0x87, 0xca, 0x05, 0x72, 0x7e, 0xad,
+  0x90, 0x01, 0xf7, 0x47, 0x55, 0x98, 0xbd, 0x1e, 0xca, 0x42, 0x21, 0x9a, 0xae, 0x74, 0x8f, 0xb2,
+  0x3d, 0x2c, 0x45, 0xfd, 0x86, 0xb7, 0x56, 0x1a, 0x79, 0xfd, 0x6b, 0xef, 0x88, 0x60, 0xf1, 0x22,
+  0xaf, 0x68, 0x07, 0xfb, 0x74, 0xd1, 0x1a, 0xcc, 0x6c, 0x61, 0xc5, 0xce, 0xe7, 0x00, 0xd4, 0xa0,
+  0x27, 0x01, 0x8b, 0x94, 0xb4, 0x05, 0xda, 0xa1, 0x02, 0x66, 0xcc, 0x2b, 0xc5, 0xed, 0xf4, 0xc4,
+  0xc6, 0xb2, 0x79, 0x09, 0x52, 0x0a, 0x27, 0xd1, 0xd0, 0x4c, 0xa1, 0xa1, 0x12, 0x52, 0x20, 0x3c,
+  0x58, 0x39, 0x78, 0x28, 0x04, 0xe3, 0x8f, 0x28, 0xd9, 0x72, 0x53, 0x8e, 0x9e, 0x10, 0xcd, 0x8e,
+  0x17, 0xf6, 0x2d, 0xdf, 0xa4, 0xa3, 0xbb, 0xee, 0x6a, 0xf9, 0x0e, 0xd7, 0x0d, 0x8e, 0x7f, 0xd3,
+  0x2f, 0x64, 0x86, 0xe1, 0xf9, 0x77, 0x5b, 0x11, 0x80, 0x1f, 0xb4, 0xf1, 0x4b, 0xea, 0xba, 0xd1,
+  0xb4, 0x88, 0x18, 0x1b, 0xad, 0x4b, 0xd4, 0x7c, 0xd9, 0xe2, 0x84, 0x13, 0x08, 0xa6, 0x67, 0xdc,
+  0xa6, 0x48, 0xcb, 0x5e, 0x0e, 0xdc, 0x45, 0xd5, 0xc0, 0xb0, 0x34, 0xc8, 0x24, 0xef, 0xe7, 0x7e,
+  0xc2, 0x82, 0x98, 0x89, 0xdb, 0x46, 0xc6, 0x6e, 0xd5, 0xc1, 0x63, 0x6b, 0x82, 0xa6, 0x69, 0x9b,
+  0xa8, 0xae, 0x3e, 0xec, 0x6c, 0xe8, 0x82, 0x21, 0x46, 0x70, 0x46, 0xbc, 0xf9, 0xd4, 0x25, 0x96,
+  0xf3, 0x5f, 0xfa, 0x98, 0x86, 0x67, 0xd1, 0x42, 0x1d, 0x1e, 0xf8, 0x70, 0xc2, 0x24, 0xe2, 0x23,
+  0xb8, 0x38, 0xdb, 0xc1, 0xae, 0xfc, 0x0c, 0xde, 0x9b, 0xcf, 0xad, 0x42, 0x42, 0x31, 0x57, 0x9e,
+  0x59, 0xaf, 0xc4, 0x75, 0x1e, 0xba, 0x9d, 0x38, 0xf5, 0xdd, 0x00, 0x99, 0x7e, 0x65, 0x98, 0x4b,
+  0x3c, 0x08, 0x33, 0x2b, 0x12, 0xd8, 0xa4, 0xb0, 0x14, 0x55, 0x4a, 0x12, 0xda, 0x3b, 0xed, 0x31,
+  0xb9, 0x64, 0xc0, 0x4a, 0x0c, 0x83, 0xe2, 0x3c, 0x75, 0x8b, 0x02, 0xf3, 0xf0, 0x40, 0x46, 0x60,
+  0x6b, 0x0a, 0xb4, 0x64, 0x12, 0xa6, 0xf6, 0x3c, 0xdd, 0x1b, 0x55, 0xee, 0x71, 0x30, 0xf4, 0x77,
+  0xe9, 0xca, 0x08, 0x1d, 0x98, 0x4f, 0x83, 0xda, 0x1b, 0xd7, 0x03, 0x6a, 0x0c, 0xc5, 0x58, 0x25,
+  0x82, 0x05, 0xd6, 0x4b, 0xdf, 0x4c, 0x90, 0x7d, 0x6d, 0x61, 0xe3, 0x50, 0xd6, 0xed, 0x79, 0x5b,
+  0xfa, 0x26, 0x2c, 0xc8, 0x88, 0xff, 0xcb, 0x93, 0x4e, 0x89, 0xf8, 0xa8, 0xc6, 0xaa, 0x0e, 0x93,
+  0xd7, 0x9f, 0x19, 0xc6, 0x23, 0x11, 0x0a, 0x8d, 0xd3, 0x8d, 0x0e, 0x95, 0x8f, 0x57, 0x2f, 0x58,
+  0x61, 0xd6, 0x94, 0x1a, 0xe7, 0xf8, 0x0a, 0x6e, 0xc6, 0x7c, 0x8e, 0xa9, 0x3a, 0x66, 0xc5, 0x43,
+  0xbd, 0x12, 0x6d, 0x85, 0xea, 0x39, 0xf9, 0xaa, 0x66, 0x42, 0x0a, 0xdb, 0x33, 0x8c, 0x08, 0x72,
+  0x5e, 0x59, 0xcc, 0xe2, 0x67, 0x29, 0xfd, 0xf9, 0xef, 0x8b, 0x44, 0x0e, 0xd4, 0x72, 0x90, 0x9f,
+  0x23, 0x63, 0x4e, 0x37, 0xb8, 0x3d, 0x6f, 0xc4, 0xa5, 0x58, 0x49, 0xdd, 0x79, 0x0b, 0xe6, 0x32,
+  0x27, 0x15, 0x49, 0xe1, 0x2c, 0xdc, 0xbe, 0xe3, 0xfd, 0x8b, 0xba, 0x76, 0x1b, 0xed, 0xf9, 0x63,
+  0xc6, 0x3d, 0xf6, 0x47, 0x88, 0x34, 0xba, 0x7c, 0x49, 0x75, 0x4b, 0x07, 0x43, 0xc7, 0xc5, 0xd9,
+  0x25, 0xc9, 0xd4, 0x2a, 0xc3, 0x84, 0x3d, 0x43, 0x64, 0xbf, 0x13, 0x11, 0xa8, 0x87, 0x63, 0x5e,
+  0x92, 0x80, 0xd6, 0x63, 0x0b, 0x3c, 0xa0, 0x33, 0x85, 0xec, 0xb6, 0x45, 0xf9, 0xdb, 0x6a, 0x53,
+  0x05, 0x9d, 0x84, 0x4b, 0xb5, 0x5a, 0xf5, 0x17, 0xc0, 0xfb, 0x1d, 0x56, 0x46, 0x77, 0xfa, 0xbe,
+  0x1a, 0x07, 0xf1, 0x6b, 0xcc, 0xd0, 0x6e, 0x37, 0xba, 0xc5, 0x22, 0xb5, 0xdc, 0x52, 0x47, 0x47,
+  0xac, 0x9b, 0xfb, 0x0e, 0x25, 0xad, 0x51, 0xa5, 0xc8, 0x1a, 0x83, 0xbc, 0x63, 0x02, 0x79, 0x72,
+  0x91, 0x15, 0xaf, 0xd5, 0x6d, 0x20, 0x74, 0xc5, 0x62, 0x82, 0xfe, 0x89, 0xd0, 0x99, 0x27, 0xaa,
+  0x44, 0x66, 0xcb, 0x49, 0x7d, 0x73, 0x44, 0x6a, 0x3c, 0xa1, 0xd2, 0x54, 0x43, 0xd6, 0x74, 0xa3,
+  0x95, 0x0d, 0x60, 0xfd, 0x78, 0xc4, 0xf3, 0x78, 0x66, 0x60, 0xf7, 0x47, 0xaa, 0xe7, 0x13, 0xa0,
+  0x05, 0x85, 0x0e, 0x65, 0xb1, 0xac, 0xde, 0x6c, 0x54, 0x70, 0xa6, 0x81, 0xcd, 0x13, 0x3b, 0xfd,
+  0xfd, 0x20, 0x18, 0xc4, 0x14, 0x42, 0xf9, 0x74, 0x39, 0x1e, 0x74, 0xa1, 0xa5, 0x9b, 0xa7, 0x38,
+  0xab, 0xf6, 0x88, 0x9b, 0x70, 0x27, 0x0c, 0xc1, 0x26, 0x1d, 0x82, 0xd2, 0x52, 0x34, 0x40, 0x2e,
+  0xdd, 0xd5, 0xa8, 0xa8, 0xdb, 0x1b, 0xe7, 0xe9, 0xe0, 0xdc, 0x4b, 0xd7, 0x84, 0x3b, 0xfb, 0x0c,
+  0x0b, 0xcd, 0x27, 0xd8, 0xdd, 0xc8, 0xc7, 0xc1, 0x6d, 0x31, 0xba, 0xd7, 0xa3, 0x69, 0x86, 0xd1,
+  0x1f, 0x6b, 0x9f, 0x40, 0x93, 0xd5, 0xe6, 0x72, 0x42, 0xb7, 0x8c, 0x9c, 0x39, 0xf0, 0x38, 0xc3,
+  0xba, 0xd5, 0x28, 0x28, 0xe9, 0x4a, 0xfe, 0x41, 0x11, 0x7a, 0x43, 0xf8, 0xdd, 0xd7, 0xd4, 0xe0,
+  0x16, 0xd0, 0x40, 0x67, 0x6a, 0x0e, 0xf0, 0x43, 0xf7, 0xfb, 0x1b, 0xc0, 0x4c, 0x1d, 0x24, 0x7e,
+  0x6b, 0xeb, 0x77, 0x6c, 0xe5, 0x50, 0xde, 0x6f, 0xec, 0x0f, 0xf5, 0x08, 0x41, 0x5c, 0xf6, 0x3b,
+  0x3e, 0xf3, 0x41, 0x15, 0x51, 0xa0, 0x3e, 0xde, 0xb4, 0x83, 0xb9, 0xa6, 0x89, 0xb9, 0x23, 0x7b,
+  0xc9, 0x4d, 0x4b, 0x82, 0x2c, 0x5d, 0x16, 0x51, 0x11, 0x6a, 0xac, 0x16, 0xcd, 0xce, 0x08, 0x10,
+  0x2b, 0x33, 0xa5, 0xe9, 0xec, 0xfd, 0xba, 0x69, 0x04, 0x63, 0xdd, 0x95, 0x51, 0x49, 0xd6, 0x3d,
+  0x3e, 0x4a, 0x79, 0x13, 0x44, 0xc4, 0xb6, 0xc5, 0x6c, 0xa4, 0x41, 0x1a, 0xef, 0x2b, 0xec, 0x6c,
+  0xab, 0x24, 0x12, 0x13, 0xb6, 0x17, 0x9c, 0x70, 0x3a, 0x89, 0x66, 0x2a, 0x95, 0x0f, 0xb8, 0x01,
+  0x4c, 0x3b, 0xaa, 0xa8, 0x71, 0x8f, 0x82, 0x1b, 0x5c, 0x40, 0xe5, 0xf0, 0xd4, 0x47, 0xcb, 0xfe,
+  0x51, 0x77, 0x25, 0xd9, 0x72, 0xc4, 0x20, 0xec, 0xfe, 0xb7, 0xce, 0x3e, 0xaf, 0x4b, 0x68, 0x02,
+  0x27, 0xfb, 0x3f, 0x74, 0x7b, 0x00, 0x2c, 0x84, 0x64, 0xb9, 0x1f, 0xf8, 0xa4, 0xc1, 0x9c, 0xe3,
+  0x6e, 0x4c, 0xc9, 0xf3, 0xd9, 0x6e, 0x8b, 0xf3, 0x83, 0x00, 0xc6, 0x00, 0x14, 0xef, 0xf3, 0xe3,
+  0xde, 0xb8, 0x66, 0xa6, 0xa7, 0x02, 0x8b, 0x74, 0xf3, 0x6a, 0x44, 0xe6, 0xa3, 0xc8, 0xa8, 0xf9,
+  0x64, 0x27, 0xee, 0x23, 0xde, 0xdf, 0x33, 0x2a, 0x49, 0x06, 0x01, 0x09, 0x37, 0x7c, 0x0d, 0x6a,
+  0x92, 0x8a, 0xea, 0x08, 0x08, 0x58, 0x3f, 0xd0, 0x10, 0xe5, 0xcb, 0xba, 0x78, 0x96, 0x2c, 0x7a,
+  0x30, 0xc9, 0xac, 0x9d, 0x7e, 0xbb, 0x98, 0xcc, 0x35, 0x69, 0x79, 0xe9, 0x32, 0x93, 0xe9, 0x1f,
+  0x8a, 0x7d, 0x44, 0x17, 0x27, 0xb3, 0x8d, 0x8d, 0xed, 0x82, 0x06, 0x89, 0x2a, 0x57, 0xae, 0xec,
+  0x37, 0xb9, 0xb0, 0xdd, 0x61, 0xdf, 0x65, 0xfb, 0x3b, 0xb9, 0xab, 0xd8, 0x2f, 0xdc, 0xc1, 0x08,
+  0x8f, 0x74, 0x60, 0xdd, 0xa4, 0x7c, 0xc4, 0x83, 0x78, 0xe6, 0xab, 0x11, 0x15, 0x91, 0xa0, 0x54,
+  0xb6, 0xf3, 0x80, 0x8e, 0x7f, 0x0e, 0xe6, 0x90, 0x65, 0xbb, 0x75, 0x1e, 0x8b, 0x80, 0xc2, 0xa0,
+  0xdc, 0xe5, 0x78, 0xe9, 0x2b, 0x5b, 0xd6, 0x1a, 0xdd, 0x6c, 0x1a, 0x48, 0xfb, 0xc7, 0x7e, 0x8e,
+  0xa3, 0xeb, 0x6b, 0x24, 0x34, 0xd8, 0xd7, 0xf5, 0xe4, 0xd2, 0x0c, 0xcf, 0x31, 0x27, 0x0c, 0x2f,
+  0x1a, 0x0c, 0xd5, 0xe7, 0x30, 0xd3, 0xe7, 0x95, 0x9c, 0x31, 0xcd, 0x07, 0x00, 0x2a, 0x04, 0xe7,
+  0xf5, 0x66, 0xb9, 0x21, 0x9a, 0x4a, 0x71, 0xa5, 0x01, 0x0d, 0x83, 0x09, 0x62, 0x93, 0x75, 0xad,
+  0xec, 0x68, 0x2d, 0xbf, 0xe5, 0x59, 0xcc, 0x40, 0x19, 0x2e, 0x79, 0x0e, 0x44, 0x05, 0x82, 0x7c,
+  0x07, 0xe6, 0x27, 0xc0, 0xee, 0x18, 0x2b, 0xbb, 0xd9, 0x8b, 0x42, 0x83, 0xd9, 0x1b, 0xa1, 0xeb,
+  0xfc, 0x8c, 0x23, 0x64, 0x30, 0x8f, 0x3e, 0xef, 0x73, 0x46, 0xd9, 0xdc, 0xe8, 0xe6, 0x1c, 0x39,
+  0x2b, 0x6e, 0x1b, 0xfd, 0xcc, 0x4b, 0x4f, 0x1a, 0xae, 0x7e, 0xbf, 0x73, 0x2d, 0x3b, 0xe8, 0x76,
+  0x21, 0x94, 0x2c, 0x92, 0x5e, 0x45, 0xd3, 0x72, 0xcb, 0xf3, 0xf2, 0x1b, 0x25, 0xfc, 0xed, 0x77,
+  0xd5, 0x44, 0xb9, 0xcf, 0xbc, 0xb7, 0x27, 0xf0, 0xc5, 0xac, 0xaf, 0xf4, 0xf5, 0x79, 0xd7, 0x72,
+  0x03, 0x25, 0xd3, 0x88, 0x5d, 0xa9, 0xbd, 0xce, 0x6b, 0x3b, 0x1e, 0xeb, 0x61, 0x43, 0x5f, 0x4b,
+  0x57, 0xd6, 0x3a, 0x75, 0x01, 0x55, 0x6a, 0x55, 0x25, 0xb7, 0xe7, 0xd3, 0x58, 0x99, 0x80, 0xc1,
+  0x07, 0xa4, 0xd0, 0x52, 0x73, 0x93, 0xaa, 0x4a, 0x4f, 0x62, 0x34, 0x2c, 0xe3, 0xbe, 0xc4, 0x37,
+  0x92, 0x75, 0x55, 0x7b, 0x24, 0x69, 0xed, 0xbe, 0xe4, 0x80, 0xb1, 0x24, 0x5b, 0x0f, 0x2c, 0x82,
+  0xef, 0xc0, 0xc8, 0x69, 0xd5, 0xbe, 0xc1, 0x36, 0x75, 0x67, 0xd3, 0xe3, 0x69, 0x44, 0xd3, 0xcc,
+  0xe1, 0x63, 0x3b, 0xb9, 0xc8, 0x7c, 0xbe, 0xba, 0xac, 0x41, 0x70, 0x27, 0xfc, 0xa5, 0x35, 0x2a,
+  0xa5, 0x1e, 0xe5, 0x29, 0x24, 0x3b, 0x3a, 0x50, 0xe5, 0x79, 0x0f, 0x0d, 0x32, 0x09, 0x0c, 0x4f,
+  0xba, 0x80, 0xa6, 0xae, 0xc2, 0xb4, 0x69, 0x98, 0xb0, 0x22, 0x75, 0x50, 0xe3, 0x29, 0xce, 0x12,
+  0x3c, 0x38, 0x9f, 0xa4, 0x5c, 0x87, 0x23, 0x2e, 0x0b, 0x71, 0x90, 0x74, 0xaf, 0xd6, 0x58, 0xcf,
+  0xef, 0xc2, 0x44, 0xff, 0xd4, 0x88, 0x78, 0xb2, 0x45, 0x9c, 0xec, 0xe9, 0x15, 0x88, 0xf3, 0xa7,
+  0xb4, 0xd4, 0xb1, 0x15, 0xd5, 0x8a, 0xac, 0x92, 0xa1, 0x02, 0x99, 0xe4, 0x74, 0x3f, 0x64, 0xc0,
+  0x68, 0x6d, 0xa4, 0xca, 0x21, 0x9d, 0x88, 0xfb, 0x6f, 0x1c, 0xc7, 0x8d, 0x81, 0x01, 0xe3, 0x28,
+  0xd8, 0xd3, 0x9e, 0x5f, 0x95, 0x65, 0xa6, 0xa2, 0x10, 0xb4, 0xf9, 0x58, 0x4e, 0xc7, 0xe0, 0xf7,
+  0xe3, 0x76, 0x04, 0x9d, 0x11, 0x05, 0xe1, 0x9e, 0x63, 0x15, 0x45, 0x7d, 0x98, 0x69, 0xc3, 0x58,
+  0xe0, 0xc0, 0x81, 0x44, 0x65, 0xc7, 0xa2, 0x90, 0xac, 0x00, 0x1c, 0x52, 0xa3, 0xa3, 0xc5, 0x82,
+  0x12, 0x8e, 0x47, 0x28, 0x0f, 0x05, 0x06, 0x12, 0xe9, 0x3c, 0x31, 0x65, 0x82, 0xb9, 0xd1, 0x90,
+  0x7d, 0x89, 0x2e, 0xe4, 0x38, 0x8e, 0xf0, 0x7f, 0xdf, 0x47, 0xac, 0xf4, 0xed, 0x25, 0xec, 0x43,
+  0xe1, 0x07, 0xc2, 0x2f, 0xb1, 0x4b, 0x8b, 0x84, 0x9a, 0xcb, 0xfe, 0x17, 0x8f, 0x52, 0x51, 0xf8,
+  0xcb, 0x62, 0xe6, 0xde, 0x5a, 0x00, 0x7d, 0x9f, 0xb8, 0x26, 0xed, 0xa7, 0x4f, 0xa5, 0x6c, 0xcb,
+  0x5c, 0x15, 0x6c, 0x84, 0x90, 0x9c, 0x2b, 0x70, 0x96, 0x3d, 0x69, 0x9f, 0x4a, 0x01, 0x05, 0x6f,
+  0x63, 0x94, 0xc3, 0x4e, 0xbb, 0x10, 0xe9, 0x3f, 0xdb, 0x70, 0x80, 0xc8, 0xf2, 0xd4, 0x7f, 0xc4,
+  0xc6, 0xd1, 0x68, 0x58, 0xd9, 0x4d, 0x11, 0x1c, 0x84, 0x7d, 0x23, 0x10, 0x9a, 0xf7, 0x1d, 0x21,
+  0x8d, 0x91, 0xd3, 0x24, 0xb6, 0x31, 0x03, 0xe5, 0xac, 0x41, 0x65, 0xae, 0xdb, 0x6c, 0x64, 0x78,
+  0x63, 0x58, 0xc4, 0x3e, 0xfd, 0xf5, 0x6d, 0x1e, 0x71, 0x88, 0xf5, 0x83, 0x41, 0xeb, 0x0b, 0xb7,
+  0xd8, 0x42, 0x03, 0x69, 0x8d, 0xce, 0x5d, 0x90, 0xad, 0x27, 0x92, 0x8c, 0xaf, 0xaa, 0xe3, 0x76,
+  0xce, 0xc6, 0xc9, 0x21, 0x8f, 0x4b, 0xa7, 0xc3, 0x58, 0x15, 0xf8, 0x6c, 0xd9, 0xdc, 0x36, 0x69,
+  0x23, 0xd8, 0xa6, 0x1e, 0x92, 0x47, 0x36, 0xa0, 0x1a, 0x41, 0x6c, 0x28, 0x1e, 0xd8, 0x89, 0x7e,
+  0x1f, 0x83, 0x6d, 0x2a, 0x72, 0x97, 0x4e, 0xfb, 0x01, 0x2f, 0x34, 0xb0, 0xbc, 0x6c, 0x7c, 0xf0,
+  0x2f, 0x95, 0x41, 0x8a, 0x53, 0x72, 0x47, 0x0c, 0x0e, 0x11, 0xfd, 0xa2, 0x59, 0x0e, 0x58, 0x42,
+  0xbe, 0x32, 0x3e, 0xd0, 0xce, 0x8c, 0x72, 0x29, 0x92, 0xa5, 0xa1, 0x6a, 0xb2, 0x56, 0xd8, 0x1c,
+  0x9a, 0x55, 0x8b, 0x85, 0xc1, 0x93, 0x97, 0x38, 0x57, 0x7b, 0x7e, 0xe8, 0x9a, 0x9d, 0x97, 0x31,
+  0xba, 0x6b, 0xfa, 0x1c, 0x62, 0xe5, 0x62, 0xab, 0x41, 0x82, 0x30, 0xfb, 0x2c, 0x38, 0x8c, 0x04,
+  0xa4, 0x0d, 0x51, 0xd0, 0x29, 0x60, 0xef, 0xab, 0x09, 0xb7, 0x79, 0x1d, 0x4d, 0x61, 0xf6, 0xdd,
+  0x87, 0x34, 0x57, 0x5a, 0x12, 0xce, 0x0d, 0xa8, 0x58, 0xde, 0x77, 0xfa, 0x8d, 0xc4, 0x10, 0x52,
+  0x1b, 0xbd, 0xd8, 0xfb, 0xd6, 0x74, 0x65, 0x3c, 0x60, 0xca, 0x4c, 0xfe, 0x89, 0xbf, 0xd7, 0x5c,
+  0xb1, 0xb3, 0x49, 0x15, 0x11, 0x63, 0x03, 0x05, 0xb6, 0xec, 0x1a, 0x42, 0xe3, 0x20, 0xd6, 0x71,
+  0xd8, 0xf0, 0x79, 0xc8, 0xee, 0xfc, 0x0e, 0xe2, 0xa8, 0x9d, 0xae, 0xc0, 0x92, 0xca, 0x8e, 0x3d,
+  0x98, 0x3a, 0xbd, 0xd2, 0xf8, 0x12, 0x0a, 0xb7, 0x5e, 0x83, 0x67, 0xd7, 0xd9, 0xaa, 0xb4, 0x03,
+  0xde, 0x28, 0x98, 0xe9, 0x12, 0xb7, 0x67, 0x96, 0xa3, 0xe9, 0x07, 0xb4, 0x5b, 0xc2, 0x76, 0x7f,
+  0x2d, 0x68, 0xb3, 0x5f, 0x0b, 0x8f, 0xbf, 0xd0, 0xe2, 0xf7, 0x75, 0xf3, 0x25, 0x8d, 0x91, 0xdd,
+  0xf1, 0x58, 0xe2, 0xef, 0x43, 0x01, 0xcf, 0xce, 0x4a, 0x06, 0x76, 0xaf, 0x12, 0x72, 0xe1, 0xee,
+  0xd8, 0x9e, 0x55, 0x5a, 0x47, 0x66, 0x97, 0xba, 0xa9, 0xf8, 0x10, 0xd9, 0x54, 0xc3, 0x7e, 0x79,
+  0x61, 0x6f, 0x93, 0xd3, 0xbd, 0xdd, 0xf3, 0xfb, 0x46, 0xc4, 0xad, 0xef, 0xe2, 0x12, 0xbe, 0x36,
+  0xe3, 0x86, 0xfb, 0xc0, 0xf8, 0xfd, 0xfe, 0x58, 0xc3, 0xe9, 0x93, 0x06, 0x1f, 0x82, 0x86, 0x39,
+  0x5a, 0x9c, 0xf7, 0xc1, 0x88, 0x7b, 0x00, 0x39, 0x1e, 0x63, 0x6a, 0x71, 0x92, 0xcd, 0xe2, 0x70,
+  0x39, 0x97, 0xc5, 0x32, 0xac, 0x5b, 0xe9, 0x93, 0x8c, 0x68, 0xd8, 0x70, 0xaf, 0x70, 0x9a, 0xe1,
+  0xd5, 0xe4, 0x9d, 0x2b, 0x3c, 0xc8, 0x95, 0x51, 0x05, 0x46, 0x1c, 0x4d, 0x9a, 0xf6, 0x77, 0x05,
+  0xde, 0x1d, 0x90, 0x62, 0x49, 0x2c, 0xba, 0xce, 0x82, 0x13, 0x3c, 0xd1, 0x9a, 0xa3, 0x66, 0xa4,
+  0x8d, 0x7c, 0x81, 0xe3, 0x6b, 0xe2, 0xea, 0xcc, 0xc7, 0x6b, 0xc8, 0x4d, 0x1f, 0x8d, 0x33, 0x56,
+  0x84, 0x01, 0x41, 0x69, 0xa1, 0xee, 0xbf, 0x01, 0x89, 0xb7, 0x51, 0xf4, 0x57, 0x22, 0xbd, 0x7a,
+  0xb6, 0x75, 0xc5, 0xc6, 0xf8, 0xbb, 0xed, 0x64, 0x44, 0x42, 0xdb, 0x8d, 0x6d, 0x42, 0x5c, 0xab,
+  0x8b, 0x0b, 0xb2, 0x69, 0x4b, 0x4a, 0x82, 0x21, 0xac, 0x6c, 0x1a, 0xd4, 0xeb, 0x45, 0x31, 0x6e,
+  0x88, 0xfe, 0x0e, 0x14, 0xce, 0x61, 0x52, 0x19, 0x97, 0x7c, 0x76, 0x35, 0xc2, 0x86, 0xa7, 0xc9,
+  0x71, 0x38, 0x56, 0xe5, 0xcf, 0x63, 0x69, 0xcb, 0x2c, 0x60, 0x01, 0x82, 0x36, 0xdd, 0x86, 0x68,
+  0xdb, 0xc8, 0xb6, 0x63, 0xbf, 0xb2, 0xb3, 0xf7, 0x9a, 0x5d, 0x3c, 0xce, 0xa2, 0x08, 0x35, 0x39,
+  0xb5, 0x78, 0x84, 0x1f, 0x74, 0x88, 0x0d, 0x20, 0x61, 0xad, 0x99, 0x6a, 0xdf, 0xf0, 0x54, 0x44,
+  0x6f, 0x9b, 0xef, 0x25, 0xf2, 0x8f, 0x3a, 0x7b, 0xd5, 0x0e, 0xcc, 0xfa, 0x34, 0xb2, 0x1b, 0xe6,
+  0x7b, 0x9d, 0x54, 0xb7, 0x5f, 0x08, 0x58, 0xa8, 0x42, 0x5a, 0x6a, 0x2d, 0xfd, 0x4b, 0x7f, 0x66,
+  0x09, 0x12, 0x6b, 0x39, 0x9f, 0x3c, 0x68, 0xbe, 0xee, 0xb0, 0x93, 0x12, 0x70, 0xef, 0xca, 0xcc,
+  0x87, 0x7c, 0xac, 0xd3, 0xb7, 0xd0, 0x30, 0x9d, 0x0f, 0x08, 0x0e, 0x9e, 0xd0, 0x41, 0x14, 0x8f,
+  0xb2, 0x07, 0x22, 0x9c, 0xa6, 0x73, 0xfb, 0x3e, 0x6f, 0x3c, 0xb5, 0x75, 0x05, 0xa2, 0x5b, 0x5c,
+  0x99, 0x01, 0x79, 0x7c, 0x27, 0x2a, 0xa1, 0x11, 0x38, 0x54, 0x0b, 0x4a, 0xb8, 0x43, 0x68, 0xc1,
+  0x2b, 0x27, 0x0f, 0x3f, 0x9b, 0xcc, 0x6f, 0xe9, 0x75, 0xe0, 0xd3, 0x54, 0xef, 0xef, 0xc1, 0xfe,
+  0x0a, 0x40, 0xec, 0xa3, 0x5a, 0x9e, 0xe2, 0x59, 0x43, 0xb1, 0xd9, 0x25, 0xc8, 0xbc, 0x25, 0x4d,
+  0x44, 0xaf, 0x15, 0x01, 0x76, 0xd7, 0x88, 0x24, 0x5a, 0xfc, 0xdc, 0x23, 0x0b, 0xff, 0x2c, 0xb3,
+  0x87, 0xf7, 0x2d, 0x44, 0x14, 0x6b, 0x32, 0x29, 0xfe, 0x7e, 0xbf, 0xe6, 0xf0, 0x55, 0xa2, 0x30,
+  0x40, 0xf4, 0x32, 0x3b, 0xa9, 0xcf, 0xb2, 0xde, 0x1e, 0x61, 0xaf, 0xc9, 0xb3, 0x8c, 0xf3, 0x5c,
+  0x6e, 0x93, 0xe8, 0xe7, 0x29, 0x1f, 0x3f, 0x3b, 0xb6, 0xa6, 0x8a, 0x90, 0xbd, 0x41, 0x8a, 0x63,
+  0x5b, 0xe6, 0x34, 0x5a, 0x4c, 0x0e, 0x4a, 0x40, 0x7b, 0x29, 0x34, 0xa2, 0xcd, 0x31, 0xcc, 0x6a,
+  0xae, 0x16, 0xde, 0xbb, 0x6a, 0x21, 0x3d, 0x35, 0x6b, 0x43, 0x72, 0x96, 0xff, 0xdc, 0xc5, 0xaa,
+  0x87, 0x89, 0xa7, 0xaa, 0x92, 0x04, 0x54, 0x71, 0x27, 0xb5, 0xb7, 0xfd, 0x1d, 0x17, 0xac, 0xcb,
+  0x81, 0x4a, 0x7a, 0x77, 0x9e, 0x38, 0xd4, 0x50, 0x5f, 0x60, 0xc1, 0xc6, 0x53, 0xd9, 0x32, 0x7c,
+  0x19, 0xca, 0x24, 0xac, 0x01, 0x9a, 0xa0, 0x09, 0x7f, 0xc9, 0x44, 0xec, 0xf9, 0xf5, 0x5d, 0xa9,
+  0x66, 0x5b, 0x0f, 0x09, 0x93, 0x0e, 0xb6, 0xff, 0x24, 0x3b, 0xb2, 0xaa, 0x01, 0xd1, 0xc5, 0xdc,
+  0xb7, 0xf5, 0x27, 0x79, 0x2c, 0x2a, 0x25, 0x0c, 0xb8, 0x9c, 0xdb, 0x54, 0x63, 0x45, 0xc0, 0xaa,
+  0x14, 0xb2, 0x38, 0xa1, 0xa6, 0xa5, 0x41, 0xf5, 0x93, 0xae, 0x18, 0x63, 0x61, 0xd4, 0xde, 0xd4,
+  0x19, 0x3c, 0xd5, 0x34, 0x0b, 0xbe, 0x1d, 0x0b, 0xc8, 0x2b, 0x68, 0xc4, 0x16, 0x39, 0x7d, 0x10,
+  0xda, 0xc5, 0x76, 0x5a, 0x76, 0x1e, 0xb7, 0xa8, 0xcf, 0x0e, 0xd1, 0x23, 0x98, 0xd6, 0x70, 0x38,
+  0x38, 0x3e, 0x6a, 0xbd, 0xca, 0xac, 0xd9, 0x1b, 0x5b, 0x81, 0x57, 0xd9, 0x2a, 0x0b, 0x0e, 0x73,
+  0xcc, 0xa1, 0xc0, 0x92, 0x45, 0xce, 0x02, 0xd8, 0x5b, 0x6f, 0xae, 0x52, 0x1d, 0x16, 0x95, 0x7e,
+  0x1e, 0xd3, 0x4e, 0x3a, 0x40, 0x32, 0x6f, 0x10, 0x51, 0xd4, 0x45, 0x91, 0xb8, 0x47, 0xcc, 0xe8,
+  0x9e, 0xe2, 0x4f, 0x0b, 0xce, 0xc5, 0xa4, 0xc0, 0x65, 0xf7, 0x31, 0x5f, 0xeb, 0x12, 0x64, 0xa2,
+  0x85, 0xae, 0xea, 0x3e, 0x64, 0x54, 0x38, 0x45, 0xa6, 0x72, 0x6e, 0x82, 0xf0, 0x64, 0xa2, 0x13,
+  0x03, 0x42, 0xa5, 0x4b, 0x26, 0x2b, 0xf4, 0x77, 0x64, 0xee, 0x20, 0xb6, 0xa7, 0x37, 0xbc, 0xdf,
+  0xc1, 0x73, 0xed, 0x61, 0x6f, 0x01, 0xcd, 0x0d, 0xd0, 0xc8, 0x2e, 0x2f, 0xe4, 0x22, 0x66, 0xbd,
+  0x03, 0x12, 0xe8, 0xf7, 0x02, 0xf4, 0x24, 0x35, 0xf1, 0xcb, 0x70, 0xc7, 0x9f, 0x3a, 0x8b, 0x77,
+  0xb6, 0xda, 0xe1, 0xf8, 0x5d, 0xc6, 0xcc, 0xa8, 0x97, 0xf6, 0x9d, 0xd1, 0xe7, 0x08, 0x59, 0x5d,
+  0x63, 0x8d, 0x42, 0x91, 0x1b, 0x1b, 0xcd, 0xb7, 0x05, 0x95, 0xde, 0x05, 0xaa, 0x43, 0x2d, 0x44,
+  0xa1, 0x1d, 0x15, 0x68, 0xaf, 0xcf, 0x04, 0x19, 0x3e, 0xc0, 0xcc, 0x7f, 0x0c, 0x64, 0x1f, 0xfe,
+  0xeb, 0x2a, 0x0a, 0x4e, 0x03, 0x64, 0xf0, 0x3b, 0xe4, 0x56, 0xcd, 0x3b, 0xd4, 0x64, 0xe3, 0xa9,
+  0x0a, 0x53, 0x2e, 0x6b, 0xb1, 0xf4, 0x12, 0xf1, 0x5f, 0x4c, 0xf2, 0xbe, 0x87, 0x06, 0x6c, 0x35,
+  0xbb, 0x59, 0xa6, 0xca, 0x43, 0x25, 0x60, 0xd4, 0xd4, 0xf3, 0xff, 0x6a, 0x94, 0xae, 0x89, 0x91,
+  0x3e, 0x4c, 0xc4, 0xa3, 0x23, 0x2b, 0x94, 0x70, 0xe9, 0x1a, 0xc6, 0xf4, 0x75, 0xeb, 0x37, 0xb5,
+  0x40, 0x1d, 0x40, 0xb2, 0x23, 0x34, 0x1b, 0x69, 0x0b, 0x80, 0xf2, 0x56, 0xe9, 0x94, 0xa5, 0xb7,
+  0x31, 0xd2, 0x0e, 0x2a, 0x72, 0x70, 0xef, 0x27, 0xfb, 0x9c, 0x5b, 0x03, 0x9f, 0x13, 0x28, 0x16,
+  0xdc, 0x34, 0x93, 0xc1, 0x56, 0x25, 0x42, 0xb2, 0x53, 0xa3, 0x81, 0x7c, 0xad, 0xaa, 0xd4, 0x49,
+  0xb0, 0x9c, 0xd9, 0xd5, 0xdb, 0x99, 0x97, 0x84, 0x74, 0xdd, 0x52, 0x47, 0x51, 0x34, 0x8c, 0x09,
+  0xf2, 0x1a, 0x3b, 0x9d, 0xea, 0x3f, 0x4b, 0xd8, 0x7f, 0x21, 0xe1, 0xb5, 0x09, 0x49, 0x0d, 0x4a,
+  0xd4, 0x33, 0x52, 0xda, 0xf8, 0x9a, 0xfc, 0x8d, 0xd5, 0xfc, 0x61, 0xee, 0x3a, 0x12, 0xe3, 0x88,
+  0x61, 0xd8, 0x87, 0xf3, 0xff, 0xb3, 0x3f, 0xb0, 0x02, 0x89, 0xc6, 0xc9, 0x39, 0xce, 0x7a, 0x3d,
+  0x23, 0xb1, 0xa2, 0x20, 0x37, 0x64, 0x0d, 0xfa, 0x11, 0xc9, 0x6a, 0x69, 0xad, 0xd8, 0x21, 0xf0,
+  0x30, 0x7a, 0x94, 0x82, 0xdd, 0x1a, 0xc2, 0x40, 0xef, 0x9b, 0xbc, 0xa7, 0x0c, 0x58, 0xc7, 0x30,
+  0x41, 0x9f, 0x2e, 0xd4, 0xb5, 0x95, 0x43, 0x87, 0xac, 0xd8, 0xf0, 0xf1, 0x87, 0x64, 0x1b, 0x88,
+  0xd8, 0xb2, 0x58, 0x6f, 0x49, 0x90, 0x44, 0x6c, 0x68, 0x79, 0xe8, 0xf5, 0xc5, 0x2c, 0xb2, 0x25,
+  0xc4, 0xc6, 0xd2, 0xb3, 0x77, 0x6b, 0xb9, 0x26, 0x8a, 0xff, 0x00, 0xba, 0x07, 0xf5, 0x5c, 0xe5,
+  0xef, 0x4d, 0xeb, 0xc7, 0x9c, 0xb3, 0x28, 0x8d, 0x7d, 0xa7, 0x31, 0x4d, 0x3e, 0x12, 0x73, 0x2a,
+  0x6d, 0x1e, 0x0c, 0x17, 0xac, 0x8d, 0x74, 0x1c, 0xb3, 0xe9, 0x56, 0xbe, 0x3e, 0xcf, 0x7d, 0x75,
+  0xa7, 0x7b, 0x43, 0x59, 0xfe, 0xb6, 0x8c, 0x00, 0x75, 0x45, 0x8c, 0x77, 0x85, 0x87, 0xb5, 0x11,
+  0xed, 0x16, 0xb9, 0x8f, 0xba, 0xd4, 0xcf, 0xdf, 0xe6, 0x67, 0xc7, 0xc4, 0xb3, 0xc8, 0x18, 0xec,
+  0x69, 0x84, 0xdc, 0x48, 0xc2, 0x45, 0xf6, 0x17, 0xe4, 0xb9, 0x2c, 0xd0, 0x37, 0xd8, 0xd7, 0xb6,
+  0xd9, 0x2b, 0x42, 0x78, 0x9d, 0x0e, 0xe4, 0x20, 0x83, 0xe0, 0x71, 0xdb, 0x97, 0x5b, 0x25, 0x0c,
+  0x0d, 0x73, 0xb1, 0x0b, 0x52, 0xda, 0x84, 0xc6, 0xe8, 0xc8, 0xe8, 0x11, 0xfa, 0x51, 0xf1, 0x6c,
+  0x97, 0xcb, 0x19, 0x31, 0xf4, 0x5c, 0x1b, 0x64, 0x86, 0xde, 0xa6, 0x7a, 0x22, 0xa8, 0x1a, 0x97,
+  0xa2, 0x65, 0x74, 0xe5, 0x2a, 0x86, 0x35, 0x55, 0x9c, 0x1e, 0x8d, 0x49, 0x6a, 0x26, 0x86, 0xf8,
+  0x1f, 0xc5, 0x27, 0xa0, 0x6f, 0x38, 0xdc, 0x1d, 0x8f, 0xca, 0xba, 0x86, 0x60, 0xf9, 0xd6, 0x1e,
+  0x1a, 0x23, 0xb6, 0xee, 0x6d, 0x64, 0xed, 0x26, 0xc3, 0x8b, 0xa2, 0x49, 0xd1, 0x7e, 0xdf, 0xac,
+  0x96, 0x26, 0x17, 0x86, 0x69, 0xbd, 0x94, 0xf6, 0xf6, 0x87, 0x43, 0xf4, 0xd0, 0xc7, 0x30, 0x63,
+  0xb3, 0x24, 0x80, 0x07, 0xd3, 0x17, 0xf8, 0xd2, 0x49, 0xa2, 0x65, 0x9a, 0xd7, 0x4e, 0xaf, 0x1e,
+  0x33, 0xc8, 0x67, 0x0d, 0xb8, 0x9e, 0x2b, 0xae, 0x21, 0x7c, 0x51, 0x9d, 0x13, 0xc9, 0x0f, 0xb5,
+  0x3a, 0x98, 0xfa, 0x02, 0x54, 0xa9, 0x02, 0x9e, 0x49, 0x05, 0x16, 0xd8, 0xc5, 0xc8, 0x59, 0x98,
+  0x47, 0x16, 0xc0, 0xa1, 0x16, 0x51, 0x64, 0xa3, 0xcf, 0xb9, 0x4e, 0x67, 0xbc, 0xdc, 0x9c, 0x28,
+  0x51, 0x13, 0x77, 0xe6, 0x70, 0xca, 0x20, 0xaf, 0x1c, 0x69, 0x19, 0xd1, 0x31, 0x67, 0xc8, 0xc3,
+  0xd7, 0x13, 0x94, 0xa6, 0xed, 0x4f, 0x0a, 0xe9, 0x4d, 0x12, 0x8a, 0x60, 0xe4, 0x7e, 0x46, 0x38,
+  0xde, 0xef, 0xc2, 0x7e, 0xad, 0x57, 0x76, 0x22, 0x86, 0xc2, 0x46, 0x04, 0x25, 0x28, 0x7f, 0x65,
+  0x6a, 0x91, 0x40, 0xe5, 0xab, 0x7a, 0x45, 0x31, 0xfe, 0xe6, 0xbb, 0x39, 0xdf, 0x1f, 0xa4, 0x7b,
+  0x35, 0x5f, 0x86, 0x65, 0xe0, 0x32, 0x53, 0x6a, 0x16, 0x52, 0x34, 0x9f, 0x77, 0xf9, 0x42, 0x38,
+  0x7b, 0x23, 0x42, 0xd1, 0xe5, 0xa3, 0x6d, 0x2e, 0xb4, 0xe9, 0x93, 0x46, 0x52, 0x37, 0xc6, 0x5f,
+  0x9a, 0x03, 0xc1, 0xef, 0x86, 0xdb, 0x31, 0xe7, 0x44, 0x61, 0xe6, 0x9d, 0x47, 0x04, 0xf5, 0xb5,
+  0x3b, 0xef, 0xca, 0x7d, 0x2a, 0x6d, 0xad, 0x2a, 0xf9, 0x1d, 0xe2, 0x75, 0xe3, 0xe5, 0x25, 0xb7,
+  0xd7, 0x41, 0x94, 0x98, 0x05, 0x0f, 0x45, 0x19, 0x39, 0x6f, 0x37, 0x70, 0x59, 0xfa, 0xf9, 0xfd,
+  0x7d, 0x61, 0xbd, 0xc7, 0x6f, 0x9a, 0x33, 0x98, 0x85, 0x09, 0xa5, 0xd1, 0x38, 0x90, 0xd6, 0xa3,
+  0xd2, 0x5c, 0x96, 0x12, 0x8f, 0x59, 0xf0, 0x26, 0xae, 0x43, 0xd4, 0x4f, 0x70, 0xa3, 0xcb, 0x29,
+  0x1d, 0x69, 0x36, 0x66, 0xba, 0xe7, 0xcd, 0x6e, 0xbc, 0x07, 0x21, 0x9c, 0x15, 0x32, 0xca, 0x94,
+  0x2e, 0x04, 0x63, 0x44, 0x2f, 0x12, 0x50, 0x13, 0x64, 0x03, 0xd3, 0xe3, 0x7d, 0x4b, 0x51, 0x2f,
+  0x1e, 0x0e, 0x5f, 0xd3, 0x85, 0x10, 0x47, 0xbd, 0x10, 0x08, 0x79, 0x79, 0x8c, 0x39, 0x83, 0xc3,
+  0x78, 0xc1, 0x8d, 0x05, 0xd0, 0x8c, 0xa8, 0x66, 0x1c, 0xd1, 0x65, 0x6b, 0x3b, 0x0f, 0x88, 0x6f,
+  0x56, 0x12, 0xeb, 0x3f, 0xb4, 0xc7, 0x5b, 0x57, 0xc4, 0x37, 0x3c, 0xb6, 0xc5, 0xb0, 0xf0, 0x0d,
+  0xcd, 0x9c, 0xd9, 0x58, 0x6a, 0x31, 0xed, 0xdf, 0xa7, 0x31, 0xe9, 0x86, 0x51, 0x6a, 0x21, 0xd9,
+  0x80, 0x53, 0x93, 0x19, 0xa8, 0x14, 0x72, 0x97, 0x0d, 0x49, 0xa1, 0xcf, 0x8a, 0x0b, 0xa1, 0xa3,
+  0xa4, 0xea, 0xbc, 0x02, 0x50, 0x52, 0x09, 0x01, 0x16, 0xed, 0x7c, 0xd6, 0xaa, 0x03, 0xb2, 0x3a,
+  0x63, 0xb6, 0x31, 0xc3, 0xc2, 0x62, 0x5f, 0xb6, 0x5d, 0x37, 0x91, 0x99, 0x75, 0x5e, 0x5f, 0x27,
+  0xd6, 0x2c, 0x30, 0x39, 0xa1, 0xcd, 0x05, 0xab, 0xcb, 0x45, 0x53, 0x70, 0x49, 0xe0, 0xc8, 0x3a,
+  0xcd, 0x37, 0x64, 0x19, 0xd9, 0x14, 0x62, 0x84, 0xbe, 0x49, 0x5e, 0xc1, 0xf2, 0x4c, 0x80, 0xe3,
+  0xd0, 0x43, 0x52, 0xc4, 0x65, 0x5f, 0x08, 0x2f, 0x03, 0x45, 0xcf, 0xee, 0x98, 0x60, 0x18, 0xce,
+  0x2b, 0xef, 0x63, 0x62, 0x6d, 0x99, 0x03, 0xcb, 0xbd, 0xff, 0xed, 0x4f, 0xa2, 0xde, 0xb3, 0x69,
+  0xd6, 0x9e, 0x75, 0x46, 0xb2, 0xbe, 0xcd, 0x17, 0x63, 0x66, 0x8d, 0x1d, 0xfd, 0x7b, 0xc2, 0x08,
+  0x45, 0xec, 0x58, 0x4d, 0x48, 0xf0, 0x61, 0xad, 0xd2, 0xda, 0x8a, 0xd6, 0xb6, 0x20, 0xb5, 0x76,
+  0x0d, 0xb1, 0x0c, 0x4b, 0x29, 0x17, 0x9f, 0xcf, 0x5d, 0x39, 0x15, 0x4e, 0xc9, 0xd6, 0x81, 0xa3,
+  0xe5, 0x19, 0xc1, 0x8d, 0xe2, 0x89, 0x8c, 0x16, 0x08, 0x83, 0x11, 0x54, 0xd2, 0x8e, 0x22, 0x89,
+  0x0a, 0x22, 0xb7, 0x11, 0xe4, 0x8f, 0x7b, 0x56, 0xf5, 0xef, 0xc5, 0x1b, 0x73, 0x46, 0x04, 0xd4,
+  0x95, 0x57, 0x66, 0x89, 0x80, 0xa4, 0xd3, 0x56, 0xb7, 0x18, 0x92, 0x34, 0x17, 0x01, 0x19, 0x2a,
+  0xb2, 0x10, 0x6b, 0xdf, 0xc7, 0xac, 0x03, 0xfd, 0x7b, 0xc0, 0x0b, 0x64, 0x9e, 0xf1, 0xef, 0x4d,
+  0xc7, 0x86, 0x04, 0x69, 0xdc, 0x48, 0xb9, 0x2e, 0xd2, 0x35, 0xca, 0xce, 0x30, 0xa2, 0x29, 0x78,
+  0x5c, 0x67, 0xb9, 0xaf, 0x85, 0x69, 0x30, 0x0f, 0x1f, 0x87, 0xd2, 0x6c, 0x84, 0x90, 0xea, 0xd7,
+  0x96, 0xcb, 0xe1, 0x15, 0x5f, 0x7c, 0x12, 0xd8, 0x73, 0x04, 0x4a, 0xf9, 0x4d, 0x50, 0x7b, 0x5b,
+  0xb9, 0x5f, 0x2c, 0x0c, 0x3d, 0x69, 0xd4, 0xa6, 0x53, 0x84, 0x83, 0x89, 0x27, 0x24, 0x89, 0xde,
+  0x78, 0xc5, 0x0a, 0xb8, 0x0c, 0xe9, 0xcc, 0xe9, 0x6c, 0xc5, 0xe4, 0x65, 0x41, 0xda, 0xa7, 0xbe,
+  0xef, 0x1f, 0x10, 0x48, 0x4a, 0xc1, 0x66, 0x4e, 0x5a, 0x84, 0xb6, 0x46, 0xb7, 0x72, 0xb1, 0x88,
+  0xa2, 0x9c, 0x10, 0xf9, 0x75, 0xc8, 0x80, 0x7b, 0x54, 0xe1, 0xdd, 0xa2, 0xbb, 0xb4, 0xfd, 0x93,
+  0x67, 0x3a, 0x16, 0x25, 0x95, 0x9a, 0xd0, 0x4d, 0x75, 0x46, 0x6b, 0x1a, 0xdd, 0x2d, 0xc3, 0x86,
+  0xfb, 0xd2, 0x79, 0xf7, 0x27, 0x60, 0x82, 0x3e, 0x6c, 0xf2, 0xe9, 0xac, 0x3a, 0xdc, 0x2e, 0x8e,
+  0x3f, 0xe8, 0x4c, 0x3d, 0xef, 0xa4, 0x0e, 0xd1, 0x25, 0xcc, 0xda, 0x7a, 0xe2, 0x35, 0x86, 0x3e,
+  0xe7, 0x0d, 0x18, 0xaf, 0x58, 0xef, 0x4a, 0xb3, 0xa8, 0xe1, 0x8a, 0xdb, 0x3b, 0x9f, 0x59, 0x07,
+  0x41, 0xb6, 0x0c, 0x21, 0xb4, 0x91, 0x57, 0x69, 0xa3, 0x62, 0x1e, 0xb9, 0x97, 0xd9, 0x9a, 0xa0,
+  0x92, 0xcb, 0xdd, 0x76, 0x46, 0xb2, 0x37, 0xd3, 0x48, 0x1b, 0xca, 0x3c, 0xbb, 0x23, 0xe1, 0x14,
+  0x21, 0x1f, 0x0a, 0xe2, 0x2a, 0xcd, 0xce, 0xba, 0x4e, 0xd1, 0x56, 0x6d, 0x72, 0x22, 0xa0, 0x4b,
+  0xdd, 0xbb, 0x5f, 0xf5, 0xc5, 0x0e, 0x50, 0x79, 0xfa, 0x1f, 0xc8, 0x6c, 0xb8, 0xe1, 0x3e, 0x01,
+  0xb4, 0x31, 0xc4, 0x25, 0x76, 0xd1, 0xe1, 0x6c, 0x5f, 0xd9, 0x20, 0xa7, 0x13, 0x10, 0x50, 0x41,
+  0xa8, 0x52, 0x88, 0x40, 0xb3, 0xec, 0x94, 0x0e, 0xa3, 0x91, 0x68, 0xf5, 0x25, 0x2c, 0x17, 0xe2,
+  0xa5, 0x08, 0xbb, 0x5a, 0xbd, 0xce, 0xa8, 0xfb, 0xe9, 0x18, 0x35, 0xdb, 0x5c, 0x3c, 0x53, 0x0d,
+  0x9b, 0x2d, 0x6e, 0xa1, 0x8a, 0x5c, 0x93, 0xef, 0x53, 0xfe, 0x4d, 0x14, 0xcc, 0xc2, 0x02, 0xba,
+  0x39, 0xff, 0xb9, 0x26, 0xef, 0x2f, 0x7c, 0x70, 0x4d, 0xa3, 0xb6, 0x42, 0x4e, 0x5d, 0xd8, 0xd7,
+  0x37, 0x21, 0xb5, 0x03, 0x51, 0x11, 0x2c, 0x91, 0x7c, 0x91, 0xc2, 0x90, 0x45, 0x8e, 0x3b, 0x86,
+  0xfa, 0xf9, 0xf7, 0x33, 0xd7, 0x2e, 0xb6, 0x1a, 0xc1, 0xb5, 0x11, 0x02, 0x63, 0x7d, 0xe1, 0x15,
+  0x1e, 0x45, 0x9a, 0x31, 0xcf, 0x1b, 0xfd, 0x62, 0xa9, 0x87, 0xf1, 0x92, 0x88, 0x03, 0x02, 0x76,
+  0xdd, 0x26, 0x2b, 0x13, 0x05, 0xdd, 0xff, 0xad, 0xaa, 0xcf, 0xbf, 0xaf, 0x80, 0x5b, 0x45, 0xa1,
+  0x7c, 0xcb, 0x26, 0xba, 0x90, 0x8f, 0x5a, 0x7c, 0x8f, 0x4d, 0xe7, 0x59, 0xa4, 0x54, 0xd4, 0xc3,
+  0x5d, 0x8a, 0xda, 0x9f, 0x59, 0xaa, 0x25, 0x75, 0xc0, 0xe1, 0xda, 0x90, 0x88, 0x9a, 0xb4, 0x7a,
+  0xe2, 0x66, 0x74, 0x07, 0xa7, 0x83, 0x23, 0x8e, 0x68, 0xb0, 0x9e, 0x1f, 0xfa, 0xef, 0x88, 0x66,
+  0xf1, 0x34, 0xca, 0xdc, 0x51, 0x0a, 0x89, 0x2a, 0x5f, 0x2c, 0x13, 0x9e, 0xbf, 0xae, 0xc5, 0x92,
+  0xb4, 0x24, 0x29, 0x97, 0xaf, 0x93, 0x04, 0x2c, 0x5f, 0x1a, 0x9b, 0x05, 0xdf, 0x47, 0xd9, 0x95,
+  0x26, 0xd3, 0x8d, 0xb4, 0xa4, 0xff, 0x09, 0x9f, 0x70, 0x60, 0x89, 0xc6, 0x6d, 0x47, 0xcf, 0x05,
+  0x2b, 0xf8, 0x2a, 0x44, 0xa8, 0x5b, 0xc4, 0x80, 0xd0, 0xf7, 0x92, 0x70, 0x4f, 0xbb, 0x72, 0xf9,
+  0x9d, 0xa5, 0x0e, 0x9f, 0xde, 0x44, 0xbd, 0xb6, 0xb4, 0xef, 0x56, 0xde, 0xbb, 0x7b, 0x8d, 0xb6,
+  0x5a, 0x23, 0xbf, 0xd6, 0x73, 0x77, 0xc6, 0xa1, 0x13, 0xb4, 0x0a, 0x8a, 0x43, 0xf8, 0xa5, 0xf8,
+  0xc6, 0x42, 0xe9, 0xd9, 0xbc, 0x3e, 0x10, 0x65, 0xb1, 0x7f, 0xca, 0xc3, 0x44, 0x62, 0x1c, 0x12,
+  0xd1, 0x3a, 0x12, 0x44, 0xad, 0x71, 0xce, 0xed, 0x98, 0x2c, 0x25, 0xcd, 0x57, 0xc6, 0x3e, 0x2b,
+  0x15, 0x7a, 0x87, 0x52, 0x6a, 0x06, 0x7d, 0xea, 0x19, 0x27, 0xbd, 0xcf, 0xdb, 0x04, 0x1d, 0x5a,
+  0x97, 0xd1, 0x78, 0xcc, 0x00, 0xc5, 0xc1, 0x76, 0x81, 0x4c, 0xd0, 0x5b, 0x9f, 0x55, 0x6c, 0x3c,
+  0xf1, 0x58, 0x6f, 0x32, 0xa3, 0x8c, 0x96, 0x19, 0x68, 0xaa, 0x33, 0xbf, 0xd8, 0x10, 0x5f, 0x22,
+  0x98, 0x0d, 0xa8, 0x6b, 0x02, 0xd9, 0x43, 0x46, 0x8b, 0x2f, 0x3c, 0x79, 0x47, 0x15, 0xca, 0x37,
+  0xf8, 0xbe, 0x77, 0x8e, 0x65, 0x1b, 0x4b, 0xb2, 0x64, 0x4a, 0x0a, 0xf3, 0xb2, 0x41, 0xfe, 0x8c,
+  0x84, 0x3f, 0xe0, 0x32, 0x54, 0x99, 0x12, 0xd2, 0xbb, 0x4d, 0x9a, 0xe1, 0xed, 0xcb, 0x19, 0xd5,
+  0xc5, 0x15, 0xe5, 0x04, 0xe5, 0x74, 0x30, 0x75, 0xae, 0xf8, 0xe4, 0xa9, 0xe6, 0x98, 0xed, 0x21,
+  0x60, 0xfe, 0xbc, 0x85, 0x40, 0x19, 0xa3, 0x3d, 0x37, 0x27, 0xce, 0x29, 0xfb, 0x0e, 0xbf, 0x7d,
+  0x66, 0xef, 0xed, 0x61, 0x0c, 0xf6, 0xe7, 0x5e, 0xa8, 0xee, 0x0d, 0x63, 0x01, 0x5c, 0xf3, 0x1d,
+  0x4e, 0xb1, 0x0d, 0x34, 0x2f, 0xb2, 0xd8, 0xe3, 0x3a, 0x3e, 0xd2, 0xb2, 0xe8, 0xf7, 0x73, 0xa3,
+  0x41, 0xd7, 0xa8, 0xc6, 0x93, 0x80, 0x8e, 0x29, 0x4e, 0xaf, 0xf0, 0xfa, 0x0b, 0xa4, 0xc5, 0x3b,
+  0x44, 0xbe, 0x70, 0xf5, 0xca, 0x0a, 0x01, 0xc4, 0xe7, 0x9b, 0x5c, 0x28, 0x70, 0xa0, 0xad, 0xc8,
+  0x37, 0x91, 0x85, 0x7b, 0x9e, 0x91, 0x30, 0x59, 0x87, 0x61, 0x8e, 0x92, 0x24, 0xf9, 0x7b, 0xa2,
+  0xb2, 0xe8, 0x89, 0x6d, 0xd9, 0x04, 0xb1, 0xe8, 0x94, 0x5b, 0x2c, 0xa6, 0xf4, 0x73, 0x7c, 0x9d,
+  0xaa, 0x50, 0x0c, 0x47, 0xb1, 0x64, 0x14, 0xf2, 0xdd, 0xeb, 0xcb, 0x64, 0x02, 0x7c, 0x43, 0x81,
+  0xb1, 0x2a, 0xaf, 0xbc, 0x53, 0xfa, 0xf8, 0x42, 0x8e, 0x8e, 0x20, 0x75, 0xd6, 0xfd, 0xa8, 0x18,
+  0x25, 0x64, 0x25, 0x27, 0x49, 0x20, 0x23, 0x25, 0xf7, 0x59, 0x3e, 0x14, 0xfd, 0x4d, 0x03, 0x57,
+  0x30, 0x6e, 0x0f, 0x08, 0x43, 0x62, 0x10, 0xa7, 0x46, 0x4a, 0xa9, 0x4d, 0xe9, 0x2a, 0x64, 0x24,
+  0x83, 0xbe, 0xeb, 0x6f, 0x1d, 0x38, 0xd6, 0xfe, 0x39, 0x0d, 0x35, 0x80, 0x12, 0x20, 0x09, 0xe8,
+  0xcd, 0x9d, 0x07, 0xd5, 0xfd, 0x58, 0xf4, 0x6c, 0x76, 0x38, 0xa2, 0x42, 0xbb, 0x72, 0x36, 0xc6,
+  0x15, 0xe9, 0x4c, 0x3d, 0xe9, 0x71, 0x5a, 0xbc, 0xc5, 0x14, 0xf6, 0xae, 0x52, 0x15, 0x1c, 0x00,
+  0xae, 0x46, 0xa0, 0x65, 0xb8, 0x18, 0x33, 0xe5, 0xb7, 0xc0, 0x60, 0x78, 0xf4, 0x1b, 0xec, 0xfb,
+  0x25, 0xb2, 0x3d, 0x57, 0x5f, 0xc3, 0x66, 0x8d, 0x1f, 0x51, 0x03, 0xdb, 0xd9, 0xb3, 0xda, 0xed,
+  0xc3, 0x86, 0xf0, 0xf7, 0x9d, 0x77, 0x73, 0xd8, 0x5b, 0xa4, 0x62, 0x30, 0xbf, 0xd0, 0x4f, 0x2d,
+  0x0b, 0x1b, 0x2a, 0xe9, 0x69, 0x7a, 0xe5, 0x4b, 0xa4, 0xf8, 0x25, 0xf2, 0xdb, 0x8e, 0xd5, 0xd1,
+  0xc1, 0x45, 0xbb, 0xab, 0x81, 0x56, 0x11, 0x3d, 0x4c, 0x12, 0x9c, 0x9a, 0x28, 0x4e, 0x2a, 0xa4,
+  0xf4, 0x23, 0xb8, 0xa1, 0x07, 0x3a, 0x2b, 0x21, 0xfa, 0x4e, 0xcb, 0xbc, 0x56, 0xbe, 0xe8, 0xd2,
+  0x53, 0x93, 0x96, 0x99, 0x6f, 0x9b, 0x76, 0x34, 0xe1, 0xed, 0x2c, 0xbe, 0x16, 0xd3, 0xd7, 0x97,
+  0xde, 0xa9, 0xef, 0xc2, 0xe8, 0x42, 0x19, 0x88, 0x15, 0x16, 0x85, 0x6a, 0x1b, 0x54, 0x53, 0xd1,
+  0x8c, 0xff, 0xdf, 0xdf, 0x00, 0x1b, 0x16, 0x53, 0x79, 0x00, 0x80, 0x02, 0x00
+};
@@ -0,0 +1,423 @@
+// Замер скорости проверки вложений-архивов (см. archive_inspector).
+//
+// Архивы строятся прямо в памяти: для сжатия используется простой
+// упаковщик deflate (LZ77 с фиксированными кодами Хаффмана), поэтому
+// степень сжатия несколько хуже, чем у zlib. Блоки с динамическими
+// кодами берутся из gzip-файла, сжатого zlib (см. dynamic_fixture.hpp).
+//
+// Проверяются:
+// - zip с несколькими текстовыми файлами;
+// - вложенные архивы zip -> gz -> zip;
+// - тот же набор вложенных архивов с тестовой сигнатурой EICAR, которая
+//   попадает на стык первых двух порций, отдаваемых inflater-ом;
+// - gzip из нескольких членов и zip с динамическими кодами;
+// - zip-бомба из 16 файлов по 128 МБ нулей (должна быть отвергнута);
+// - слишком глубокая вложенность zip -> zip -> zip -> zip.
+//
+// Для каждого случая выводятся результат проверки, объем распакованных
+// данных и скорость распаковки и проверки. Если результат проверки
+// не совпадает с ожидаемым, то замер завершается с ошибкой.
+
+#include <common/messages.hpp>
+#include <common/archive_inspector.hpp>
+
+#include <archive_bench/dynamic_fixture.hpp>
+
+#include <iomanip>
+#include <random>
+
+using clock_type = chrono::steady_clock;
+
+// Запись битов в поток deflate (младшие биты идут первыми).
+class bit_writer {
+public :
+  void put( uint32_t value, unsigned bits ) {
+    buffer_ |= uint64_t{ value } << count_;
+    count_ += bits;
+    while( count_ >= 8 ) {
+      out_.push_back( static_cast< char >( buffer_ & 0xff ) );
+      buffer_ >>= 8;
+      count_ -= 8;
+    }
+  }
+
+  // Коды Хаффмана записываются начиная со старшего бита.
+  void put_code( uint32_t code, unsigned bits ) {
+    uint32_t reversed = 0;
+    for( unsigned i = 0; i != bits; ++i )
+      reversed |= ((code >> i) & 1u) << (bits - 1 - i);
+    put( reversed, bits );
+  }
+
+  string finish() {
+    if( count_ )
+      out_.push_back( static_cast< char >( buffer_ & 0xff ) );
+    return move(out_);
+  }
+
+private :
+  string out_;
+  uint64_t buffer_{ 0 };
+  unsigned count_{ 0 };
+};
+
+void put_literal_or_length( bit_writer & w, unsigned symbol ) {
+  if( symbol < 144 ) w.put_code( 0x30 + symbol, 8 );
+  else if( symbol < 256 ) w.put_code( 0x190 + symbol - 144, 9 );
+  else if( symbol < 280 ) w.put_code( symbol - 256, 7 );
+  else w.put_code( 0xc0 + symbol - 280, 8 );
+}
+
+void put_match( bit_writer & w, size_t length, size_t distance ) {
+  using namespace inflate_details;
+
+  unsigned i = 28;
+  while( length_base[ i ] > length )
+    --i;
+  put_literal_or_length( w, 257 + i );
+  w.put( static_cast< uint32_t >( length - length_base[ i ] ), length_extra[ i ] );
+
+  unsigned d = 29;
+  while( dist_base[ d ] > distance )
+    --d;
+  w.put_code( d, 5 );
+  w.put( static_cast< uint32_t >( distance - dist_base[ d ] ), dist_extra[ d ] );
+}
+
+// Сжатие в один блок deflate с фиксированными кодами.
+string deflate_fixed( const string & data ) {
+  const size_t window = 32768;
+  const size_t min_match = 3;
+  const size_t max_match = 258;
+  const unsigned max_chain = 16;
+  const unsigned hash_bits = 15;
+
+  vector< int64_t > head( size_t{ 1 } << hash_bits, -1 );
+  vector< int64_t > previous( data.size(), -1 );
+  const auto hash_at = [&]( size_t i ) {
+    const auto * p = reinterpret_cast< const uint8_t * >( data.data() + i );
+    return ((p[ 0 ] << 10) ^ (p[ 1 ] << 5) ^ p[ 2 ]) & ((1u << hash_bits) - 1);
+  };
+  const auto insert = [&]( size_t i ) {
+    if( i + min_match <= data.size() ) {
+      const auto h = hash_at( i );
+      previous[ i ] = head[ h ];
+      head[ h ] = static_cast< int64_t >( i );
+    }
+  };
+
+  bit_writer w;
+  w.put( 1, 1 );
+  w.put( 1, 2 );
+
+  for( size_t i = 0; i < data.size(); ) {
+    size_t best = 0, best_distance = 0;
+    if( i + min_match <= data.size() ) {
+      auto candidate = head[ hash_at( i ) ];
+      const size_t limit = min( max_match, data.size() - i );
+      for( unsigned chain = 0; chain != max_chain && candidate >= 0 &&
+          i - static_cast< size_t >( candidate ) <= window; ++chain ) {
+        const auto c = static_cast< size_t >( candidate );
+        size_t len = 0;
+        while( len != limit && data[ c + len ] == data[ i + len ] )
+          ++len;
+        if( len > best ) {
+          best = len;
+          best_distance = i - c;
+          if( len == limit )
+            break;
+        }
+        candidate = previous[ c ];
+      }
+    }
+
+    if( best >= min_match ) {
+      put_match( w, best, best_distance );
+      for( size_t k = 0; k != best; ++k )
+        insert( i + k );
+      i += best;
+    }
+    else {
+      put_literal_or_length( w, static_cast< uint8_t >( data[ i ] ) );
+      insert( i );
+      ++i;
+    }
+  }
+
+  put_literal_or_length( w, 256 );
+  return w.finish();
+}
+
+// Поток deflate для count нулевых байт без поиска совпадений: один
+// литерал и затем копии по 258 байт с расстояния 1.
+string deflate_zeros( size_t count ) {
+  bit_writer w;
+  w.put( 1, 1 );
+  w.put( 1, 2 );
+  put_literal_or_length( w, 0 );
+  for( --count; count >= 258; count -= 258 )
+    put_match( w, 258, 1 );
+  for( ; count; --count )
+    put_literal_or_length( w, 0 );
+  put_literal_or_length( w, 256 );
+  return w.finish();
+}
+
+void append16( string & to, uint32_t v ) {
+  to.push_back( static_cast< char >( v & 0xff ) );
+  to.push_back( static_cast< char >( (v >> 8) & 0xff ) );
+}
+
+void append32( string & to, uint32_t v ) {
+  append16( to, v & 0xffff );
+  append16( to, v >> 16 );
+}
+
+string make_gzip( const string & data ) {
+  string r{ "\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10 };
+  r += deflate_fixed( data );
+  append32( r, crc32_update( 0, data.data(), data.size() ) );
+  append32( r, static_cast< uint32_t >( data.size() ) );
+  return r;
+}
+
+struct zip_entry {
+  string name_;
+  // Содержимое после распаковки (нужно для CRC и размера).
+  uint32_t crc_;
+  size_t size_;
+  string packed_;
+};
+
+zip_entry make_zip_entry( string name, const string & data ) {
+  return zip_entry{ move(name), crc32_update( 0, data.data(), data.size() ),
+      data.size(), deflate_fixed( data ) };
+}
+
+string make_zip( const vector< zip_entry > & entries ) {
+  string r, directory;
+  for( const auto & e : entries ) {
+    const auto offset = static_cast< uint32_t >( r.size() );
+    const auto header = [&]( string & to ) {
+      append16( to, 20 ); // version needed
+      append16( to, 0 );  // flags
+      append16( to, 8 );  // deflate
+      append32( to, 0 );  // time, date
+      append32( to, e.crc_ );
+      append32( to, static_cast< uint32_t >( e.packed_.size() ) );
+      append32( to, static_cast< uint32_t >( e.size_ ) );
+      append16( to, static_cast< uint32_t >( e.name_.size() ) );
+      append16( to, 0 );  // extra
+    };
+
+    append32( r, 0x04034b50 );
+    header( r );
+    r += e.name_;
+    r += e.packed_;
+
+    append32( directory, 0x02014b50 );
+    append16( directory, 20 ); // version made by
+    header( directory );
+    append16( directory, 0 );  // comment
+    append16( directory, 0 );  // disk
+    append16( directory, 0 );  // internal attributes
+    append32( directory, 0 );  // external attributes
+    append32( directory, offset );
+    directory += e.name_;
+  }
+
+  const auto directory_offset = static_cast< uint32_t >( r.size() );
+  r += directory;
+  append32( r, 0x06054b50 );
+  append32( r, 0 ); // disks
+  append16( r, static_cast< uint32_t >( entries.size() ) );
+  append16( r, static_cast< uint32_t >( entries.size() ) );
+  append32( r, static_cast< uint32_t >( directory.size() ) );
+  append32( r, directory_offset );
+  append16( r, 0 ); // comment
+  return r;
+}
+
+// Текст из случайных слов: сжимается примерно так же, как письма.
+string make_text( size_t size, unsigned seed ) {
+  mt19937 gen( seed );
+  vector< string > words;
+  for( int i = 0; i != 5000; ++i ) {
+    string w( 2 + gen() % 9, ' ' );
+    for( auto & c : w )
+      c = static_cast< char >( 'a' + gen() % 26 );
+    words.push_back( move(w) );
+  }
+
+  string r;
+  r.reserve( size + 16 );
+  while( r.size() < size ) {
+    r += words[ gen() % words.size() ];
+    r += (gen() % 12) ? ' ' : '\n';
+  }
+  r.resize( size );
+  return r;
+}
+
+// Размер первой порции, которую inflater отдает при распаковке packed.
+size_t first_chunk_size( const string & packed ) {
+  inflater inf;
+  size_t first = 0;
+  inf.inflate( packed.data(), packed.size(), [&]( const char *, size_t size ) {
+      first = size;
+      return false;
+    } );
+  return first;
+}
+
+// Помещение marker в text так, чтобы он оказался на стыке первых двух
+// порций. Первая порция отдается, когда до конца буфера inflater-а
+// остается меньше max_match байт, но точное место зависит от того, на
+// какие литералы и совпадения разбиты данные, а сам marker это разбиение
+// меняет. Поэтому стык находится распаковкой, и marker переставляется,
+// пока стык не окажется внутри него.
+void place_across_first_seam( string & text, const string & marker ) {
+  auto seam = first_chunk_size( deflate_fixed( text ) );
+  for( unsigned attempt = 0; attempt != 8; ++attempt ) {
+    const auto start = seam - marker.size() / 2;
+    auto candidate = text;
+    candidate.replace( start, marker.size(), marker );
+    seam = first_chunk_size( deflate_fixed( candidate ) );
+    if( seam > start && seam < start + marker.size() ) {
+      text = move(candidate);
+      return;
+    }
+  }
+  throw runtime_error( "unable to place marker across the first inflater seam" );
+}
+
+string make_nested( const string & marker ) {
+  vector< zip_entry > inner;
+  for( unsigned i = 0; i != 4; ++i ) {
+    auto text = make_text( 1u << 20, 100 + i );
+    if( 3 == i )
+      place_across_first_seam( text, marker );
+    inner.push_back( make_zip_entry( "inner" + to_string( i ) + ".txt", text ) );
+  }
+
+  return make_zip( { make_zip_entry( "payload.zip.gz",
+      make_gzip( make_zip( inner ) ) ) } );
+}
+
+string make_bomb() {
+  const size_t entry_size = 128u << 20;
+  const auto packed = deflate_zeros( entry_size );
+  const auto crc = [&]{
+    const string block( 1u << 20, '\0' );
+    uint32_t c = 0;
+    for( size_t i = 0; i != entry_size / block.size(); ++i )
+      c = crc32_update( c, block.data(), block.size() );
+    return c;
+  }();
+
+  vector< zip_entry > entries;
+  for( unsigned i = 0; i != 16; ++i )
+    entries.push_back( zip_entry{ "zeros" + to_string( i ), crc, entry_size, packed } );
+  return make_zip( entries );
+}
+
+// gzip из нескольких одинаковых членов со сжатым zlib текстом.
+string make_dynamic_gzip( unsigned members ) {
+  const string member( reinterpret_cast< const char * >( dynamic_fixture_gz ),
+      sizeof(dynamic_fixture_gz) );
+  string r;
+  for( unsigned i = 0; i != members; ++i )
+    r += member;
+  return r;
+}
+
+// zip, элементы которого сжаты zlib: поток deflate берется из gzip-файла
+// без заголовка (10 байт, флагов в нем нет) и завершения (8 байт).
+string make_dynamic_zip( unsigned entries ) {
+  const auto * data = reinterpret_cast< const char * >( dynamic_fixture_gz );
+  const string packed( data + 10, sizeof(dynamic_fixture_gz) - 18 );
+
+  vector< zip_entry > r;
+  for( unsigned i = 0; i != entries; ++i )
+    r.push_back( zip_entry{ "text" + to_string( i ) + ".txt",
+        dynamic_fixture_crc, dynamic_fixture_size, packed } );
+  return make_zip( r );
+}
+
+string make_deep() {
+  auto archive = make_zip( { make_zip_entry( "doc.txt", make_text( 4096, 7 ) ) } );
+  for( unsigned i = 0; i != 3; ++i )
+    archive = make_zip( { make_zip_entry( "level.zip", archive ) } );
+  return archive;
+}
+
+void run_case(
+  const string & name,
+  const string & attachment,
+  check_status expected,
+  unsigned repeats )
+{
+  archive_inspector inspector;
+  auto status = check_status::safe;
+  uint64_t unpacked = 0;
+
+  const auto started = clock_type::now();
+  for( unsigned i = 0; i != repeats; ++i ) {
+    status = inspector.inspect( attachment.data(), attachment.size() );
+    unpacked += inspector.unpacked_bytes();
+  }
+  const chrono::duration< double > elapsed = clock_type::now() - started;
+
+  cout << left << setw( 14 ) << name << right
+      << setw( 12 ) << status_name( status )
+      << setw( 10 ) << attachment.size() / 1024 << " KiB"
+      << setw( 10 ) << unpacked / repeats / 1024 << " KiB"
+      << setw( 10 ) << fixed << setprecision( 1 )
+      << unpacked / elapsed.count() / (1 << 20) << " MiB/s"
+      << setw( 10 ) << setprecision( 2 )
+      << elapsed.count() * 1000 / repeats << " ms" << endl;
+
+  if( expected != status )
+    throw runtime_error( name + ": " + status_name( status ) + " instead of " +
+        status_name( expected ) );
+}
+
+int main( int argc, char ** argv ) {
+  try {
+    const unsigned repeats = 2 == argc ? static_cast< unsigned >( stoul( argv[1] ) ) : 10;
+
+    cout << "building archives..." << endl;
+    vector< zip_entry > texts;
+    for( unsigned i = 0; i != 8; ++i )
+      texts.push_back( make_zip_entry( "file" + to_string( i ) + ".txt",
+          make_text( 512u << 10, i ) ) );
+    const auto flat = make_zip( texts );
+    const auto nested = make_nested( "just some text" );
+    const auto infected = make_nested( "EICAR-STANDARD-ANTIVIRUS-TEST-FILE!" );
+    const auto dynamic_gz = make_dynamic_gzip( 8 );
+    const auto dynamic_zip = make_dynamic_zip( 8 );
+    const auto bomb = make_bomb();
+    const auto deep = make_deep();
+
+    cout << left << setw( 14 ) << "case" << right
+        << setw( 12 ) << "status"
+        << setw( 14 ) << "packed"
+        << setw( 14 ) << "unpacked"
+        << setw( 16 ) << "speed"
+        << setw( 13 ) << "per check" << endl;
+    run_case( "zip", flat, check_status::safe, repeats );
+    run_case( "zip/gz/zip", nested, check_status::safe, repeats );
+    run_case( "infected", infected, check_status::dangerous, repeats );
+    run_case( "dynamic gz", dynamic_gz, check_status::safe, repeats );
+    run_case( "dynamic zip", dynamic_zip, check_status::safe, repeats );
+    run_case( "zip bomb", bomb, check_status::dangerous, repeats );
+    run_case( "too deep", deep, check_status::dangerous, repeats );
+
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
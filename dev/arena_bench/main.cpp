@@ -0,0 +1,181 @@
+// Измерение количества обращений к куче на один email при разборе
+// и раздаче данных checker-ам: в старой схеме (std::string и
+// make_shared) и при использовании арены email-а.
+//
+// Подсчитываются только выделения памяти, которые делает сам конвейер
+// обработки email-а. Сообщения, кооперации и агенты создаются
+// SObjectizer-ом и в этот замер не входят. Выделения подсчитываются
+// заменой operator new (см. common/counting_new.hpp).
+//
+// Как и в конвейере, email загружается и разбирается на одной нити,
+// а последние ссылки на его данные отпускаются на другой.
+
+#include <common/stuff.hpp>
+#include <common/counting_new.hpp>
+
+// Email, похожий на настоящий: заголовки разной длины и тело в несколько КБ.
+string make_sample_email() {
+  string r;
+  for( int i = 0; i != 20; ++i )
+    r += "X-Header-" + to_string( i ) + ": " + string( 20 + i * 3, 'h' ) + "\r\n";
+  r += "\r\n";
+  for( int i = 0; i != 64; ++i )
+    r += string( 70, 'b' ) + "\r\n";
+  return r;
+}
+
+// Данные одного email-а, которые держит конвейер до конца его проверки.
+// Последние ссылки на них отпускает другая нить (см. release_thread).
+struct legacy_holder {
+  using legacy_parsed_email = basic_parsed_email< allocator< char > >;
+
+  string content_;
+  shared_ptr< legacy_parsed_email > parsed_;
+};
+
+// Старая схема: содержимое в std::string, разобранный email через
+// make_shared, каждый checker получает собственную копию своих данных.
+check_status legacy_email( const string & source, legacy_holder & keep ) {
+  keep.content_ = source;
+  keep.parsed_ = make_shared< legacy_holder::legacy_parsed_email >();
+  keep.parsed_->parse( keep.content_.data(), keep.content_.size() );
+
+  const auto headers = keep.parsed_->headers();
+  const auto body = keep.parsed_->body();
+  const auto attachments = keep.parsed_->attachments();
+
+  auto status = check_headers( headers );
+  if( check_status::safe == status )
+    status = check_body( body );
+  if( check_status::safe == status )
+    status = check_attachments( attachments );
+  return status;
+}
+
+struct arena_holder {
+  parsed_email_ref parsed_{ email_arena_ref{}, nullptr };
+};
+
+// Новая схема: все данные в арене email-а, checker-ы разделяют
+// ссылку на разобранный email.
+check_status arena_email( const string & source, arena_holder & keep ) {
+  email_content content{ acquire_email_arena(), source.data(), source.size() };
+  keep.parsed_ = parse_email( content );
+
+  const auto headers_ref = keep.parsed_;
+  const auto body_ref = keep.parsed_;
+  const auto attachments_ref = keep.parsed_;
+
+  auto status = check_headers( headers_ref->headers() );
+  if( check_status::safe == status )
+    status = check_body( body_ref->body() );
+  if( check_status::safe == status )
+    status = check_attachments( attachments_ref->attachments() );
+  return status;
+}
+
+//
+// Нить, которая отпускает данные email-ов, как нить анализатора или
+// checker-а в конвейере: email загружается и разбирается на одной нити,
+// а освобождается на другой. Данные передаются через кольцевой буфер
+// фиксированного размера, поэтому сама передача памяти не выделяет.
+//
+template< typename HOLDER >
+class release_thread {
+  static constexpr size_t capacity = 64;
+
+public :
+  release_thread() : slots_( capacity ) {
+    thread_ = thread( [this]{ body(); } );
+  }
+  ~release_thread() {
+    wait_empty();
+    stop_.store( true, memory_order_release );
+    thread_.join();
+  }
+
+  void push( HOLDER && h ) {
+    const auto tail = tail_.load( memory_order_relaxed );
+    while( tail - head_.load( memory_order_acquire ) == capacity )
+      this_thread::yield();
+    slots_[ tail % capacity ] = move(h);
+    tail_.store( tail + 1, memory_order_release );
+  }
+
+  // Ожидание, пока все переданные данные будут отпущены.
+  void wait_empty() {
+    while( head_.load( memory_order_acquire ) != tail_.load( memory_order_relaxed ) )
+      this_thread::yield();
+  }
+
+private :
+  vector< HOLDER > slots_;
+  atomic< size_t > head_{ 0 };
+  atomic< size_t > tail_{ 0 };
+  atomic< bool > stop_{ false };
+  thread thread_;
+
+  void body() {
+    for(;;) {
+      const auto head = head_.load( memory_order_relaxed );
+      if( head == tail_.load( memory_order_acquire ) ) {
+        if( stop_.load( memory_order_acquire ) )
+          return;
+        this_thread::yield();
+        continue;
+      }
+      slots_[ head % capacity ] = HOLDER{};
+      head_.store( head + 1, memory_order_release );
+    }
+  }
+};
+
+template< typename HOLDER, typename F >
+void measure( const char * name, size_t emails, const string & source, F && f ) {
+  release_thread< HOLDER > releaser;
+
+  // Прогрев: в пуле должны появиться арены, а арены, отпущенные
+  // другой нитью, должны вернуться в пул этой нити.
+  for( int i = 0; i != 256; ++i ) {
+    HOLDER keep;
+    f( source, keep );
+    releaser.push( move(keep) );
+  }
+  releaser.wait_empty();
+
+  const auto allocs_before = allocation_counter().load();
+  const auto started_at = chrono::steady_clock::now();
+
+  size_t unsafe = 0;
+  for( size_t i = 0; i != emails; ++i ) {
+    HOLDER keep;
+    if( check_status::safe != f( source, keep ) )
+      ++unsafe;
+    releaser.push( move(keep) );
+  }
+  releaser.wait_empty();
+
+  const auto ns = chrono::duration_cast< chrono::nanoseconds >(
+      chrono::steady_clock::now() - started_at ).count();
+  const auto allocs = allocation_counter().load() - allocs_before;
+
+  cout << name << ": "
+      << static_cast< double >( allocs ) / static_cast< double >( emails )
+      << " allocations/email, "
+      << static_cast< double >( ns ) / static_cast< double >( emails )
+      << " ns/email"
+      << (unsafe ? " (unexpected verdicts)" : "") << endl;
+}
+
+int main() {
+  const size_t emails = 100000;
+  const auto source = make_sample_email();
+
+  cout << "emails: " << emails << ", email size: " << source.size()
+      << " bytes (released on another thread)" << endl;
+
+  measure< legacy_holder >( "legacy", emails, source, legacy_email );
+  measure< arena_holder >( "arena ", emails, source, arena_email );
+
+  return 0;
+}
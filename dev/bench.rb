@@ -0,0 +1,90 @@
+#!/usr/bin/ruby
+#
+# Сравнение архитектур v1-v7 на одинаковой нагрузке.
+#
+# Запускает уже собранные примеры (см. build.rb) с переменной окружения
+# EMAIL_BENCH_REQUESTS, при которой requests_initiator отсылает заданное
+# количество запросов и в конце выводит строку "bench: ..." с
+# показателями (см. common/bench_stats.hpp). Строки всех примеров
+# сводятся в одну таблицу.
+#
+# Колонка allocs/email заполняется, только если примеры собраны
+# с переменной окружения EMAIL_COUNT_ALLOCATIONS=1.
+#
+# Использование:
+#
+#   ruby bench.rb [каталог с exe-файлами] [количество email-ов]
+#
+# По умолчанию используются target/release и 500 email-ов.
+#
+
+require 'open3'
+require 'rbconfig'
+
+exe_dir = ARGV[0] || File.join( 'target', 'release' )
+requests = ARGV[1] || '500'
+
+# Название, exe-файл, аргументы командной строки.
+ARCHITECTURES = [
+  [ 'v1', 'v1_app' ],
+  [ 'v2', 'v2_app' ],
+  [ 'v3', 'v3_app' ],
+  [ 'v4', 'v4_app' ],
+  [ 'v5', 'v5_app' ],
+  [ 'v5_monitor', 'v5_monitor_app' ],
+  [ 'v6', 'v6_app' ],
+  [ 'v7', 'v7_app' ],
+  [ 'v7_coro', 'v7_coro_app', 'coroutine' ]
+]
+
+# Заголовок колонки и ключ в строке "bench: ...".
+COLUMNS = [
+  [ 'emails/s', 'throughput' ],
+  [ 'p50 ms', 'p50_ms' ],
+  [ 'p90 ms', 'p90_ms' ],
+  [ 'p99 ms', 'p99_ms' ],
+  [ 'max ms', 'max_ms' ],
+  [ 'rss KiB', 'peak_rss_kib' ],
+  [ 'vol csw', 'voluntary_csw' ],
+  [ 'invol csw', 'involuntary_csw' ],
+  [ 'allocs/email', 'allocs_per_email' ]
+]
+
+windows = RbConfig::CONFIG[ 'host_os' ] =~ /mswin|mingw/
+
+rows = ARCHITECTURES.map do |name, exe, *args|
+  path = File.join( exe_dir, windows ? exe + '.exe' : exe )
+  unless File.executable?( path )
+    next [ name, 'not built' ]
+  end
+
+  $stderr.puts "running #{name}..."
+  env = {
+    'EMAIL_BENCH_REQUESTS' => requests,
+    'EMAIL_RESULTS' => File::NULL
+  }
+  _, err, status = Open3.capture3( env, path, *args )
+  line = err.lines.grep( /^bench:/ ).last
+  unless status.success? && line
+    next [ name, "failed (exit code #{status.exitstatus})" ]
+  end
+
+  values = Hash[ line.split[ 1..-1 ].map { |kv| kv.split( '=', 2 ) } ]
+  [ name, values ]
+end
+
+name_width = ARCHITECTURES.map { |a| a[ 0 ].size }.max + 2
+widths = COLUMNS.map { |title, _| [ title.size, 9 ].max + 2 }
+
+puts 'architecture'.ljust( name_width ) +
+  COLUMNS.each_with_index.map { |(title, _), i| title.rjust( widths[ i ] ) }.join
+rows.each do |name, values|
+  if values.is_a?( String )
+    puts name.ljust( name_width ) + '  ' + values
+  else
+    puts name.ljust( name_width ) +
+      COLUMNS.each_with_index.map { |(_, key), i|
+        ( values[ key ] || '-' ).rjust( widths[ i ] )
+      }.join
+  end
+end
@@ -10,6 +10,12 @@ MxxRu::Cpp::composite_target( MxxRu::BUILD_ROOT ) {
     global_linker_option '-pthread'
   end
 
+  # Для bench.rb: примеры v1-v7 подсчитывают выделения памяти
+  # (см. common/allocation_counter.hpp).
+  if ENV[ 'EMAIL_COUNT_ALLOCATIONS' ]
+    global_define 'EMAIL_COUNT_ALLOCATIONS'
+  end
+
   # If there is local options file then use it.
   if FileTest.exist?( "local-build.rb" )
     required_prj "local-build.rb"
@@ -27,4 +33,21 @@ MxxRu::Cpp::composite_target( MxxRu::BUILD_ROOT ) {
   required_prj 'v5_monitor/prj.rb'
   required_prj 'v6/prj.rb'
   required_prj 'v7/prj.rb'
+
+  # Эти примеры используют POSIX-средства (mmap, inotify и т.п.).
+  if 'vc' != toolset.name
+    required_prj 'v7_mbox/prj.rb'
+    required_prj 'v7_maildir/prj.rb'
+    required_prj 'v7_bridge/prj.rb'
+    required_prj 'v7_coro/prj.rb'
+  end
+
+  required_prj 'arena_bench/prj.rb'
+  required_prj 'timer_bench/prj.rb'
+  required_prj 'domain_set_tool/prj.rb'
+  required_prj 'fuzzy_db_tool/prj.rb'
+  required_prj 'archive_bench/prj.rb'
+  required_prj 'policy_sim/prj.rb'
+  required_prj 'steal_bench/prj.rb'
+  required_prj 'self_check/prj.rb'
 }
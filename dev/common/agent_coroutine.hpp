@@ -0,0 +1,245 @@
+#pragma once
+
+#include <common/messages.hpp>
+
+#include <coroutine>
+#include <utility>
+
+//
+// Сопрограммы C++20 внутри агентов SObjectizer.
+//
+// Агент, унаследованный от coroutine_agent_t, может описать свою работу
+// одной сопрограммой, которая ждет нужные ей сообщения через
+//
+//   auto r = co_await receive< A, B >( timeout );
+//
+// Сопрограмма возобновляется прямо внутри обработчика пришедшего
+// сообщения, т.е. на рабочей нити агента, поэтому никакой
+// синхронизации не требуется. Указатель на сообщение действителен
+// до следующего co_await. Если за отведенное время ни одно из ожидаемых
+// сообщений не пришло, то r.timed_out() возвращает true.
+//
+// Сообщения, которые сопрограмма не ждет в данный момент (например,
+// опоздавшие ответы), просто выбрасываются.
+//
+// Типы ожидаемых сообщений должны быть заранее подписаны через
+// subscribe_awaited< A, B >() в so_define_agent(). Проверка того, ждет
+// ли сопрограмма пришедшее сообщение, -- это сравнение адресов
+// статических ключей типов, т.е. без обращений к RTTI.
+//
+// Требуется компилятор с поддержкой C++20.
+//
+
+// Статистика кадров сопрограмм (для оценки расхода памяти).
+struct coroutine_frame_stats {
+  atomic< size_t > frames_{ 0 };
+  atomic< size_t > bytes_{ 0 };
+};
+
+coroutine_frame_stats & global_coroutine_frame_stats() {
+  static coroutine_frame_stats stats;
+  return stats;
+}
+
+// Сопрограмма агента. Начинает выполняться сразу при вызове, а ее кадр
+// уничтожается вместе с объектом agent_task, даже если сопрограмма
+// в этот момент чего-то ждет.
+class agent_task {
+public :
+  struct promise_type {
+    agent_task get_return_object() {
+      return agent_task{ handle_t::from_promise( *this ) };
+    }
+    suspend_never initial_suspend() noexcept { return {}; }
+    suspend_always final_suspend() noexcept { return {}; }
+    void return_void() {}
+    // Исключение уходит в обработчик сообщения, который возобновил
+    // сопрограмму, и дальше обрабатывается самим SObjectizer-ом.
+    void unhandled_exception() { throw; }
+
+    static void * operator new( size_t size ) {
+      auto & stats = global_coroutine_frame_stats();
+      ++stats.frames_;
+      stats.bytes_ += size;
+      return ::operator new( size );
+    }
+    static void operator delete( void * frame ) {
+      ::operator delete( frame );
+    }
+  };
+
+  using handle_t = coroutine_handle< promise_type >;
+
+  agent_task() = default;
+  explicit agent_task( handle_t handle ) : handle_( handle ) {}
+  agent_task( agent_task && o ) noexcept : handle_( exchange( o.handle_, {} ) ) {}
+  agent_task & operator=( agent_task && o ) noexcept {
+    if( this != &o ) {
+      reset();
+      handle_ = exchange( o.handle_, {} );
+    }
+    return *this;
+  }
+  ~agent_task() { reset(); }
+
+private :
+  handle_t handle_;
+
+  void reset() {
+    if( handle_ )
+      handle_.destroy();
+    handle_ = {};
+  }
+};
+
+// Результат ожидания одного из сообщений Ms.
+template< typename... Ms >
+class received {
+public :
+  received() = default;
+  received( const void * msg, unsigned index ) : msg_( msg ), index_( index ) {}
+
+  bool timed_out() const { return !msg_; }
+
+  // Порядковый номер типа пришедшего сообщения в Ms.
+  unsigned index() const { return index_; }
+
+  // Указатель на сообщение, если пришло сообщение типа M.
+  template< typename M >
+  const M * get() const {
+    return !timed_out() && index_ == index_of< M >() ?
+        static_cast< const M * >( msg_ ) : nullptr;
+  }
+
+  // Вызов f( msg ) для пришедшего сообщения.
+  template< typename F >
+  void visit( F && f ) const {
+    if( !timed_out() )
+      visit_impl( f, index_sequence_for< Ms... >{} );
+  }
+
+private :
+  const void * msg_{ nullptr };
+  unsigned index_{ 0 };
+
+  template< typename M >
+  static constexpr unsigned index_of() {
+    unsigned i = 0;
+    bool found = false;
+    ((found || (found = is_same< M, Ms >::value) || (++i, false)), ...);
+    return i;
+  }
+
+  template< typename F, size_t... Is >
+  void visit_impl( F & f, index_sequence< Is... > ) const {
+    ((index_ == Is ? f( *static_cast< const Ms * >( msg_ ) ) : void()), ...);
+  }
+};
+
+class coroutine_agent_t : public agent_t {
+  // Тайм-аут ожидания. Номер ожидания нужен для того, чтобы отличить
+  // тайм-аут текущего ожидания от опоздавшего тайм-аута предыдущего.
+  struct wakeup {
+    uint64_t generation_;
+  };
+
+  // То, чего сейчас ждет сопрограмма.
+  struct pending_wait {
+    coroutine_handle<> handle_;
+    // Принимает ли ожидание сообщение с ключом типа key.
+    virtual bool offer( const void * key, const void * msg ) = 0;
+  };
+
+  template< typename M >
+  static const void * key_of() {
+    static const char key{};
+    return &key;
+  }
+
+public :
+  coroutine_agent_t( context_t ctx ) : agent_t( ctx ) {
+    so_subscribe_self().event( &coroutine_agent_t::on_wakeup );
+  }
+
+protected :
+  template< typename... Ms >
+  class receive_awaiter final : public pending_wait {
+  public :
+    receive_awaiter(
+      coroutine_agent_t & agent,
+      chrono::steady_clock::duration timeout )
+      : agent_( agent ), timeout_( timeout )
+    {}
+
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend( coroutine_handle<> handle ) {
+      this->handle_ = handle;
+      agent_.wait( *this, timeout_ );
+    }
+
+    received< Ms... > await_resume() const noexcept { return result_; }
+
+    virtual bool offer( const void * key, const void * msg ) override {
+      const void * keys[] = { key_of< Ms >()... };
+      for( unsigned i = 0; i != sizeof...(Ms); ++i )
+        if( keys[ i ] == key ) {
+          result_ = received< Ms... >{ msg, i };
+          return true;
+        }
+      return false;
+    }
+
+  private :
+    coroutine_agent_t & agent_;
+    const chrono::steady_clock::duration timeout_;
+    received< Ms... > result_;
+  };
+
+  template< typename... Ms >
+  receive_awaiter< Ms... > receive( chrono::steady_clock::duration timeout ) {
+    return receive_awaiter< Ms... >{ *this, timeout };
+  }
+
+  // Подписка на сообщения, которые будет ждать сопрограмма.
+  template< typename... Ms >
+  void subscribe_awaited() {
+    (so_subscribe_self().event( [this]( const Ms & msg ) {
+        deliver( key_of< Ms >(), &msg );
+      } ), ...);
+  }
+
+  // Запуск сопрограммы. Агент владеет ее кадром.
+  void start_coroutine( agent_task task ) {
+    task_ = move(task);
+  }
+
+private :
+  pending_wait * waiting_{ nullptr };
+  uint64_t generation_{ 0 };
+  timer_id_t timeout_timer_;
+  agent_task task_;
+
+  void wait( pending_wait & w, chrono::steady_clock::duration timeout ) {
+    waiting_ = &w;
+    timeout_timer_ = send_periodic< wakeup >( *this,
+        timeout, chrono::milliseconds::zero(), ++generation_ );
+  }
+
+  void deliver( const void * key, const void * msg ) {
+    if( waiting_ && waiting_->offer( key, msg ) )
+      resume();
+  }
+
+  void on_wakeup( const wakeup & msg ) {
+    if( waiting_ && generation_ == msg.generation_ )
+      resume();
+  }
+
+  void resume() {
+    const auto handle = waiting_->handle_;
+    waiting_ = nullptr;
+    timeout_timer_.release();
+    handle.resume();
+  }
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+//
+// Счетчик выделений памяти для замеров.
+//
+// Сам счетчик увеличивается только заменой глобального operator new
+// из common/counting_new.hpp. Эта замена подключается лишь в программы
+// для замеров: arena_bench всегда, а примеры v1-v7 -- только при сборке
+// с EMAIL_COUNT_ALLOCATIONS (см. build.rb). В остальных программах
+// счетчик остается нулевым.
+//
+
+inline std::atomic< std::size_t > & allocation_counter() {
+  static std::atomic< std::size_t > counter{ 0 };
+  return counter;
+}
+
+// Подсчитываются ли выделения памяти в примерах v1-v7.
+constexpr bool allocation_counting_enabled() {
+#if defined(EMAIL_COUNT_ALLOCATIONS)
+  return true;
+#else
+  return false;
+#endif
+}
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <common/messages.hpp>
+#include <common/inflate.hpp>
+#include <common/memory_budget.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+//
+// Проверка вложений, в том числе упакованных в zip и gzip.
+//
+// Архив не распаковывается целиком: элементы архива распаковываются
+// по очереди, и распакованные данные порциями передаются сканеру
+// сигнатур. Поэтому для обычных элементов архива расход памяти
+// ограничен буфером inflater-а и не зависит от их размера.
+//
+// Вложенный архив (zip внутри zip-а, gz внутри zip-а и т.д.) приходится
+// сначала распаковать в память целиком, т.к. оглавление zip-а находится
+// в конце файла. Поэтому размер вложенного архива ограничивается,
+// а всего в памяти может оказаться не более max_depth_ таких буферов.
+// На время проверки эти буферы учитываются в общем бюджете памяти
+// email-ов (см. memory_budget.hpp).
+//
+// Защита от zip-бомб:
+//   - ограничивается глубина вложенности архивов;
+//   - ограничивается суммарный объем распакованных данных для всего
+//     вложения, включая все уровни вложенности;
+//   - ограничивается степень сжатия каждого элемента архива;
+//   - ограничивается общее количество элементов архива.
+// При нарушении любого из ограничений распаковка сразу прекращается,
+// а вложение считается опасным.
+//
+// Зашифрованные и поврежденные архивы, а также архивы в неподдерживаемых
+// форматах (zip64, методы сжатия, отличные от deflate) проверить нельзя,
+// поэтому они считаются подозрительными.
+//
+
+struct archive_limits {
+  // Глубина вложенности: 1 -- само вложение, 2 -- архив внутри него и т.д.
+  unsigned max_depth_{ 3 };
+  // Сколько всего байт может быть распаковано для одного вложения.
+  uint64_t max_total_bytes_{ 256u << 20 };
+  // Наибольшая степень сжатия элемента архива. Проверяется только после
+  // того, как элемент дал больше ratio_min_bytes_ байт, т.к. маленькие
+  // файлы из одинаковых байт сжимаются очень сильно вполне законно.
+  uint64_t max_ratio_{ 100 };
+  uint64_t ratio_min_bytes_{ 1u << 20 };
+  // Наибольший размер вложенного архива после распаковки.
+  size_t max_nested_bytes_{ 16u << 20 };
+  // Сколько всего может быть элементов во всех архивах вложения.
+  size_t max_entries_{ 10000 };
+};
+
+namespace archive_details {
+
+inline uint16_t get16( const uint8_t * p ) {
+  return static_cast< uint16_t >( p[ 0 ] | (p[ 1 ] << 8) );
+}
+
+inline uint32_t get32( const uint8_t * p ) {
+  return p[ 0 ] | (uint32_t{ p[ 1 ] } << 8) | (uint32_t{ p[ 2 ] } << 16) |
+      (uint32_t{ p[ 3 ] } << 24);
+}
+
+inline bool is_zip( const void * data, size_t size ) {
+  return size >= 4 && 0 == memcmp( data, "PK\x03\x04", 4 );
+}
+
+inline bool is_gzip( const void * data, size_t size ) {
+  return size >= 2 && 0 == memcmp( data, "\x1f\x8b", 2 );
+}
+
+struct signature {
+  string bytes_;
+  check_status status_;
+};
+
+// Сигнатуры, которые ищутся в содержимом вложений.
+const vector< signature > & attachment_signatures() {
+  static const vector< signature > signatures{
+      // Тестовый файл антивирусов.
+      { "EICAR-STANDARD-ANTIVIRUS-TEST-FILE!", check_status::dangerous }
+    };
+  return signatures;
+}
+
+} /* namespace archive_details */
+
+//
+// Потоковый поиск сигнатур. Сигнатура находится и в том случае, если
+// она оказалась разрезанной между соседними порциями данных.
+//
+class signature_scanner {
+public :
+  signature_scanner() {
+    for( const auto & s : archive_details::attachment_signatures() )
+      longest_ = max( longest_, s.bytes_.size() );
+  }
+
+  void reset() {
+    tail_.clear();
+    started_ = false;
+    status_ = check_status::safe;
+  }
+
+  void feed( const char * data, size_t size ) {
+    if( !size )
+      return;
+
+    // Исполняемые файлы во вложениях подозрительны сами по себе.
+    if( !started_ ) {
+      started_ = true;
+      if( (size >= 2 && 0 == memcmp( data, "MZ", 2 )) ||
+          (size >= 4 && 0 == memcmp( data, "\x7f" "ELF", 4 )) )
+        status_ = max( status_, check_status::suspicious );
+    }
+
+    // Стык с предыдущей порцией.
+    if( !tail_.empty() ) {
+      const auto joined_size = tail_.size();
+      tail_.append( data, min( size, longest_ - 1 ) );
+      search( tail_.data(), tail_.size() );
+      tail_.resize( joined_size );
+    }
+
+    search( data, size );
+
+    // Для следующего стыка нужны последние longest_ - 1 байт.
+    if( size >= longest_ - 1 )
+      tail_.assign( data + size - (longest_ - 1), longest_ - 1 );
+    else {
+      tail_.append( data, size );
+      if( tail_.size() > longest_ - 1 )
+        tail_.erase( 0, tail_.size() - (longest_ - 1) );
+    }
+  }
+
+  check_status status() const { return status_; }
+
+private :
+  size_t longest_{ 1 };
+  string tail_;
+  bool started_{ false };
+  check_status status_{ check_status::safe };
+
+  void search( const char * data, size_t size ) {
+    for( const auto & s : archive_details::attachment_signatures() ) {
+      if( s.status_ <= status_ )
+        continue;
+      const char * end = data + size;
+      for( const char * p = data;
+          static_cast< size_t >( end - p ) >= s.bytes_.size() &&
+          nullptr != (p = static_cast< const char * >(
+              memchr( p, s.bytes_[ 0 ], end - p - s.bytes_.size() + 1 )));
+          ++p )
+        if( 0 == memcmp( p, s.bytes_.data(), s.bytes_.size() ) ) {
+          status_ = s.status_;
+          break;
+        }
+    }
+  }
+};
+
+//
+// Проверка одного вложения. Объект не потокобезопасен, но может
+// повторно использоваться для последовательной проверки разных вложений.
+//
+class archive_inspector {
+public :
+  explicit archive_inspector( archive_limits limits = archive_limits{} )
+    : limits_( limits )
+  {}
+
+  check_status inspect( const char * data, size_t size ) {
+    total_ = 0;
+    entries_ = 0;
+    return inspect_data( reinterpret_cast< const uint8_t * >( data ), size, 1 );
+  }
+
+  // Сколько байт было распаковано при последней проверке.
+  uint64_t unpacked_bytes() const { return total_; }
+
+private :
+  const archive_limits limits_;
+  inflater inflater_;
+  signature_scanner scanner_;
+
+  uint64_t total_{ 0 };
+  size_t entries_{ 0 };
+
+  check_status inspect_data( const uint8_t * data, size_t size, unsigned depth ) {
+    if( archive_details::is_zip( data, size ) )
+      return inspect_zip( data, size, depth );
+
+    if( archive_details::is_gzip( data, size ) )
+      return inspect_entry( size, depth, [&]( auto & sink ) {
+          return gunzip( data, size, inflater_, sink );
+        } );
+
+    scanner_.reset();
+    scanner_.feed( reinterpret_cast< const char * >( data ), size );
+    return scanner_.status();
+  }
+
+  check_status inspect_zip( const uint8_t * data, size_t size, unsigned depth ) {
+    using namespace archive_details;
+
+    const size_t eocd_size = 22;
+    const size_t max_comment = 0xffff;
+
+    // Оглавление находится по записи "end of central directory", которая
+    // расположена в конце файла перед необязательным комментарием.
+    const uint8_t * eocd = nullptr;
+    if( size >= eocd_size )
+      for( size_t pos = size - eocd_size;; --pos ) {
+        if( 0x06054b50 == get32( data + pos ) ) {
+          eocd = data + pos;
+          break;
+        }
+        if( !pos || size - eocd_size - pos == max_comment )
+          break;
+      }
+    if( !eocd )
+      return check_status::suspicious;
+
+    const size_t count = get16( eocd + 10 );
+    const size_t directory_size = get32( eocd + 12 );
+    const size_t directory = get32( eocd + 16 );
+    // Метка zip64.
+    if( 0xffff == count || 0xffffffff == directory )
+      return check_status::suspicious;
+    if( directory > size || size - directory < directory_size )
+      return check_status::suspicious;
+
+    auto status = check_status::safe;
+    size_t pos = directory;
+    for( size_t i = 0; i != count; ++i ) {
+      if( ++entries_ > limits_.max_entries_ )
+        return check_status::dangerous;
+
+      if( size - pos < 46 || 0x02014b50 != get32( data + pos ) )
+        return max( status, check_status::suspicious );
+      const uint8_t * entry = data + pos;
+      pos += 46 + get16( entry + 28 ) + get16( entry + 30 ) + get16( entry + 32 );
+      if( pos > size )
+        return max( status, check_status::suspicious );
+
+      const auto flags = get16( entry + 8 );
+      const auto method = get16( entry + 10 );
+      const size_t packed = get32( entry + 20 );
+      const size_t local = get32( entry + 42 );
+
+      // Зашифрованные элементы проверить невозможно.
+      if( (flags & 1) || (0 != method && 8 != method) ||
+          local > size || size - local < 30 ||
+          0x04034b50 != get32( data + local ) ) {
+        status = max( status, check_status::suspicious );
+        continue;
+      }
+
+      const size_t offset = local + 30 +
+          get16( data + local + 26 ) + get16( data + local + 28 );
+      if( offset > size || size - offset < packed ) {
+        status = max( status, check_status::suspicious );
+        continue;
+      }
+
+      const uint8_t * packed_data = data + offset;
+      if( 8 == method )
+        status = max( status, inspect_entry( packed, depth,
+            [&]( auto & sink ) {
+              return inflater_.inflate( packed_data, packed, sink );
+            } ) );
+      else
+        status = max( status, inspect_entry( packed, depth,
+            [&]( auto & sink ) {
+              return sink( reinterpret_cast< const char * >( packed_data ), packed ) ?
+                  inflate_status::done : inflate_status::stopped;
+            } ) );
+
+      if( check_status::dangerous == status )
+        break;
+    }
+
+    return status;
+  }
+
+  // Проверка одного распаковываемого элемента. unpack( sink ) выполняет
+  // распаковку, передавая данные в sink по мере их появления.
+  template< typename Unpack >
+  check_status inspect_entry( size_t packed, unsigned depth, Unpack && unpack ) {
+    uint64_t unpacked = 0;
+    auto verdict = check_status::safe;
+    bool started = false;
+    bool nested = false;
+    string buffer;
+    scoped_memory_charge buffer_memory{ global_memory_budget() };
+
+    scanner_.reset();
+    auto sink = [&]( const char * data, size_t size ) {
+      unpacked += size;
+      total_ += size;
+      if( total_ > limits_.max_total_bytes_ ||
+          (unpacked > limits_.ratio_min_bytes_ &&
+              unpacked / max< uint64_t >( packed, 1 ) > limits_.max_ratio_) ) {
+        verdict = check_status::dangerous;
+        return false;
+      }
+
+      if( !started ) {
+        started = true;
+        nested = archive_details::is_zip( data, size ) ||
+            archive_details::is_gzip( data, size );
+        if( nested && depth == limits_.max_depth_ ) {
+          verdict = check_status::dangerous;
+          return false;
+        }
+      }
+
+      if( !nested ) {
+        scanner_.feed( data, size );
+        return true;
+      }
+
+      if( buffer.size() + size > limits_.max_nested_bytes_ ) {
+        verdict = check_status::suspicious;
+        return false;
+      }
+      buffer.append( data, size );
+      buffer_memory.charge( size );
+      return true;
+    };
+
+    const auto r = unpack( sink );
+    if( inflate_status::stopped == r )
+      return verdict;
+    if( inflate_status::corrupt == r )
+      return check_status::suspicious;
+
+    if( nested )
+      return inspect_data( reinterpret_cast< const uint8_t * >( buffer.data() ),
+          buffer.size(), depth + 1 );
+
+    return scanner_.status();
+  }
+};
+
+// У каждой рабочей нити свой объект для проверки вложений, чтобы буфер
+// inflater-а не создавался заново для каждого email-а.
+archive_inspector & local_archive_inspector() {
+  thread_local archive_inspector inspector;
+  return inspector;
+}
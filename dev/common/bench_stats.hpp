@@ -0,0 +1,126 @@
+#pragma once
+
+#include <common/messages.hpp>
+#include <common/allocation_counter.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+#if !defined(_WIN32)
+  #include <sys/resource.h>
+#endif
+
+//
+// Показатели для сравнения архитектур v1-v7 на одинаковой нагрузке.
+//
+// Если задана переменная окружения EMAIL_BENCH_REQUESTS, то
+// requests_initiator отсылает указанное количество запросов (вместо
+// количества, заданного в самом примере) и по завершении выводит
+// в cerr одну строку вида
+//
+//   bench: emails=500 seconds=12.3 throughput=40.6 p50_ms=... ...
+//
+// которую затем собирает в общую таблицу dev/bench.rb.
+//
+// Выделения памяти на один email выводятся только при сборке примеров
+// с EMAIL_COUNT_ALLOCATIONS (см. allocation_counter.hpp): замена
+// operator new нужна лишь для замеров и в обычную сборку не попадает.
+// Переключения контекста и пиковый объем памяти берутся из getrusage()
+// (на Windows не выводятся).
+//
+
+// Количество запросов из EMAIL_BENCH_REQUESTS или 0, если переменная
+// не задана.
+size_t bench_requests_from_env() {
+  const char * v = getenv( "EMAIL_BENCH_REQUESTS" );
+  return v ? static_cast< size_t >( strtoull( v, nullptr, 10 ) ) : 0;
+}
+
+class bench_stats {
+  using clock = chrono::steady_clock;
+
+  // Момент отсылки запроса. Таблица с открытой адресацией создается
+  // сразу на все запросы, чтобы сам замер не выделял память по ходу
+  // работы.
+  struct sent_request {
+    uint64_t id_;
+    clock::time_point at_;
+  };
+
+public :
+  explicit bench_stats( size_t total_requests )
+    : sent_( total_requests * 2 + 1, sent_request{ 0, clock::time_point{} } )
+  {
+    latencies_.reserve( total_requests );
+    started_at_ = clock::now();
+    allocations_at_start_ = allocation_counter().load( memory_order_relaxed );
+  }
+
+  void on_sent( email_id_t id ) {
+    size_t i = slot( id );
+    while( sent_[ i ].id_ )
+      i = (i + 1) % sent_.size();
+    sent_[ i ] = sent_request{ id.value(), clock::now() };
+  }
+
+  void on_result( email_id_t id ) {
+    for( size_t i = slot( id ); sent_[ i ].id_; i = (i + 1) % sent_.size() )
+      if( sent_[ i ].id_ == id.value() ) {
+        latencies_.push_back( clock::now() - sent_[ i ].at_ );
+        break;
+      }
+  }
+
+  void report( ostream & to ) {
+    const chrono::duration< double > elapsed = clock::now() - started_at_;
+    const auto allocations =
+        allocation_counter().load( memory_order_relaxed ) - allocations_at_start_;
+    const auto emails = latencies_.size();
+
+    sort( latencies_.begin(), latencies_.end() );
+    const auto percentile = [&]( double p ) {
+      if( latencies_.empty() )
+        return 0.0;
+      const auto i = min( latencies_.size() - 1,
+          static_cast< size_t >( p * static_cast< double >( latencies_.size() ) ) );
+      return chrono::duration< double, milli >( latencies_[ i ] ).count();
+    };
+
+    char line[ 512 ];
+    snprintf( line, sizeof(line),
+        "bench: emails=%zu seconds=%.3f throughput=%.1f"
+        " p50_ms=%.1f p90_ms=%.1f p99_ms=%.1f max_ms=%.1f",
+        emails, elapsed.count(),
+        static_cast< double >( emails ) / elapsed.count(),
+        percentile( 0.5 ), percentile( 0.9 ), percentile( 0.99 ), percentile( 1.0 ) );
+    to << line;
+
+    if( allocation_counting_enabled() ) {
+      snprintf( line, sizeof(line), " allocs_per_email=%.1f",
+          emails ? static_cast< double >( allocations ) / static_cast< double >( emails ) : 0.0 );
+      to << line;
+    }
+
+#if !defined(_WIN32)
+    rusage usage{};
+    getrusage( RUSAGE_SELF, &usage );
+    to << " peak_rss_kib=" << usage.ru_maxrss
+        << " voluntary_csw=" << usage.ru_nvcsw
+        << " involuntary_csw=" << usage.ru_nivcsw;
+#endif
+
+    to << endl;
+  }
+
+private :
+  vector< sent_request > sent_;
+  vector< clock::duration > latencies_;
+  clock::time_point started_at_;
+  size_t allocations_at_start_;
+
+  size_t slot( email_id_t id ) const {
+    return static_cast< size_t >(
+        (id.value() * 0x9e3779b97f4a7c15ULL) >> 11 ) % sent_.size();
+  }
+};
@@ -0,0 +1,365 @@
+#pragma once
+
+#include <common/mail_source.hpp>
+#include <common/mbox_splitter.hpp>
+#include <common/inflate.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(EMAIL_WITH_ZSTD)
+  #include <zstd.h>
+#endif
+
+//
+// Чтение сжатых mbox-файлов (.mbox.gz и .mbox.zst) без распаковки
+// во временные файлы.
+//
+// Распакованный поток нарезается на сегменты примерно по segment_size
+// байт так, чтобы каждое письмо целиком находилось в одном сегменте
+// (сегмент заканчивается перед строкой "From "). Каждый сегмент
+// разбивается на письма и отдается потребителю сразу же, как только
+// он готов, поэтому проверка писем начинается задолго до конца
+// распаковки. Потребитель сам решает, сколько сегментов может
+// одновременно находиться в памяти (см. segment_credits).
+//
+// gzip и обычный zstd-файл из одного фрейма (так пишет и zstd -T0)
+// распаковываются последовательно на той нити, которая читает файл:
+// распакованные данные небольшими частями сразу же отдаются в нарезку
+// на сегменты, поэтому в памяти никогда не оказывается весь файл.
+// zstd-файл из нескольких фреймов (например, сжатый pzstd)
+// распаковывается параллельно: фреймы независимы, поэтому каждая
+// из рабочих нитей распаковывает свой фрейм целиком, а результаты
+// собираются в исходном порядке. Поддержка zstd требует libzstd и
+// включается макросом EMAIL_WITH_ZSTD.
+//
+
+enum class mbox_compression { none, gzip, zstd };
+
+// Формат определяется по сигнатуре в начале файла, а не по расширению.
+mbox_compression detect_mbox_compression( const char * data, std::size_t size ) {
+  const auto * p = reinterpret_cast< const unsigned char * >( data );
+  if( size >= 2 && 0x1f == p[ 0 ] && 0x8b == p[ 1 ] )
+    return mbox_compression::gzip;
+  if( size >= 4 && 0x28 == p[ 0 ] && 0xb5 == p[ 1 ] && 0x2f == p[ 2 ] && 0xfd == p[ 3 ] )
+    return mbox_compression::zstd;
+  return mbox_compression::none;
+}
+
+// Распакованная часть mbox-а, которая содержит только целые письма.
+struct mbox_segment {
+  std::shared_ptr< const memory_mail_source > source_;
+  std::vector< mbox_message_t > messages_;
+};
+
+// Получатель сегментов. Если он возвращает false, то чтение прекращается.
+using mbox_segment_consumer = std::function< bool( mbox_segment ) >;
+
+//
+// Нарезка распакованного потока на сегменты.
+//
+class mbox_segmenter {
+public :
+  mbox_segmenter( std::size_t segment_size, mbox_segment_consumer consumer )
+    : segment_size_( segment_size )
+    , consumer_( std::move(consumer) )
+    , next_cut_at_( segment_size )
+  {}
+
+  bool feed( const char * data, std::size_t size ) {
+    buffer_.append( data, size );
+    if( buffer_.size() < next_cut_at_ )
+      return true;
+
+    // Сегмент заканчивается перед последней строкой "From ". Если ее нет
+    // (одно письмо больше сегмента), то сегмент продолжает расти.
+    const auto separator = buffer_.rfind( "\nFrom " );
+    if( std::string::npos == separator ) {
+      next_cut_at_ = buffer_.size() + segment_size_;
+      return true;
+    }
+
+    const auto cut = separator + 1;
+    std::string rest( buffer_, cut );
+    buffer_.resize( cut );
+    std::swap( buffer_, rest );
+    next_cut_at_ = std::max( segment_size_, buffer_.size() + segment_size_ / 2 );
+    return emit( std::move(rest) );
+  }
+
+  bool finish() {
+    if( buffer_.empty() )
+      return true;
+    return emit( std::move(buffer_) );
+  }
+
+private :
+  const std::size_t segment_size_;
+  const mbox_segment_consumer consumer_;
+
+  std::string buffer_;
+  // При каком размере буфера нужно искать место для разреза.
+  std::size_t next_cut_at_;
+
+  bool emit( std::string data ) {
+    mbox_segment segment;
+    segment.source_ = std::make_shared< memory_mail_source >( std::move(data) );
+    // Сегмент небольшой и разбивается текущей нитью.
+    segment.messages_ = split_mbox(
+        segment.source_->data(), segment.source_->size(), 1 );
+    return consumer_( std::move(segment) );
+  }
+};
+
+//
+// Ограничение количества сегментов, которые находятся в памяти.
+//
+// Читающая нить берет разрешение перед тем, как отдать очередной сегмент,
+// а потребитель возвращает его, когда сегмент больше не нужен. close()
+// прерывает ожидание, и после него разрешения больше не выдаются.
+//
+class segment_credits {
+public :
+  explicit segment_credits( std::size_t credits ) : credits_( credits ) {}
+
+  bool acquire() {
+    std::unique_lock< std::mutex > lock{ lock_ };
+    cv_.wait( lock, [this]{ return closed_ || credits_; } );
+    if( closed_ )
+      return false;
+    --credits_;
+    return true;
+  }
+
+  void release() {
+    {
+      std::lock_guard< std::mutex > lock{ lock_ };
+      ++credits_;
+    }
+    cv_.notify_one();
+  }
+
+  void close() {
+    {
+      std::lock_guard< std::mutex > lock{ lock_ };
+      closed_ = true;
+    }
+    cv_.notify_all();
+  }
+
+private :
+  std::mutex lock_;
+  std::condition_variable cv_;
+  std::size_t credits_;
+  bool closed_{ false };
+};
+
+namespace compressed_mbox_details {
+
+inline void read_gzip( const char * data, std::size_t size, mbox_segmenter & segmenter ) {
+  bool stopped = false;
+  inflater inf;
+  const auto r = gunzip( data, size, inf, [&]( const char * d, std::size_t n ) {
+      stopped = !segmenter.feed( d, n );
+      return !stopped;
+    } );
+
+  if( inflate_status::corrupt == r )
+    throw std::runtime_error( "corrupted gzip stream" );
+  if( !stopped )
+    segmenter.finish();
+}
+
+#if defined(EMAIL_WITH_ZSTD)
+
+using zstd_context = std::unique_ptr< ZSTD_DCtx, decltype(&ZSTD_freeDCtx) >;
+
+inline zstd_context make_zstd_context() {
+  return zstd_context{ ZSTD_createDCtx(), &ZSTD_freeDCtx };
+}
+
+// Потоковая распаковка одного или нескольких идущих подряд фреймов.
+// Распакованные данные отдаются в sink частями по ZSTD_DStreamOutSize()
+// байт. Если sink вернул false, то распаковка прекращается, и
+// возвращается false.
+template< typename SINK >
+bool decompress_zstd( ZSTD_DCtx * ctx, const char * data, std::size_t size, SINK && sink ) {
+  ZSTD_DCtx_reset( ctx, ZSTD_reset_session_only );
+  ZSTD_inBuffer in{ data, size, 0 };
+  std::vector< char > chunk( ZSTD_DStreamOutSize() );
+  for(;;) {
+    ZSTD_outBuffer o{ chunk.data(), chunk.size(), 0 };
+    const auto r = ZSTD_decompressStream( ctx, &o, &in );
+    if( ZSTD_isError( r ) )
+      throw std::runtime_error( std::string( "corrupted zstd stream: " ) +
+          ZSTD_getErrorName( r ) );
+    if( o.pos && !sink( chunk.data(), o.pos ) )
+      return false;
+
+    // 0 означает, что очередной фрейм распакован полностью.
+    if( !r && in.pos == in.size )
+      return true;
+    if( in.pos == in.size && o.pos < o.size )
+      throw std::runtime_error( "truncated zstd frame" );
+  }
+}
+
+// Распаковка одного фрейма целиком (для параллельной распаковки).
+inline std::string decompress_zstd_frame(
+  ZSTD_DCtx * ctx,
+  const char * data,
+  std::size_t size )
+{
+  std::string out;
+  const auto content = ZSTD_getFrameContentSize( data, size );
+  if( ZSTD_CONTENTSIZE_ERROR != content && ZSTD_CONTENTSIZE_UNKNOWN != content )
+    out.reserve( static_cast< std::size_t >( content ) );
+
+  decompress_zstd( ctx, data, size, [&]( const char * d, std::size_t n ) {
+      out.append( d, n );
+      return true;
+    } );
+  return out;
+}
+
+// Несколько фреймов распаковываются параллельно, но не дальше window
+// фреймов от того, который сейчас отдается сегментатору.
+inline void read_zstd( const char * data, std::size_t size, mbox_segmenter & segmenter ) {
+  std::vector< std::pair< std::size_t, std::size_t > > frames;
+  for( std::size_t offset = 0; offset != size; ) {
+    const auto frame = ZSTD_findFrameCompressedSize( data + offset, size - offset );
+    if( ZSTD_isError( frame ) )
+      throw std::runtime_error( "corrupted zstd frame" );
+    frames.emplace_back( offset, frame );
+    offset += frame;
+  }
+
+  const std::size_t workers_count = std::max< std::size_t >( 1, std::min< std::size_t >(
+      std::thread::hardware_concurrency(), frames.size() ) );
+
+  // Один фрейм (или одна нить) -- распаковка потоком, без
+  // промежуточных копий фреймов.
+  if( 1 == workers_count ) {
+    const auto ctx = make_zstd_context();
+    const bool completed = decompress_zstd( ctx.get(), data, size,
+        [&]( const char * d, std::size_t n ) { return segmenter.feed( d, n ); } );
+    if( completed )
+      segmenter.finish();
+    return;
+  }
+
+  const std::size_t window = 2 * workers_count;
+
+  std::mutex lock;
+  std::condition_variable cv;
+  std::map< std::size_t, std::string > ready;
+  std::size_t next = 0;
+  std::size_t consumed = 0;
+  bool stop = false;
+  std::string error;
+
+  std::vector< std::thread > workers;
+  for( std::size_t w = 0; w != workers_count; ++w )
+    workers.emplace_back( [&] {
+      const auto ctx = make_zstd_context();
+      std::unique_lock< std::mutex > l{ lock };
+      for(;;) {
+        cv.wait( l, [&]{ return stop || next == frames.size() || next < consumed + window; } );
+        if( stop || next == frames.size() )
+          return;
+
+        const auto i = next++;
+        l.unlock();
+        std::string out;
+        std::string failure;
+        try {
+          out = decompress_zstd_frame( ctx.get(),
+              data + frames[ i ].first, frames[ i ].second );
+        }
+        catch( const std::exception & x ) {
+          failure = x.what();
+        }
+        l.lock();
+
+        if( !failure.empty() ) {
+          error = failure;
+          stop = true;
+        }
+        else
+          ready.emplace( i, std::move(out) );
+        cv.notify_all();
+      }
+    } );
+
+  bool stopped = false;
+  for( std::size_t i = 0; i != frames.size() && !stopped; ++i ) {
+    std::string out;
+    {
+      std::unique_lock< std::mutex > l{ lock };
+      cv.wait( l, [&]{ return stop || ready.count( i ); } );
+      if( stop )
+        break;
+      out = std::move( ready[ i ] );
+      ready.erase( i );
+      consumed = i + 1;
+    }
+    cv.notify_all();
+
+    stopped = !segmenter.feed( out.data(), out.size() );
+  }
+
+  {
+    std::lock_guard< std::mutex > l{ lock };
+    stopped = stopped || stop;
+    stop = true;
+  }
+  cv.notify_all();
+  for( auto & w : workers )
+    w.join();
+
+  if( !error.empty() )
+    throw std::runtime_error( error );
+  if( !stopped )
+    segmenter.finish();
+}
+
+#endif
+
+} /* namespace compressed_mbox_details */
+
+// Чтение сжатого mbox-а. Выполняется на нити, которая его вызвала,
+// и заканчивается, когда файл прочитан целиком или consumer вернул false.
+void read_compressed_mbox(
+  const std::string & file_name,
+  std::size_t segment_size,
+  mbox_segment_consumer consumer )
+{
+  const mapped_file file( file_name, file_access::sequential );
+  mbox_segmenter segmenter( segment_size, std::move(consumer) );
+
+  switch( detect_mbox_compression( file.data(), file.size() ) ) {
+    case mbox_compression::gzip:
+      compressed_mbox_details::read_gzip( file.data(), file.size(), segmenter );
+      break;
+
+    case mbox_compression::zstd:
+#if defined(EMAIL_WITH_ZSTD)
+      compressed_mbox_details::read_zstd( file.data(), file.size(), segmenter );
+      break;
+#else
+      throw std::runtime_error( file_name +
+          ": zstd support is not enabled (build with EMAIL_WITH_ZSTD)" );
+#endif
+
+    case mbox_compression::none:
+      throw std::runtime_error( file_name + " is not compressed" );
+  }
+}
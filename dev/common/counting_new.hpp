@@ -0,0 +1,30 @@
+#pragma once
+
+#include <common/allocation_counter.hpp>
+
+#include <cstdlib>
+#include <new>
+
+//
+// Замена глобального operator new, которая подсчитывает выделения
+// памяти (см. allocation_counter.hpp). В подсчет попадают и выделения
+// внутри SObjectizer.
+//
+// Замена определяется не inline, поэтому этот файл должен подключаться
+// ровно в одном .cpp-файле программы (в ее main.cpp).
+//
+
+void * operator new( std::size_t size ) {
+  allocation_counter().fetch_add( 1, std::memory_order_relaxed );
+  if( void * p = std::malloc( size ? size : 1 ) )
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete( void * p ) noexcept {
+  std::free( p );
+}
+
+void operator delete( void * p, std::size_t ) noexcept {
+  std::free( p );
+}
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <common/messages.hpp>
+#include <common/mapped_file.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+//
+// Компактное множество доменных имен для проверки репутации.
+//
+// Списки плохих доменов содержат десятки миллионов имен, и хранить их
+// в unordered_set< string > слишком дорого (десятки байт на имя плюс
+// само имя). Поэтому имена вообще не хранятся. Вместо этого строится
+// минимальная совершенная хэш-функция (по схеме hash-and-displace):
+// имена раскладываются по корзинам в среднем по 4 имени, и для каждой
+// корзины подбирается 16-битовое смещение, при котором все ее имена
+// попадают в свободные ячейки таблицы. В ячейке таблицы хранится
+// 32-битовый отпечаток имени, по которому отсекаются имена, которых
+// в множестве нет.
+//
+// Итого около 4.5 байт на имя, а поиск -- это два обращения к памяти
+// (смещение корзины и ячейка таблицы). Платой является вероятность
+// ложного совпадения около 2^-31 для имени, которого в множестве нет.
+//
+// Формат файла (числа в порядке байт текущей платформы):
+//
+//   "EDS1"                         сигнатура;
+//   uint32_t reserved              выравнивание;
+//   uint64_t seed                  параметр хэш-функции;
+//   uint64_t buckets               количество корзин;
+//   uint64_t slots                 количество ячеек;
+//   uint16_t pilots[ buckets ]     смещения корзин (дополняются до
+//                                  четного количества);
+//   uint32_t fingerprints[ slots ] отпечатки (0 -- свободная ячейка).
+//
+// Файл строится функцией build_domain_set() (см. domain_set_tool)
+// и при использовании отображается в память.
+//
+
+namespace domain_set_details {
+
+struct file_header {
+  char magic_[ 4 ];
+  uint32_t reserved_;
+  uint64_t seed_;
+  uint64_t buckets_;
+  uint64_t slots_;
+};
+
+inline uint64_t mix64( uint64_t v ) {
+  v ^= v >> 33;
+  v *= 0xff51afd7ed558ccdULL;
+  v ^= v >> 33;
+  v *= 0xc4ceb9fe1a85ec53ULL;
+  v ^= v >> 33;
+  return v;
+}
+
+inline uint64_t hash_name( const char * name, size_t size, uint64_t seed ) {
+  uint64_t h = 0xcbf29ce484222325ULL ^ seed;
+  for( size_t i = 0; i != size; ++i )
+    h = (h ^ static_cast< unsigned char >( name[ i ] )) * 0x100000001b3ULL;
+  return mix64( h );
+}
+
+// Все, что нужно знать об имени при построении и при поиске.
+struct key_hashes {
+  uint64_t bucket_;
+  uint64_t position_;
+  uint32_t fingerprint_;
+};
+
+inline key_hashes split_hash( uint64_t h, uint64_t buckets ) {
+  return key_hashes{
+      mix64( h ^ 0x9e3779b97f4a7c15ULL ) % buckets,
+      mix64( h ^ 0xbf58476d1ce4e5b9ULL ),
+      // Нулевой отпечаток обозначает свободную ячейку.
+      static_cast< uint32_t >( h >> 32 ) | 1u };
+}
+
+inline uint64_t slot_of( const key_hashes & k, uint16_t pilot, uint64_t slots ) {
+  return (k.position_ ^ mix64( pilot + 1 )) % slots;
+}
+
+inline size_t pilots_bytes( uint64_t buckets ) {
+  return static_cast< size_t >( (buckets + 1) / 2 * 2 ) * sizeof(uint16_t);
+}
+
+} /* namespace domain_set_details */
+
+class domain_set {
+public :
+  explicit domain_set( const string & file_name )
+    : file_( file_name, file_access::random )
+  {
+    using namespace domain_set_details;
+
+    if( file_.size() >= sizeof(file_header) )
+      memcpy( &header_, file_.data(), sizeof(header_) );
+    if( file_.size() < sizeof(file_header) ||
+        0 != memcmp( header_.magic_, "EDS1", 4 ) ||
+        !header_.buckets_ || !header_.slots_ ||
+        file_.size() < sizeof(file_header) + pilots_bytes( header_.buckets_ ) +
+            header_.slots_ * sizeof(uint32_t) )
+      throw runtime_error( "invalid domain set file: " + file_name );
+
+    pilots_ = reinterpret_cast< const uint16_t * >(
+        file_.data() + sizeof(file_header) );
+    fingerprints_ = reinterpret_cast< const uint32_t * >(
+        file_.data() + sizeof(file_header) + pilots_bytes( header_.buckets_ ) );
+  }
+
+  bool contains( const char * name, size_t size ) const {
+    using namespace domain_set_details;
+
+    const auto k = split_hash(
+        hash_name( name, size, header_.seed_ ), header_.buckets_ );
+    return k.fingerprint_ == fingerprints_[
+        slot_of( k, pilots_[ k.bucket_ ], header_.slots_ ) ];
+  }
+
+  // Есть ли в множестве сам хост или один из его родительских доменов
+  // (для "a.b.example.com" проверяются также "b.example.com" и
+  // "example.com", но не "com").
+  bool contains_domain_of( const char * host, size_t size ) const {
+    for(;;) {
+      if( contains( host, size ) )
+        return true;
+
+      const auto * dot = static_cast< const char * >( memchr( host, '.', size ) );
+      if( !dot )
+        return false;
+      const auto rest = size - static_cast< size_t >( dot + 1 - host );
+      if( !memchr( dot + 1, '.', rest ) )
+        return false;
+      host = dot + 1;
+      size = rest;
+    }
+  }
+
+private :
+  const mapped_file file_;
+  domain_set_details::file_header header_;
+  const uint16_t * pilots_;
+  const uint32_t * fingerprints_;
+};
+
+// Построение содержимого файла для domain_set. Имена должны быть уже
+// приведены к нижнему регистру. Повторы допускаются.
+string build_domain_set( const vector< string > & names ) {
+  using namespace domain_set_details;
+
+  const uint16_t max_pilot = 0xffff;
+
+  for( uint64_t seed = 1;; ++seed ) {
+    vector< uint64_t > hashes;
+    hashes.reserve( names.size() );
+    for( const auto & n : names )
+      hashes.push_back( hash_name( n.data(), n.size(), seed ) );
+    sort( hashes.begin(), hashes.end() );
+    hashes.erase( unique( hashes.begin(), hashes.end() ), hashes.end() );
+
+    const uint64_t n = hashes.size();
+    const uint64_t buckets = n / 4 + 1;
+    // Небольшой запас свободных ячеек сильно упрощает подбор смещений
+    // для последних корзин.
+    const uint64_t slots = n + n / 50 + 1;
+
+    // Корзины обрабатываются от самых больших к самым маленьким.
+    vector< key_hashes > keys;
+    keys.reserve( n );
+    for( auto h : hashes )
+      keys.push_back( split_hash( h, buckets ) );
+    sort( keys.begin(), keys.end(),
+        []( const key_hashes & a, const key_hashes & b ) {
+          return a.bucket_ < b.bucket_;
+        } );
+
+    vector< pair< size_t, size_t > > ranges; // [first, last) в keys.
+    for( size_t i = 0; i != keys.size(); ) {
+      size_t j = i;
+      while( j != keys.size() && keys[ j ].bucket_ == keys[ i ].bucket_ )
+        ++j;
+      ranges.emplace_back( i, j );
+      i = j;
+    }
+    stable_sort( ranges.begin(), ranges.end(),
+        []( const pair< size_t, size_t > & a, const pair< size_t, size_t > & b ) {
+          return (a.second - a.first) > (b.second - b.first);
+        } );
+
+    vector< uint16_t > pilots( static_cast< size_t >( (buckets + 1) / 2 * 2 ), 0 );
+    vector< uint32_t > fingerprints( static_cast< size_t >( slots ), 0 );
+    vector< uint64_t > taken;
+
+    bool failed = false;
+    for( const auto & r : ranges ) {
+      bool placed = false;
+      for( uint32_t pilot = 0; !placed && pilot <= max_pilot; ++pilot ) {
+        taken.clear();
+        placed = true;
+        for( size_t i = r.first; placed && i != r.second; ++i ) {
+          const auto s = slot_of( keys[ i ], static_cast< uint16_t >( pilot ), slots );
+          placed = !fingerprints[ s ] &&
+              find( taken.begin(), taken.end(), s ) == taken.end();
+          taken.push_back( s );
+        }
+
+        if( placed ) {
+          pilots[ keys[ r.first ].bucket_ ] = static_cast< uint16_t >( pilot );
+          for( size_t i = r.first; i != r.second; ++i )
+            fingerprints[ taken[ i - r.first ] ] = keys[ i ].fingerprint_;
+        }
+      }
+      if( !placed ) {
+        failed = true;
+        break;
+      }
+    }
+    if( failed )
+      // Попробуем другую хэш-функцию.
+      continue;
+
+    const file_header header{ { 'E', 'D', 'S', '1' }, 0, seed, buckets, slots };
+    string r;
+    r.append( reinterpret_cast< const char * >( &header ), sizeof(header) );
+    r.append( reinterpret_cast< const char * >( pilots.data() ),
+        pilots.size() * sizeof(uint16_t) );
+    r.append( reinterpret_cast< const char * >( fingerprints.data() ),
+        fingerprints.size() * sizeof(uint32_t) );
+    return r;
+  }
+}
+
+// Множество плохих доменов из файла, указанного в переменной окружения
+// EMAIL_BAD_DOMAINS. Если переменная не задана, то возвращается nullptr.
+const domain_set * global_bad_domains() {
+  static const unique_ptr< domain_set > domains = []{
+    const char * path = getenv( "EMAIL_BAD_DOMAINS" );
+    return path ? make_unique< domain_set >( path ) : unique_ptr< domain_set >{};
+  }();
+  return domains.get();
+}
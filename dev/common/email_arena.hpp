@@ -0,0 +1,412 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <common/memory_budget.hpp>
+
+//
+// Арена для всех данных, относящихся к одному email-у.
+//
+// Память выделяется из крупных блоков простым сдвигом указателя
+// и никогда не освобождается поштучно. Вместо этого вся арена целиком
+// очищается после того, как обработка email-а завершена. Освобожденные
+// арены не возвращаются в кучу, а возвращаются в пул той нити, которая
+// их создала, и используются повторно для следующих email-ов.
+//
+// Время жизни арены контролируется счетчиком ссылок: арену разделяют
+// между собой загрузчик, разобранный email и checker-ы, а вернуть ее
+// в пул должен тот, кто последним отпустит ссылку. Обычно это другая
+// нить (арена берется на нити IO-агента, а отпускается на нити
+// анализатора или checker-а), поэтому возврат в чужой пул выполняется
+// без блокировок (см. email_arena_pool).
+//
+// Если к арене привязан учет памяти email-а (см. memory_budget.hpp), то
+// каждый новый блок учитывается в бюджете. Первый блок остается у арены
+// и между email-ами, поэтому в бюджете не учитывается.
+//
+class email_arena_pool;
+
+class email_arena {
+  friend class email_arena_ref;
+  friend class email_arena_pool;
+
+  struct block_header {
+    block_header * next_;
+    std::size_t size_;
+  };
+
+public :
+  static constexpr std::size_t initial_block_size = 16 * 1024;
+
+  email_arena() {
+    add_block( initial_block_size );
+  }
+  ~email_arena() {
+    release_blocks( nullptr );
+  }
+
+  email_arena( const email_arena & ) = delete;
+  email_arena & operator=( const email_arena & ) = delete;
+
+  void * allocate( std::size_t size, std::size_t align ) {
+    auto p = align_up( current_, align );
+    if( p + size > end_ ) {
+      add_block( std::max( size + align, blocks_->size_ * 2 ) );
+      p = align_up( current_, align );
+    }
+    current_ = p + size;
+    return p;
+  }
+
+  // Создание объекта внутри арены. Деструктор такого объекта
+  // вызываться не будет, поэтому все его данные также должны
+  // располагаться в арене.
+  template< typename T, typename... Args >
+  T * create( Args &&... args ) {
+    return new( allocate( sizeof(T), alignof(T) ) ) T( std::forward<Args>(args)... );
+  }
+
+  // Учет всех последующих блоков в памяти email-а.
+  void charge_to( memory_ticket ticket ) {
+    reservation_ = std::move(ticket);
+  }
+
+  // Возврат арены в исходное состояние. Сохраняется только самый
+  // первый блок, все остальные возвращаются в кучу.
+  void reset() {
+    reservation_.reset();
+
+    block_header * first = blocks_;
+    while( first->next_ )
+      first = first->next_;
+    release_blocks( first );
+
+    blocks_ = first;
+    current_ = reinterpret_cast< char * >( first + 1 );
+    end_ = reinterpret_cast< char * >( first ) + first->size_;
+  }
+
+private :
+  block_header * blocks_{ nullptr };
+  char * current_{ nullptr };
+  char * end_{ nullptr };
+
+  std::atomic< unsigned > references_{ 0 };
+
+  memory_ticket reservation_;
+
+  // Пул, в который арена возвращается, и следующая арена в списке
+  // возвращенных в этот пул.
+  email_arena_pool * home_{ nullptr };
+  email_arena * next_returned_{ nullptr };
+
+  static char * align_up( char * p, std::size_t align ) {
+    const auto v = reinterpret_cast< std::uintptr_t >( p );
+    return reinterpret_cast< char * >( (v + align - 1) & ~(align - 1) );
+  }
+
+  void add_block( std::size_t payload ) {
+    const auto size = sizeof(block_header) + payload;
+    auto * b = static_cast< block_header * >( ::operator new( size ) );
+    if( reservation_ )
+      reservation_->charge( size );
+
+    b->next_ = blocks_;
+    b->size_ = size;
+    blocks_ = b;
+    current_ = reinterpret_cast< char * >( b + 1 );
+    end_ = reinterpret_cast< char * >( b ) + size;
+  }
+
+  void release_blocks( block_header * keep ) {
+    while( blocks_ && blocks_ != keep ) {
+      auto * next = blocks_->next_;
+      ::operator delete( blocks_ );
+      blocks_ = next;
+    }
+  }
+};
+
+//
+// Пул свободных арен, у каждой нити свой.
+//
+// Арену из пула может отпустить любая нить. Своя нить кладет ее прямо
+// в список свободных, а чужая -- в стек возвращенных арен (без
+// блокировок), который нить-владелец забирает целиком, когда у нее
+// заканчиваются свободные арены.
+//
+// Пул живет, пока жива его нить или хотя бы одна из его арен: при
+// завершении нити пул становится ничьим, и арены, которые вернутся
+// в него позже, удаляются.
+//
+class email_arena_pool {
+public :
+  // Арены из пула нити IO-агента одновременно находятся у многих
+  // анализаторов и возвращаются пачками, поэтому запас нужен большой.
+  static constexpr std::size_t max_cached = 128;
+
+  email_arena_pool() {
+    free_.reserve( max_cached );
+  }
+
+  email_arena_pool( const email_arena_pool & ) = delete;
+  email_arena_pool & operator=( const email_arena_pool & ) = delete;
+
+  // Вызывается только нитью-владельцем.
+  email_arena * acquire() {
+    if( free_.empty() )
+      take_returned();
+    if( free_.empty() ) {
+      references_.fetch_add( 1, std::memory_order_relaxed );
+      auto * a = new email_arena();
+      a->home_ = this;
+      return a;
+    }
+
+    auto * a = free_.back();
+    free_.pop_back();
+    return a;
+  }
+
+  // Может вызываться любой нитью.
+  void release( email_arena * a, bool own_thread ) {
+    a->reset();
+    if( own_thread ) {
+      if( free_.size() < max_cached )
+        free_.push_back( a );
+      else
+        destroy_owned( a );
+      return;
+    }
+
+    auto * head = returned_.load( std::memory_order_relaxed );
+    do
+      a->next_returned_ = head;
+    while( !returned_.compare_exchange_weak( head, a,
+        std::memory_order_release, std::memory_order_relaxed ) );
+
+    // Если нить-владелец уже завершилась, то забирать арену некому.
+    // Владелец выставляет признак до того, как забирает стек в
+    // последний раз, поэтому арена не останется в стеке навсегда.
+    if( orphaned_.load( std::memory_order_seq_cst ) )
+      destroy_list( returned_.exchange( nullptr, std::memory_order_acquire ) );
+  }
+
+  // Завершение нити-владельца.
+  void orphan() {
+    orphaned_.store( true, std::memory_order_seq_cst );
+    for( auto * a : free_ )
+      destroy_owned( a );
+    free_.clear();
+    destroy_list( returned_.exchange( nullptr, std::memory_order_acquire ) );
+    unref();
+  }
+
+private :
+  // Только для нити-владельца.
+  std::vector< email_arena * > free_;
+  // Арены, которые вернули другие нити.
+  std::atomic< email_arena * > returned_{ nullptr };
+  std::atomic< bool > orphaned_{ false };
+  // Одна ссылка у нити-владельца и по одной у каждой арены пула.
+  std::atomic< std::size_t > references_{ 1 };
+
+  void take_returned() {
+    auto * a = returned_.exchange( nullptr, std::memory_order_acquire );
+    while( a ) {
+      auto * next = a->next_returned_;
+      if( free_.size() < max_cached )
+        free_.push_back( a );
+      else
+        destroy_owned( a );
+      a = next;
+    }
+  }
+
+  void destroy_list( email_arena * a ) {
+    while( a ) {
+      auto * next = a->next_returned_;
+      destroy( a );
+      a = next;
+    }
+  }
+
+  void destroy( email_arena * a ) {
+    delete a;
+    unref();
+  }
+
+  // Удаление арены нитью-владельцем. Ссылка нити еще жива, поэтому
+  // пул при этом удалиться не может.
+  void destroy_owned( email_arena * a ) {
+    delete a;
+    references_.fetch_sub( 1, std::memory_order_relaxed );
+  }
+
+  void unref() {
+    if( 1 == references_.fetch_sub( 1, std::memory_order_acq_rel ) )
+      delete this;
+  }
+};
+
+namespace email_arena_details {
+
+// Пул текущей нити, если он уже создан.
+inline email_arena_pool *& current_pool() {
+  thread_local email_arena_pool * pool = nullptr;
+  return pool;
+}
+
+// Пул создается при первом обращении и становится ничьим при
+// завершении нити.
+struct thread_pool_holder {
+  email_arena_pool * pool_{ new email_arena_pool() };
+  ~thread_pool_holder() {
+    // Арены, которые будут отпущены после этого, вернутся в пул
+    // как в чужой и будут удалены.
+    current_pool() = nullptr;
+    pool_->orphan();
+  }
+};
+
+} /* namespace email_arena_details */
+
+email_arena_pool & local_email_arena_pool() {
+  thread_local email_arena_details::thread_pool_holder holder;
+  email_arena_details::current_pool() = holder.pool_;
+  return *holder.pool_;
+}
+
+//
+// Ссылка на арену со счетчиком ссылок.
+//
+// Арена возвращается в пул той нити, которая ее создала, независимо от
+// того, на какой нити была отпущена последняя ссылка.
+//
+class email_arena_ref {
+public :
+  email_arena_ref() = default;
+  explicit email_arena_ref( email_arena * arena ) : arena_( arena ) {
+    take();
+  }
+  email_arena_ref( const email_arena_ref & o ) : arena_( o.arena_ ) {
+    take();
+  }
+  email_arena_ref( email_arena_ref && o ) noexcept : arena_( o.arena_ ) {
+    o.arena_ = nullptr;
+  }
+  ~email_arena_ref() {
+    drop();
+  }
+
+  email_arena_ref & operator=( email_arena_ref o ) {
+    std::swap( arena_, o.arena_ );
+    return *this;
+  }
+
+  email_arena * get() const { return arena_; }
+  email_arena & operator*() const { return *arena_; }
+  email_arena * operator->() const { return arena_; }
+  explicit operator bool() const { return nullptr != arena_; }
+
+private :
+  email_arena * arena_{ nullptr };
+
+  void take() {
+    if( arena_ )
+      arena_->references_.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  void drop() {
+    if( arena_ &&
+        1 == arena_->references_.fetch_sub( 1, std::memory_order_acq_rel ) )
+      arena_->home_->release( arena_,
+          arena_->home_ == email_arena_details::current_pool() );
+  }
+};
+
+// Получить пустую арену для очередного email-а.
+email_arena_ref acquire_email_arena() {
+  return email_arena_ref{ local_email_arena_pool().acquire() };
+}
+
+//
+// Аллокатор для стандартных контейнеров, который берет память из арены.
+//
+template< typename T >
+class arena_allocator {
+  template< typename U > friend class arena_allocator;
+
+public :
+  using value_type = T;
+
+  explicit arena_allocator( email_arena & arena ) : arena_( &arena ) {}
+  template< typename U >
+  arena_allocator( const arena_allocator< U > & o ) : arena_( o.arena_ ) {}
+
+  T * allocate( std::size_t n ) {
+    return static_cast< T * >( arena_->allocate( n * sizeof(T), alignof(T) ) );
+  }
+  // Память освобождается только всей ареной сразу.
+  void deallocate( T *, std::size_t ) {}
+
+  template< typename U >
+  bool operator==( const arena_allocator< U > & o ) const { return arena_ == o.arena_; }
+  template< typename U >
+  bool operator!=( const arena_allocator< U > & o ) const { return arena_ != o.arena_; }
+
+private :
+  email_arena * arena_;
+};
+
+//
+// Содержимое загруженного email-а, размещенное в арене.
+//
+class email_content {
+public :
+  email_content() = default;
+  email_content( email_arena_ref arena, const char * data, std::size_t size )
+    : arena_( std::move(arena) ), size_( size )
+  {
+    if( size_ ) {
+      auto * p = static_cast< char * >( arena_->allocate( size_, 1 ) );
+      std::memcpy( p, data, size_ );
+      data_ = p;
+    }
+  }
+
+  // Содержимое, которое не копируется в арену, а остается там, где
+  // уже находится (например, в отображенном в память файле).
+  // Хранилище будет жить, пока жив owner.
+  static email_content borrow(
+    email_arena_ref arena,
+    std::shared_ptr< const void > owner,
+    const char * data,
+    std::size_t size )
+  {
+    email_content r;
+    r.arena_ = std::move(arena);
+    r.owner_ = std::move(owner);
+    r.data_ = data;
+    r.size_ = size;
+    return r;
+  }
+
+  const email_arena_ref & arena() const { return arena_; }
+  const char * data() const { return data_; }
+  std::size_t size() const { return size_; }
+
+private :
+  email_arena_ref arena_;
+  std::shared_ptr< const void > owner_;
+  const char * data_{ "" };
+  std::size_t size_{ 0 };
+};
@@ -0,0 +1,243 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+//
+// Компактный идентификатор email-а.
+//
+// Вместо того, чтобы копировать имя файла в каждое сообщение, имя один
+// раз помещается в таблицу интернирования, а дальше по конвейеру
+// передается только 64-битовый идентификатор. Само имя извлекается
+// из таблицы лишь на "краях" конвейера: при загрузке содержимого и
+// при выводе результатов.
+//
+class email_id_t {
+public :
+  email_id_t() = default;
+  explicit constexpr email_id_t( std::uint64_t value ) : value_( value ) {}
+
+  constexpr std::uint64_t value() const { return value_; }
+  constexpr bool valid() const { return 0 != value_; }
+
+  friend constexpr bool operator==( email_id_t a, email_id_t b ) {
+    return a.value_ == b.value_;
+  }
+  friend constexpr bool operator!=( email_id_t a, email_id_t b ) {
+    return a.value_ != b.value_;
+  }
+
+private :
+  // Нулевое значение означает "нет идентификатора".
+  std::uint64_t value_{};
+};
+
+//
+// Таблица интернирования имен email-ов.
+//
+// Таблица разбита на сегменты, каждый со своим mutex-ом, поэтому
+// одновременные обращения из разных рабочих нитей в подавляющем
+// большинстве случаев не конкурируют друг с другом.
+//
+// Младшие shard_bits бит идентификатора содержат номер сегмента,
+// следующие slot_bits -- номер ячейки внутри сегмента (начиная с 1),
+// старшие -- поколение ячейки.
+//
+// Каждый вызов intern() добавляет имени одну ссылку, release() одну
+// ссылку снимает. Когда ссылок не остается, ячейка освобождается и
+// может быть занята другим именем, но уже с другим поколением, поэтому
+// старый идентификатор никогда не превратится в чужое имя: для него
+// name() вернет пустую строку. Таким образом размер таблицы
+// ограничен количеством имен, которые одновременно находятся в работе,
+// плюс имена, которые никогда не освобождаются (имена исходных
+// mbox-файлов и имена, которые генерирует requests_initiator; их
+// количество задается при запуске).
+//
+class email_name_table {
+  static constexpr unsigned shard_bits = 6;
+  static constexpr std::size_t shard_count = std::size_t{1} << shard_bits;
+  static constexpr unsigned slot_bits = 32;
+  static constexpr std::uint64_t slot_mask = (std::uint64_t{1} << slot_bits) - 1;
+
+  struct name_ref_hash {
+    std::size_t operator()( const std::reference_wrapper< const std::string > & s ) const {
+      return std::hash< std::string >{}( s.get() );
+    }
+  };
+  struct name_ref_equal {
+    bool operator()(
+      const std::reference_wrapper< const std::string > & a,
+      const std::reference_wrapper< const std::string > & b ) const {
+      return a.get() == b.get();
+    }
+  };
+
+  struct slot {
+    std::string name_;
+    std::uint64_t generation_{ 0 };
+    std::size_t refs_{ 0 };
+  };
+
+  struct shard {
+    std::mutex lock_;
+    // deque не инвалидирует ссылки на элементы при push_back, поэтому
+    // индекс может ссылаться на строки, хранящиеся в slots_.
+    std::deque< slot > slots_;
+    // Освобожденные ячейки, которые можно занять повторно.
+    std::vector< std::size_t > free_;
+    std::unordered_map<
+        std::reference_wrapper< const std::string >,
+        std::uint64_t,
+        name_ref_hash,
+        name_ref_equal > index_;
+  };
+
+  static std::uint64_t make_id(
+    std::size_t shard_index, std::size_t slot_index, std::uint64_t generation )
+  {
+    return (generation << (shard_bits + slot_bits)) |
+        (static_cast< std::uint64_t >( slot_index + 1 ) << shard_bits) |
+        shard_index;
+  }
+
+  // Ячейка, на которую указывает идентификатор, или nullptr, если
+  // идентификатор устарел. Должна вызываться под блокировкой сегмента.
+  static slot * find_slot( shard & s, email_id_t id ) {
+    const auto index = ((id.value() >> shard_bits) & slot_mask) - 1;
+    if( index >= s.slots_.size() )
+      return nullptr;
+    auto & e = s.slots_[ index ];
+    const auto generation = id.value() >> (shard_bits + slot_bits);
+    return e.refs_ && e.generation_ == generation ? &e : nullptr;
+  }
+
+public :
+  email_id_t intern( std::string name ) {
+    const auto shard_index = std::hash< std::string >{}( name ) & (shard_count - 1);
+    auto & s = shards_[ shard_index ];
+
+    std::lock_guard< std::mutex > lock{ s.lock_ };
+    auto it = s.index_.find( std::cref( name ) );
+    if( it != s.index_.end() ) {
+      ++s.slots_[ ((it->second >> shard_bits) & slot_mask) - 1 ].refs_;
+      return email_id_t{ it->second };
+    }
+
+    std::size_t index;
+    if( s.free_.empty() ) {
+      index = s.slots_.size();
+      s.slots_.emplace_back();
+    }
+    else {
+      index = s.free_.back();
+      s.free_.pop_back();
+    }
+
+    auto & e = s.slots_[ index ];
+    e.name_ = std::move(name);
+    e.refs_ = 1;
+    const auto id = make_id( shard_index, index, e.generation_ );
+    s.index_.emplace( std::cref( e.name_ ), id );
+
+    return email_id_t{ id };
+  }
+
+  void release( email_id_t id ) {
+    if( !id.valid() )
+      return;
+
+    auto & s = shards_[ id.value() & (shard_count - 1) ];
+
+    std::lock_guard< std::mutex > lock{ s.lock_ };
+    auto * e = find_slot( s, id );
+    if( !e || --e->refs_ )
+      return;
+
+    s.index_.erase( std::cref( e->name_ ) );
+    e->name_.clear();
+    e->generation_ = (e->generation_ + 1) &
+        ((std::uint64_t{1} << (64 - shard_bits - slot_bits)) - 1);
+    s.free_.push_back( static_cast< std::size_t >(
+        ((id.value() >> shard_bits) & slot_mask) - 1 ) );
+  }
+
+  // Имя возвращается копией: после release() ячейка может быть
+  // занята другим именем.
+  std::string name( email_id_t id ) {
+    std::string r;
+    append_name( id, r );
+    return r;
+  }
+
+  // Для устаревшего идентификатора ничего не добавляется.
+  void append_name( email_id_t id, std::string & to ) {
+    with_slot( id, [&]( const slot & e ) { to += e.name_; } );
+  }
+
+  std::size_t name_length( email_id_t id ) {
+    std::size_t r = 0;
+    with_slot( id, [&]( const slot & e ) { r = e.name_.size(); } );
+    return r;
+  }
+
+private :
+  std::array< shard, shard_count > shards_;
+
+  // Обращение к ячейке под блокировкой ее сегмента.
+  template< typename F >
+  void with_slot( email_id_t id, F && f ) {
+    if( !id.valid() )
+      return;
+
+    auto & s = shards_[ id.value() & (shard_count - 1) ];
+
+    std::lock_guard< std::mutex > lock{ s.lock_ };
+    if( const auto * e = find_slot( s, id ) )
+      f( *e );
+  }
+};
+
+email_name_table & global_email_names() {
+  static email_name_table table;
+  return table;
+}
+
+// Получить идентификатор для имени файла с email-ом. Каждый вызов
+// добавляет имени ссылку.
+email_id_t intern_email_name( std::string name ) {
+  return global_email_names().intern( std::move(name) );
+}
+
+// Снять ссылку, добавленную intern_email_name(). Вызывается тогда,
+// когда идентификатор больше никому не нужен, в том числе и агенту,
+// который выводит результаты (см. forget_email_name в result_sink.hpp).
+void release_email_name( email_id_t id ) {
+  global_email_names().release( id );
+}
+
+// Получить имя файла по идентификатору.
+std::string email_name( email_id_t id ) {
+  return global_email_names().name( id );
+}
+
+// Длина имени файла без копирования самого имени.
+std::size_t email_name_length( email_id_t id ) {
+  return global_email_names().name_length( id );
+}
+
+// Дописать имя файла в конец строки без промежуточной копии.
+void append_email_name( email_id_t id, std::string & to ) {
+  global_email_names().append_name( id, to );
+}
+
+// При печати идентификатора печатается само имя.
+std::ostream & operator<<( std::ostream & to, email_id_t id ) {
+  return (to << email_name( id ));
+}
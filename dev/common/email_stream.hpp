@@ -0,0 +1,336 @@
+#pragma once
+
+#include <common/stuff.hpp>
+#include <common/spam_classifier.hpp>
+
+#include <cassert>
+
+//
+// Потоковая проверка больших email-ов.
+//
+// Обычно email загружается целиком, разбирается в арене и только потом
+// раздается checker-ам, поэтому большой email надолго занимает
+// анализатор, а в памяти оказывается и его содержимое, и разобранная
+// копия. В потоковом режиме IO-агент отдает email порциями фиксированного
+// размера (см. load_email_chunk), email_analyzer разбирает каждую порцию
+// сразу же, как она пришла (streaming_email_parser), и рассылает ее
+// checker-ам (email_chunk). Каждый checker накапливает только то
+// состояние, которое нужно для его проверки, и отвечает сразу же, как
+// только результат становится известен. Следующая порция рассылается
+// после того, как предыдущую подтвердили все checker-ы, а загружается
+// не раньше, чем рассылается предыдущая (см. chunk_flow), поэтому
+// на один email в памяти находится не больше двух порций.
+//
+// Размер порции задается в килобайтах переменной окружения
+// EMAIL_STREAM_CHUNK_KB. Порциями загружаются только email-ы из больших
+// файлов (mbox), которые больше одной порции. Если переменная не задана,
+// то потоковый режим не используется.
+//
+
+// Размер порции или 0, если потоковый режим не используется.
+size_t stream_chunk_size() {
+  static const size_t size = []{
+    const char * kb = getenv( "EMAIL_STREAM_CHUNK_KB" );
+    return kb ? static_cast< size_t >( atol( kb ) ) * 1024 : size_t{ 0 };
+  }();
+  return size;
+}
+
+// Нужно ли загружать email порциями.
+bool email_should_stream( const email_slice_t & slice ) {
+  return stream_chunk_size() && slice.length_ > stream_chunk_size();
+}
+
+// Очередная порция email-а, уже разделенная на заголовки и тело.
+struct email_chunk {
+  // Заголовки, которые закончились в этой порции.
+  vector< string > headers_;
+  // Все заголовки уже получены.
+  bool headers_complete_;
+  // Сама порция, данные которой остаются там, где их разместил IO-агент.
+  email_content content_;
+  // Где в порции начинается тело email-а.
+  size_t body_offset_;
+  // Порция последняя.
+  bool last_;
+
+  const char * body() const { return content_.data() + body_offset_; }
+  size_t body_size() const { return content_.size() - body_offset_; }
+};
+
+// Подтверждение того, что checker обработал очередную порцию.
+struct email_chunk_consumed : public signal_t {};
+
+//
+// Порядок загрузки и рассылки порций одного email-а.
+//
+// Следующая порция запрашивается только тогда, когда рассылается
+// предыдущая. Поэтому, пока checker-ы обрабатывают разосланную порцию,
+// загружается не больше одной следующей, и она дожидается подтверждений
+// здесь. Порции рассылаются строго по порядку и без пропусков, а на
+// один email в памяти не больше двух порций.
+//
+// CHUNK -- загруженная порция (load_email_chunk). publish вызывается
+// для каждой порции, которую пора рассылать, и должен запросить
+// следующую, если порция не последняя.
+//
+template< typename CHUNK >
+class chunk_flow {
+public :
+  explicit chunk_flow( unsigned consumers ) : consumers_( consumers ) {}
+
+  template< typename PUBLISH >
+  void loaded( const CHUNK & chunk, PUBLISH && publish ) {
+    // Следующая порция запрашивается только при рассылке, поэтому
+    // вторая ожидающая порция появиться не может.
+    assert( !next_ );
+    if( unconfirmed_ )
+      next_ = make_unique< CHUNK >( chunk );
+    else
+      start( chunk, publish );
+  }
+
+  template< typename PUBLISH >
+  void consumed( PUBLISH && publish ) {
+    assert( unconfirmed_ );
+    if( 0 == --unconfirmed_ && next_ ) {
+      const auto next = move( next_ );
+      start( *next, publish );
+    }
+  }
+
+private :
+  const unsigned consumers_;
+  // Сколько checker-ов еще не подтвердили последнюю разосланную порцию.
+  unsigned unconfirmed_{ 0 };
+  // Порция, которая уже загружена, но ждет подтверждения предыдущей.
+  unique_ptr< CHUNK > next_;
+
+  template< typename PUBLISH >
+  void start( const CHUNK & chunk, PUBLISH & publish ) {
+    unconfirmed_ = consumers_;
+    publish( chunk );
+  }
+};
+
+//
+// Разбор email-а по порциям. Дает тот же результат, что и
+// basic_parsed_email::parse для email-а целиком, но копирует только
+// заголовки, а тело оставляет в порциях.
+//
+class streaming_email_parser {
+public :
+  // Заголовок длиннее этого обрезается.
+  static constexpr size_t max_header_size = 64 * 1024;
+
+  email_chunk feed( email_content content, bool last ) {
+    email_chunk r{ {}, false, move(content), 0, last };
+
+    const char * const begin = r.content_.data();
+    const char * const end = begin + r.content_.size();
+    const char * data = begin;
+    while( in_headers_ && data != end ) {
+      const char * eol = static_cast< const char * >(
+          memchr( data, '\n', static_cast< size_t >(end - data) ) );
+      // Строка заголовка может продолжиться в следующей порции.
+      append_partial( data, eol ? eol : end );
+      if( !eol ) {
+        data = end;
+        break;
+      }
+
+      data = eol + 1;
+      complete_line( r );
+    }
+
+    // Последняя строка без перевода строки в конце.
+    if( last && in_headers_ ) {
+      if( !partial_.empty() )
+        complete_line( r );
+      in_headers_ = false;
+    }
+
+    r.headers_complete_ = !in_headers_;
+    r.body_offset_ = static_cast< size_t >( data - begin );
+    return r;
+  }
+
+private :
+  bool in_headers_{ true };
+  // Начало строки заголовка из предыдущих порций.
+  string partial_;
+
+  void append_partial( const char * from, const char * to ) {
+    const auto room = max_header_size - min( max_header_size, partial_.size() );
+    partial_.append( from, min( room, static_cast< size_t >( to - from ) ) );
+  }
+
+  void complete_line( email_chunk & r ) {
+    if( !partial_.empty() && '\r' == partial_.back() )
+      partial_.pop_back();
+
+    // Пустая строка отделяет заголовки от тела.
+    if( partial_.empty() )
+      in_headers_ = false;
+    else
+      r.headers_.push_back( move(partial_) );
+    partial_.clear();
+  }
+};
+
+constexpr size_t streaming_email_parser::max_header_size;
+
+//
+// Состояния потоковых проверок для каждого из checker-ов.
+//
+// feed() получает порции по порядку и возвращает true, когда результат
+// (status_) уже окончательный и остальные порции не нужны. На последней
+// порции результат окончательный всегда.
+//
+
+// Заголовки проверяются, как только все они получены.
+struct headers_stream {
+  vector< string > headers_;
+  check_status status_{ check_status::safe };
+
+  bool feed( const email_chunk & chunk ) {
+    headers_.insert( headers_.end(), chunk.headers_.begin(), chunk.headers_.end() );
+    if( !chunk.headers_complete_ )
+      return false;
+
+    status_ = check_headers( headers_ );
+    return true;
+  }
+};
+
+// Нечеткий отпечаток тела строится по мере поступления порций, а ссылки
+// проверяются в каждой порции, поэтому ссылка на плохой домен прерывает
+// проверку, не дожидаясь конца email-а.
+class body_stream {
+public :
+  check_status status_{ check_status::safe };
+
+  bool feed( const email_chunk & chunk ) {
+    hasher_.update( chunk.body(), chunk.body_size() );
+    if( bad_domains_ && find_bad_urls( chunk.body(), chunk.body_size(), chunk.last_ ) ) {
+      status_ = check_status::dangerous;
+      return true;
+    }
+
+    if( chunk.last_ )
+      status_ = global_fuzzy_index().find( hasher_.finish() );
+    return chunk.last_;
+  }
+
+private :
+  // Строка длиннее этого проверяется по частям.
+  static constexpr size_t max_line_size = 64 * 1024;
+
+  const domain_set * const bad_domains_{ global_bad_domains() };
+  fuzzy_hasher hasher_;
+  // Незаконченная строка из предыдущих порций.
+  string carry_;
+
+  // Ссылка не может продолжаться через перевод строки, если это не
+  // мягкий перенос quoted-printable, поэтому каждая порция проверяется
+  // по законченным строкам, а конец последней строки переносится
+  // в следующую порцию. Символы перед началом порции (например, '='
+  // мягкого переноса) берутся из конца предыдущей.
+  char char_before( const char * begin, const char * p, size_t back ) const {
+    const auto here = static_cast< size_t >( p - begin );
+    if( here >= back )
+      return p[ -static_cast< ptrdiff_t >( back ) ];
+    const auto from_carry = back - here;
+    return carry_.size() >= from_carry ? carry_[ carry_.size() - from_carry ] : '\n';
+  }
+
+  bool hard_break( const char * begin, const char * eol ) const {
+    const size_t back = '\r' == char_before( begin, eol, 1 ) ? 2 : 1;
+    return '=' != char_before( begin, eol, back );
+  }
+
+  const char * after_first_break( const char * begin, const char * end ) const {
+    for( const char * p = begin;
+        nullptr != (p = static_cast< const char * >( memchr( p, '\n', end - p ) ));
+        ++p )
+      if( hard_break( begin, p ) )
+        return p + 1;
+    return end;
+  }
+
+  const char * after_last_break( const char * begin, const char * end ) const {
+    for( const char * p = end; p != begin; --p )
+      if( '\n' == p[ -1 ] && hard_break( begin, p - 1 ) )
+        return p;
+    return begin;
+  }
+
+  bool scan( const char * data, size_t size ) const {
+    bool found = false;
+    extract_url_hosts( data, size, [&]( const char * host, size_t length ) {
+        found = found || bad_domains_->contains_domain_of( host, length );
+      } );
+    return found;
+  }
+
+  bool find_bad_urls( const char * data, size_t size, bool last ) {
+    const char * const end = data + size;
+    const char * const cut = last ? end : after_last_break( data, end );
+
+    const char * from = data;
+    if( !carry_.empty() && (cut != data || last) ) {
+      // Начало порции заканчивает строку из предыдущей порции.
+      from = after_first_break( data, cut );
+      carry_.append( data, from );
+      const bool found = scan( carry_.data(), carry_.size() );
+      carry_.clear();
+      if( found )
+        return true;
+    }
+
+    if( scan( from, static_cast< size_t >( cut - from ) ) )
+      return true;
+
+    carry_.append( cut, end );
+    if( carry_.size() > max_line_size ) {
+      const bool found = scan( carry_.data(), carry_.size() );
+      carry_.clear();
+      return found;
+    }
+    return false;
+  }
+};
+
+// Вложения при разборе пока не выделяются (см. basic_parsed_email::parse),
+// поэтому проверять в порциях нечего.
+struct attachments_stream {
+  check_status status_{ check_status::safe };
+
+  bool feed( const email_chunk & chunk ) {
+    return chunk.last_;
+  }
+};
+
+// Статистическая оценка накапливается по мере поступления порций.
+class score_stream {
+public :
+  check_status status_{ check_status::safe };
+
+  bool feed( const email_chunk & chunk ) {
+    if( !model_ )
+      return true;
+
+    for( const auto & h : chunk.headers_ )
+      scorer_->add_header( h.data(), h.size() );
+    scorer_->add_body( chunk.body(), chunk.body_size() );
+
+    if( chunk.last_ )
+      status_ = model_->classify( scorer_->score() );
+    return chunk.last_;
+  }
+
+private :
+  const spam_model * const model_{ global_spam_model() };
+  const unique_ptr< spam_model::scorer > scorer_{
+      model_ ? make_unique< spam_model::scorer >( *model_ ) : nullptr };
+};
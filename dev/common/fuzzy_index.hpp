@@ -0,0 +1,344 @@
+#pragma once
+
+#include <common/messages.hpp>
+
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+//
+// Поиск email-ов, похожих на уже известный спам.
+//
+// Рассылки спама отличаются от письма к письму несколькими байтами,
+// поэтому точное сравнение (или хэш всего тела) их не находит. Вместо
+// этого для тела email-а строится отпечаток MinHash: тело разбивается
+// на перекрывающиеся фрагменты по shingle_size байт, и для каждой из
+// fingerprint_size корзин запоминается минимальный хэш попавших в нее
+// фрагментов. Доля совпадающих позиций у двух отпечатков оценивает
+// долю общих фрагментов у двух тел.
+//
+// Чтобы не сравнивать отпечаток с каждым известным, используется LSH:
+// отпечаток делится на lsh_bands полос, и для каждой полосы ведется
+// хэш-таблица. Похожие отпечатки с большой вероятностью совпадают хотя
+// бы в одной полосе, поэтому сравнивать приходится только с теми, кто
+// попал в ту же корзину.
+//
+
+// Отпечаток тела email-а.
+struct body_fingerprint {
+  static constexpr size_t fingerprint_size = 32;
+
+  array< uint32_t, fingerprint_size > mins_;
+  // Сколько фрагментов было учтено. Слишком короткие тела
+  // не сравниваются.
+  uint64_t shingles_{ 0 };
+
+  bool valid() const { return shingles_ >= 16; }
+
+  // Оценка сходства двух отпечатков от 0 до 1.
+  double similarity( const body_fingerprint & o ) const {
+    size_t same = 0;
+    for( size_t i = 0; i != fingerprint_size; ++i )
+      same += (mins_[ i ] == o.mins_[ i ]);
+    return static_cast< double >( same ) / fingerprint_size;
+  }
+};
+
+constexpr size_t body_fingerprint::fingerprint_size;
+
+namespace fuzzy_details {
+
+inline uint64_t mix64( uint64_t v ) {
+  v ^= v >> 33;
+  v *= 0xff51afd7ed558ccdULL;
+  v ^= v >> 33;
+  v *= 0xc4ceb9fe1a85ec53ULL;
+  v ^= v >> 33;
+  return v;
+}
+
+} /* namespace fuzzy_details */
+
+//
+// Построитель отпечатка. Данные можно подавать частями по мере их
+// поступления, промежуточное состояние занимает несколько десятков байт.
+//
+// Используется однопроходный вариант MinHash: хэш каждого фрагмента
+// вычисляется один раз, его старшие биты выбирают корзину, а младшие
+// сравниваются с текущим минимумом корзины.
+//
+// Регистр букв и пробельные символы не учитываются, т.к. их чаще
+// всего и меняют, чтобы обойти фильтры.
+//
+class fuzzy_hasher {
+public :
+  static constexpr unsigned shingle_size = 5;
+
+  fuzzy_hasher() {
+    mins_.fill( numeric_limits< uint32_t >::max() );
+  }
+
+  void update( const char * data, size_t size ) {
+    const uint64_t mask = (uint64_t{ 1 } << (8 * shingle_size)) - 1;
+    for( const char * end = data + size; data != end; ++data ) {
+      const auto c = static_cast< unsigned char >( *data );
+      if( isspace( c ) )
+        continue;
+
+      window_ = ((window_ << 8) | static_cast< unsigned char >( tolower( c ) ))
+          & mask;
+      if( filled_ < shingle_size ) {
+        ++filled_;
+        if( filled_ < shingle_size )
+          continue;
+      }
+
+      const auto h = fuzzy_details::mix64( window_ );
+      const auto bucket = static_cast< size_t >(
+          h >> 59 ) % body_fingerprint::fingerprint_size;
+      const auto value = static_cast< uint32_t >( h );
+      if( value < mins_[ bucket ] )
+        mins_[ bucket ] = value;
+      ++shingles_;
+    }
+  }
+
+  body_fingerprint finish() const {
+    body_fingerprint r{ mins_, shingles_ };
+
+    // Пустые корзины заполняются значениями из следующих непустых,
+    // иначе у коротких тел совпадали бы пустые позиции.
+    const auto empty = numeric_limits< uint32_t >::max();
+    const auto n = body_fingerprint::fingerprint_size;
+    for( size_t i = 0; i != n && r.shingles_; ++i ) {
+      size_t from = i;
+      while( empty == mins_[ from ] )
+        from = (from + 1) % n;
+      if( from != i )
+        r.mins_[ i ] = mins_[ from ] + static_cast< uint32_t >(
+            (from + n - i) % n ) * 0x9e3779b9u;
+    }
+    return r;
+  }
+
+private :
+  uint64_t window_{ 0 };
+  unsigned filled_{ 0 };
+  uint64_t shingles_{ 0 };
+  array< uint32_t, body_fingerprint::fingerprint_size > mins_;
+};
+
+constexpr unsigned fuzzy_hasher::shingle_size;
+
+body_fingerprint make_body_fingerprint( const char * data, size_t size ) {
+  fuzzy_hasher hasher;
+  hasher.update( data, size );
+  return hasher.finish();
+}
+
+//
+// Индекс отпечатков известного спама.
+//
+// Отпечатки хранятся в одном векторе, а для каждой полосы LSH
+// ведется хэш-таблица с открытой адресацией: ключ полосы -> номер
+// первого отпечатка в цепочке. Цепочки связаны через вектор next_.
+//
+// На один известный отпечаток приходится:
+// - 136 байт на сам отпечаток и 4 байта на вердикт;
+// - 32 байта в next_ (по 4 байта на полосу);
+// - от 2 до 4 ячеек по 16 байт в каждой из lsh_bands таблиц, т.к. они
+//   заполнены от четверти до половины (256-512 байт).
+// Итого от 430 до 690 байт, а с учетом запаса емкости векторов -- до
+// 860 байт. Замер для 100-250 тысяч отпечатков дает 450-750 байт, т.е.
+// миллион отпечатков занимает порядка 0.5-0.9 ГБ.
+//
+// Поиск выполняет по одному обращению к таблице каждой полосы и
+// сравнивает не более max_candidates отпечатков из каждой корзины.
+//
+class fuzzy_index {
+  static constexpr size_t lsh_bands = 8;
+  static constexpr size_t band_rows =
+      body_fingerprint::fingerprint_size / lsh_bands;
+  static constexpr size_t max_candidates = 32;
+  static constexpr uint32_t no_entry = numeric_limits< uint32_t >::max();
+
+  struct slot {
+    uint64_t key_;
+    uint32_t head_;
+  };
+
+public :
+  // Насколько похожим должен быть отпечаток, чтобы считаться
+  // совпадением.
+  explicit fuzzy_index( double threshold = 0.7 )
+    : threshold_( threshold )
+  {
+    for( auto & t : tables_ )
+      t.assign( 1024, slot{ 0, no_entry } );
+  }
+
+  void add( const body_fingerprint & fp, check_status verdict ) {
+    if( !fp.valid() )
+      return;
+
+    unique_lock< shared_timed_mutex > lock{ lock_ };
+
+    const auto index = static_cast< uint32_t >( fingerprints_.size() );
+    fingerprints_.push_back( fp );
+    verdicts_.push_back( verdict );
+
+    // Таблицы заполнены не более чем наполовину.
+    if( (fingerprints_.size() * 2) > tables_[ 0 ].size() )
+      grow();
+
+    for( size_t b = 0; b != lsh_bands; ++b ) {
+      const auto key = band_key( fp, b );
+      auto & s = probe( tables_[ b ], key );
+      s.key_ = key;
+      next_.push_back( s.head_ );
+      s.head_ = index;
+    }
+  }
+
+  // Вердикт для самого похожего известного отпечатка или
+  // check_status::safe, если похожих нет.
+  check_status find( const body_fingerprint & fp ) const {
+    if( !fp.valid() )
+      return check_status::safe;
+
+    shared_lock< shared_timed_mutex > lock{ lock_ };
+
+    double best = threshold_;
+    auto verdict = check_status::safe;
+    for( size_t b = 0; b != lsh_bands; ++b ) {
+      const auto & s = probe( tables_[ b ], band_key( fp, b ) );
+      size_t checked = 0;
+      for( auto i = s.head_; no_entry != i && checked != max_candidates;
+          i = next_[ i * lsh_bands + b ], ++checked ) {
+        const auto sim = fp.similarity( fingerprints_[ i ] );
+        if( sim >= best ) {
+          best = sim;
+          verdict = verdicts_[ i ];
+        }
+      }
+    }
+    return verdict;
+  }
+
+  size_t size() const {
+    shared_lock< shared_timed_mutex > lock{ lock_ };
+    return fingerprints_.size();
+  }
+
+private :
+  const double threshold_;
+
+  mutable shared_timed_mutex lock_;
+  vector< body_fingerprint > fingerprints_;
+  vector< check_status > verdicts_;
+  // Следующий отпечаток в цепочке: next_[ index * lsh_bands + band ].
+  vector< uint32_t > next_;
+  array< vector< slot >, lsh_bands > tables_;
+
+  static uint64_t band_key( const body_fingerprint & fp, size_t band ) {
+    uint64_t key = band;
+    for( size_t r = 0; r != band_rows; ++r )
+      key = fuzzy_details::mix64( key ^ fp.mins_[ band * band_rows + r ] );
+    // Нулевой ключ обозначает свободную ячейку.
+    return key ? key : 1;
+  }
+
+  // Ячейка с заданным ключом или свободная ячейка, в которую этот
+  // ключ нужно поместить. Размер таблицы всегда является степенью двойки.
+  template< typename Table >
+  static auto probe( Table & table, uint64_t key ) -> decltype( table[ 0 ] ) {
+    const auto mask = table.size() - 1;
+    auto i = static_cast< size_t >( key ) & mask;
+    while( key != table[ i ].key_ && 0 != table[ i ].key_ )
+      i = (i + 1) & mask;
+    return table[ i ];
+  }
+
+  void grow() {
+    for( auto & t : tables_ ) {
+      vector< slot > bigger( t.size() * 2, slot{ 0, no_entry } );
+      for( const auto & s : t )
+        if( s.key_ )
+          probe( bigger, s.key_ ) = s;
+      t.swap( bigger );
+    }
+  }
+};
+
+constexpr size_t fuzzy_index::lsh_bands;
+constexpr size_t fuzzy_index::band_rows;
+constexpr size_t fuzzy_index::max_candidates;
+constexpr uint32_t fuzzy_index::no_entry;
+
+// Текстовое представление отпечатка: по 8 шестнадцатеричных цифр на
+// каждую корзину подряд.
+string format_fingerprint( const body_fingerprint & fp ) {
+  string r;
+  char buf[ 16 ];
+  for( auto v : fp.mins_ ) {
+    snprintf( buf, sizeof(buf), "%08x", v );
+    r += buf;
+  }
+  return r;
+}
+
+bool parse_fingerprint( const string & hex, body_fingerprint & fp ) {
+  if( hex.size() != body_fingerprint::fingerprint_size * 8 )
+    return false;
+
+  for( size_t i = 0; i != body_fingerprint::fingerprint_size; ++i ) {
+    char * end = nullptr;
+    const auto part = hex.substr( i * 8, 8 );
+    fp.mins_[ i ] = static_cast< uint32_t >( strtoul( part.c_str(), &end, 16 ) );
+    if( end != part.c_str() + 8 )
+      return false;
+  }
+  // Отпечаток из базы заведомо построен по достаточно длинному телу.
+  fp.shingles_ = numeric_limits< uint64_t >::max();
+  return true;
+}
+
+// Загрузка базы известного спама. Каждая строка файла имеет вид
+// "suspicious <отпечаток>" или "dangerous <отпечаток>".
+void load_fuzzy_index( fuzzy_index & index, const string & path ) {
+  ifstream file( path );
+  if( !file )
+    throw runtime_error( "unable to open " + path );
+
+  string verdict, hex;
+  while( file >> verdict >> hex ) {
+    body_fingerprint fp;
+    if( !parse_fingerprint( hex, fp ) )
+      continue;
+    if( "dangerous" == verdict )
+      index.add( fp, check_status::dangerous );
+    else if( "suspicious" == verdict )
+      index.add( fp, check_status::suspicious );
+  }
+}
+
+// Общий для всех индекс. Если задана переменная окружения EMAIL_FUZZY_DB,
+// то при первом обращении в индекс загружается указанный в ней файл.
+// Примеры обращаются к индексу еще до запуска SObjectizer
+// (см. load_check_data).
+fuzzy_index & global_fuzzy_index() {
+  static fuzzy_index index;
+  static const bool loaded = []{
+    if( const char * path = getenv( "EMAIL_FUZZY_DB" ) )
+      load_fuzzy_index( index, path );
+    return true;
+  }();
+  (void)loaded;
+  return index;
+}
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <common/messages.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+//
+// Правила имитации внешних операций: задержки и отказы IO-агента и
+// агентов-checker-ов.
+//
+// Правила вынесены отдельно для того, чтобы одни и те же правила
+// использовались и в настоящем конвейере, и в его модели с виртуальным
+// временем (см. policy_sim).
+//
+// По умолчанию действуют исходные правила примеров: каждый 7-й запрос
+// к IO-агенту неудачен, каждый 15-й теряется, задержка -- 10 мс на символ
+// имени файла; у checker-ов каждая 17-я проверка теряется, 11-я дает
+// suspicious, 19-я -- dangerous, задержка 50 + (n % 7) * 110 мс.
+//
+// Если задана переменная окружения EMAIL_IMITATION, то правила берутся
+// из указанного в ней файла. Каждая строка файла имеет вид
+// "<параметр> <значения>", пустые строки и строки, начинающиеся с '#',
+// пропускаются:
+//
+//   seed <число>                   начальное значение для генераторов;
+//   io.drop <правило>              запрос теряется;
+//   io.fail <правило>              ответ отрицательный;
+//   io.latency <распределение>     задержка ответа;
+//   io.latency_max <мс>            ограничение задержки (60000);
+//   checker.drop <правило>         ответа нет;
+//   checker.suspicious <правило>   результат suspicious;
+//   checker.dangerous <правило>    результат dangerous (если не suspicious);
+//   checker.latency <распределение>
+//   checker.latency_max <мс>
+//
+// Правило -- это либо "1/N" (каждый N-й, как в исходных примерах),
+// либо вероятность (например, 0.05). Распределения:
+//
+//   fixed <мс>
+//   per_char <мс>                  мс на символ имени файла;
+//   steps <база> <шаг> <N>         база + (n % N) * шаг;
+//   uniform <от> <до>
+//   lognormal <медиана> <sigma>
+//   pareto <минимум> <alpha>       тяжелый хвост, при alpha <= 2
+//                                  дисперсия бесконечна.
+//
+// Например, задержки IO с длинным хвостом и 1% потерь:
+//
+//   io.drop 0.01
+//   io.fail 0.02
+//   io.latency lognormal 80 0.6
+//   checker.latency pareto 40 1.5
+//
+// Случайные числа берутся из генераторов, свой у каждой рабочей нити.
+// Правила вида "1/N" и задержка steps для checker-ов, как и в исходных
+// примерах, нумеруют проверки одним общим для всех нитей счетчиком.
+// Если таких правил нет, то общий счетчик не используется.
+//
+
+//
+// Генератор псевдослучайных чисел (splitmix64). Быстрый, с маленьким
+// состоянием, для имитации его качества достаточно.
+//
+class imitation_rng {
+public :
+  explicit imitation_rng( uint64_t seed ) : state_( seed ) {}
+
+  uint64_t next() {
+    uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  // Равномерно в интервале (0, 1).
+  double uniform() {
+    return (static_cast< double >( next() >> 11 ) + 0.5) * (1.0 / 9007199254740992.0);
+  }
+
+  // Стандартное нормальное распределение (преобразование Бокса-Мюллера).
+  double normal() {
+    const double pi = 3.14159265358979323846;
+    return sqrt( -2.0 * log( uniform() ) ) * cos( 2.0 * pi * uniform() );
+  }
+
+private :
+  uint64_t state_;
+};
+
+// Правило для события, которое происходит с n-ой операцией.
+struct imitation_rule {
+  // Если не 0, то событие происходит с каждой every_-ой операцией.
+  unsigned every_;
+  // Иначе событие происходит с такой вероятностью.
+  double probability_;
+
+  bool happens( unsigned n, imitation_rng & rng ) const {
+    if( every_ )
+      return 0 == (n % every_);
+    return probability_ > 0 && rng.uniform() < probability_;
+  }
+};
+
+// Распределение задержки.
+struct imitation_latency {
+  enum class kind { fixed, per_char, steps, uniform, lognormal, pareto };
+
+  kind kind_;
+  double a_;
+  double b_;
+  unsigned steps_;
+  chrono::milliseconds max_{ 60000 };
+
+  chrono::milliseconds sample(
+    unsigned n,
+    size_t name_length,
+    imitation_rng & rng ) const
+  {
+    double ms = a_;
+    switch( kind_ ) {
+      case kind::fixed: break;
+      case kind::per_char: ms = a_ * static_cast< double >( name_length ); break;
+      case kind::steps: ms = a_ + (steps_ ? n % steps_ : 0) * b_; break;
+      case kind::uniform: ms = a_ + (b_ - a_) * rng.uniform(); break;
+      case kind::lognormal: ms = a_ * exp( b_ * rng.normal() ); break;
+      case kind::pareto: ms = a_ / pow( rng.uniform(), 1.0 / b_ ); break;
+    }
+
+    const auto limit = static_cast< double >( max_.count() );
+    return chrono::milliseconds(
+        static_cast< chrono::milliseconds::rep >( max( 0.0, min( ms, limit ) ) ) );
+  }
+};
+
+// Что IO-агент сделает с запросом.
+struct io_imitation {
+  // Запрос потерялся где-то по дороге, ответа не будет.
+  bool lost_;
+  // Ответ будет отрицательным.
+  bool failed_;
+  // Через сколько времени будет отослан ответ.
+  chrono::milliseconds pause_;
+};
+
+// Что checker сделает при проверке.
+struct checker_imitation {
+  // Ответа не будет, у email_analyzer-а должен сработать тайм-аут.
+  bool lost_;
+  check_status status_;
+  chrono::milliseconds pause_;
+};
+
+//
+// Набор правил имитации.
+//
+struct imitation_model {
+  uint64_t seed_{ 0x5eed };
+
+  imitation_rule io_drop_{ 15, 0 };
+  imitation_rule io_fail_{ 7, 0 };
+  imitation_latency io_latency_{ imitation_latency::kind::per_char, 10, 0, 0 };
+
+  imitation_rule checker_drop_{ 17, 0 };
+  imitation_rule checker_suspicious_{ 11, 0 };
+  imitation_rule checker_dangerous_{ 19, 0 };
+  imitation_latency checker_latency_{ imitation_latency::kind::steps, 50, 110, 7 };
+
+  // n -- номер запроса у данного IO-агента (нумерация с 1).
+  io_imitation io_request(
+    unsigned n,
+    size_t name_length,
+    imitation_rng & rng ) const
+  {
+    const bool lost = io_drop_.happens( n, rng );
+    const bool failed = io_fail_.happens( n, rng );
+    return io_imitation{ lost, failed, io_latency_.sample( n, name_length, rng ) };
+  }
+
+  // Нужен ли для check() номер проверки.
+  bool checks_numbered() const {
+    return checker_drop_.every_ || checker_suspicious_.every_ ||
+        checker_dangerous_.every_ ||
+        imitation_latency::kind::steps == checker_latency_.kind_;
+  }
+
+  // n -- номер проверки (нумерация с 1).
+  checker_imitation check( unsigned n, imitation_rng & rng ) const {
+    const bool lost = checker_drop_.happens( n, rng );
+    check_status status{ check_status::safe };
+    if( checker_suspicious_.happens( n, rng ) )
+      status = check_status::suspicious;
+    else if( checker_dangerous_.happens( n, rng ) )
+      status = check_status::dangerous;
+    return checker_imitation{ lost, status, checker_latency_.sample( n, 0, rng ) };
+  }
+};
+
+namespace imitation_details {
+
+inline imitation_rule parse_rule( const string & v ) {
+  if( 0 == v.compare( 0, 2, "1/" ) ) {
+    const auto every = stoul( v.substr( 2 ) );
+    if( !every )
+      throw runtime_error( "invalid imitation rule: " + v );
+    return imitation_rule{ static_cast< unsigned >( every ), 0 };
+  }
+
+  const auto p = stod( v );
+  if( p < 0 || p > 1 )
+    throw runtime_error( "invalid imitation probability: " + v );
+  return imitation_rule{ 0, p };
+}
+
+inline void parse_latency( istringstream & fields, imitation_latency & to ) {
+  using kind = imitation_latency::kind;
+
+  string name;
+  fields >> name;
+  double a = 0, b = 0;
+  unsigned steps = 0;
+  bool ok = false;
+  if( "fixed" == name ) { to.kind_ = kind::fixed; ok = !!(fields >> a); }
+  else if( "per_char" == name ) { to.kind_ = kind::per_char; ok = !!(fields >> a); }
+  else if( "steps" == name ) { to.kind_ = kind::steps; ok = !!(fields >> a >> b >> steps); }
+  else if( "uniform" == name ) { to.kind_ = kind::uniform; ok = !!(fields >> a >> b); }
+  else if( "lognormal" == name ) { to.kind_ = kind::lognormal; ok = !!(fields >> a >> b); }
+  else if( "pareto" == name ) { to.kind_ = kind::pareto; ok = !!(fields >> a >> b) && b > 0; }
+
+  if( !ok || a < 0 )
+    throw runtime_error( "invalid imitation latency: " + name );
+
+  to.a_ = a;
+  to.b_ = b;
+  to.steps_ = steps;
+}
+
+} /* namespace imitation_details */
+
+// Загрузка правил из файла. Параметры, которых нет в файле, остаются
+// такими же, как в правилах по умолчанию.
+imitation_model load_imitation_model( const string & file_name ) {
+  using namespace imitation_details;
+
+  ifstream file( file_name );
+  if( !file )
+    throw runtime_error( "unable to open " + file_name );
+
+  imitation_model model;
+  string line, name, value;
+  while( getline( file, line ) ) {
+    istringstream fields( line );
+    if( !(fields >> name) || '#' == name[ 0 ] )
+      continue;
+
+    if( "io.latency" == name )
+      parse_latency( fields, model.io_latency_ );
+    else if( "checker.latency" == name )
+      parse_latency( fields, model.checker_latency_ );
+    else {
+      if( !(fields >> value) )
+        throw runtime_error( "no value for imitation parameter: " + name );
+
+      if( "seed" == name ) model.seed_ = stoull( value );
+      else if( "io.drop" == name ) model.io_drop_ = parse_rule( value );
+      else if( "io.fail" == name ) model.io_fail_ = parse_rule( value );
+      else if( "io.latency_max" == name )
+        model.io_latency_.max_ = chrono::milliseconds( stoul( value ) );
+      else if( "checker.drop" == name ) model.checker_drop_ = parse_rule( value );
+      else if( "checker.suspicious" == name )
+        model.checker_suspicious_ = parse_rule( value );
+      else if( "checker.dangerous" == name )
+        model.checker_dangerous_ = parse_rule( value );
+      else if( "checker.latency_max" == name )
+        model.checker_latency_.max_ = chrono::milliseconds( stoul( value ) );
+      else
+        throw runtime_error( "unknown imitation parameter: " + name );
+    }
+  }
+
+  return model;
+}
+
+// Правила из файла, который указан в EMAIL_IMITATION, или правила
+// по умолчанию.
+const imitation_model & global_imitation_model() {
+  static const imitation_model model = []{
+    const char * path = getenv( "EMAIL_IMITATION" );
+    return path ? load_imitation_model( path ) : imitation_model{};
+  }();
+  return model;
+}
+
+//
+// Генератор рабочей нити.
+//
+// Генераторы разных нитей получают разные начальные значения: к seed
+// из правил добавляется порядковый номер нити. Общий атомарный счетчик
+// используется только один раз при первом обращении нити.
+//
+imitation_rng & local_imitation_rng() {
+  static atomic< uint64_t > threads{ 0 };
+  thread_local imitation_rng rng{ global_imitation_model().seed_ +
+      0x9e3779b97f4a7c15ULL * threads.fetch_add( 1, memory_order_relaxed ) };
+  return rng;
+}
+
+// Что IO-агент сделает с n-ым запросом (нумерация с 1).
+io_imitation imitate_io_request( unsigned n, size_t name_length ) {
+  return global_imitation_model().io_request(
+      n, name_length, local_imitation_rng() );
+}
+
+// Что checker сделает при очередной проверке. Проверки нумеруются общим
+// счетчиком, поэтому правила по умолчанию (каждая 17-я проверка
+// теряется и т.д.) действуют на все проверки вместе, как в исходных
+// примерах, независимо от количества рабочих нитей.
+checker_imitation imitate_checker() {
+  static atomic< unsigned > checks{ 0 };
+  const auto & model = global_imitation_model();
+  const unsigned n = model.checks_numbered() ?
+      checks.fetch_add( 1, memory_order_relaxed ) + 1 : 0;
+  return model.check( n, local_imitation_rng() );
+}
@@ -0,0 +1,502 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+//
+// Распаковка потоков deflate (RFC 1951) и gzip (RFC 1952).
+//
+// Входные данные должны быть доступны целиком (например, вложение
+// email-а или отображенный в память файл), а распакованные данные
+// выдаются порциями через sink( const char *, size_t ). Если sink
+// возвращает false, то распаковка прекращается. Распакованный поток
+// целиком в памяти никогда не хранится: inflater держит только окно
+// последних 32 КБ и буфер для очередной порции, всего 128 КБ.
+//
+// Коды Хаффмана длиной до fast_bits бит декодируются одним обращением
+// к таблице, более длинные -- побитово по каноническому представлению.
+//
+
+enum class inflate_status {
+  // Поток распакован полностью.
+  done,
+  // Поток поврежден или обрывается раньше времени.
+  corrupt,
+  // Распаковка прекращена, т.к. sink вернул false.
+  stopped
+};
+
+namespace inflate_details {
+
+const unsigned fast_bits = 10;
+const unsigned max_bits = 15;
+
+struct huffman {
+  uint16_t count_[ max_bits + 1 ];
+  uint16_t symbol_[ 320 ];
+  // Элемент таблицы: (длина кода << 9) | символ. Ноль означает, что
+  // код длиннее fast_bits.
+  uint16_t fast_[ 1u << fast_bits ];
+
+  // Построение по длинам кодов. Возвращает false, если длины не могут
+  // задавать префиксный код.
+  bool build( const uint8_t * lengths, unsigned n ) {
+    memset( count_, 0, sizeof(count_) );
+    for( unsigned s = 0; s != n; ++s )
+      ++count_[ lengths[ s ] ];
+    count_[ 0 ] = 0;
+
+    int left = 1;
+    for( unsigned len = 1; len <= max_bits; ++len ) {
+      left = (left << 1) - count_[ len ];
+      if( left < 0 )
+        return false;
+    }
+
+    uint16_t offsets[ max_bits + 2 ];
+    offsets[ 1 ] = 0;
+    for( unsigned len = 1; len <= max_bits; ++len )
+      offsets[ len + 1 ] = static_cast< uint16_t >( offsets[ len ] + count_[ len ] );
+    for( unsigned s = 0; s != n; ++s )
+      if( lengths[ s ] )
+        symbol_[ offsets[ lengths[ s ] ]++ ] = static_cast< uint16_t >( s );
+
+    memset( fast_, 0, sizeof(fast_) );
+    unsigned code = 0;
+    unsigned index = 0;
+    for( unsigned len = 1; len <= fast_bits; ++len ) {
+      for( unsigned k = 0; k != count_[ len ]; ++k, ++code ) {
+        // В потоке коды записываются начиная со старшего бита.
+        unsigned reversed = 0;
+        for( unsigned b = 0; b != len; ++b )
+          reversed |= ((code >> b) & 1u) << (len - 1 - b);
+        const auto entry = static_cast< uint16_t >(
+            (len << 9) | symbol_[ index++ ] );
+        for( unsigned i = reversed; i < (1u << fast_bits); i += 1u << len )
+          fast_[ i ] = entry;
+      }
+      code <<= 1;
+    }
+    return true;
+  }
+};
+
+const uint16_t length_base[ 29 ] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t length_extra[ 29 ] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t dist_base[ 30 ] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577 };
+const uint8_t dist_extra[ 30 ] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+struct fixed_tables {
+  huffman lengths_;
+  huffman distances_;
+
+  fixed_tables() {
+    uint8_t l[ 288 ];
+    memset( l, 8, 144 );
+    memset( l + 144, 9, 112 );
+    memset( l + 256, 7, 24 );
+    memset( l + 280, 8, 8 );
+    lengths_.build( l, 288 );
+
+    uint8_t d[ 30 ];
+    memset( d, 5, 30 );
+    distances_.build( d, 30 );
+  }
+};
+
+inline const fixed_tables & fixed() {
+  static const fixed_tables tables;
+  return tables;
+}
+
+} /* namespace inflate_details */
+
+class inflater {
+  static constexpr size_t window_size = 32768;
+  static constexpr size_t buffer_size = 4 * window_size;
+  // Самая длинная копия в deflate.
+  static constexpr size_t max_match = 258;
+
+public :
+  inflater() : out_( new uint8_t[ buffer_size ] ) {}
+
+  // Распаковка "сырого" потока deflate.
+  template< typename Sink >
+  inflate_status inflate( const void * data, size_t size, Sink && sink ) {
+    begin_ = in_ = static_cast< const uint8_t * >( data );
+    end_ = begin_ + size;
+    bits_ = 0;
+    count_ = 0;
+    padding_ = 0;
+    pos_ = flushed_ = 0;
+
+    bool last = false;
+    while( !last ) {
+      last = 0 != take( 1 );
+      auto r = inflate_status::corrupt;
+      switch( take( 2 ) ) {
+        case 0: r = stored( sink ); break;
+        case 1:
+          r = codes( inflate_details::fixed().lengths_,
+              inflate_details::fixed().distances_, sink );
+          break;
+        case 2: r = dynamic( sink ); break;
+      }
+      if( inflate_status::done != r )
+        return r;
+    }
+
+    return flush( sink ) ? inflate_status::done : inflate_status::stopped;
+  }
+
+  // Сколько байт входных данных занял поток, распакованный последним
+  // вызовом inflate(). Нужно, чтобы найти то, что идет за потоком.
+  size_t consumed() const {
+    return static_cast< size_t >( in_ - begin_ ) - (count_ / 8 - padding_);
+  }
+
+private :
+  std::unique_ptr< uint8_t[] > out_;
+  // Текущая позиция в out_ и граница уже отданных в sink данных.
+  size_t pos_{ 0 };
+  size_t flushed_{ 0 };
+
+  const uint8_t * begin_{ nullptr };
+  const uint8_t * in_{ nullptr };
+  const uint8_t * end_{ nullptr };
+  uint64_t bits_{ 0 };
+  unsigned count_{ 0 };
+  // Сколько нулевых байт было добавлено в bits_ после конца входных
+  // данных. Если они будут использованы, то поток оборван.
+  unsigned padding_{ 0 };
+
+  void refill() {
+    while( count_ <= 56 ) {
+      uint64_t b = 0;
+      if( in_ != end_ )
+        b = *in_++;
+      else
+        ++padding_;
+      bits_ |= b << count_;
+      count_ += 8;
+    }
+  }
+
+  bool overrun() const { return padding_ * 8 > count_; }
+
+  unsigned take( unsigned n ) {
+    if( count_ < n )
+      refill();
+    const auto v = static_cast< unsigned >( bits_ & ((uint64_t{ 1 } << n) - 1) );
+    bits_ >>= n;
+    count_ -= n;
+    return v;
+  }
+
+  // Декодирование очередного символа. Возвращает -1 для
+  // недопустимого кода.
+  int decode( const inflate_details::huffman & h ) {
+    using namespace inflate_details;
+
+    if( count_ < max_bits )
+      refill();
+
+    const auto e = h.fast_[ bits_ & ((1u << fast_bits) - 1) ];
+    if( e ) {
+      bits_ >>= (e >> 9);
+      count_ -= (e >> 9);
+      return e & 0x1ff;
+    }
+
+    int code = 0, first = 0, index = 0;
+    for( unsigned len = 1; len <= max_bits; ++len ) {
+      code |= static_cast< int >( bits_ & 1 );
+      bits_ >>= 1;
+      --count_;
+      const int n = h.count_[ len ];
+      if( code - first < n )
+        return h.symbol_[ index + code - first ];
+      index += n;
+      first = (first + n) << 1;
+      code <<= 1;
+    }
+    return -1;
+  }
+
+  template< typename Sink >
+  bool flush( Sink & sink ) {
+    if( pos_ != flushed_ ) {
+      if( !sink( reinterpret_cast< const char * >( out_.get() + flushed_ ),
+          pos_ - flushed_ ) )
+        return false;
+      flushed_ = pos_;
+    }
+    return true;
+  }
+
+  // Освобождение места в буфере как минимум для max_match байт. Для
+  // ссылок назад в буфере всегда остаются последние window_size байт.
+  template< typename Sink >
+  bool make_room( Sink & sink ) {
+    if( pos_ + max_match > buffer_size ) {
+      if( !flush( sink ) )
+        return false;
+      memmove( out_.get(), out_.get() + pos_ - window_size, window_size );
+      pos_ = flushed_ = window_size;
+    }
+    return true;
+  }
+
+  template< typename Sink >
+  inflate_status stored( Sink & sink ) {
+    // Несжатый блок начинается с границы байта.
+    take( count_ % 8 );
+    const auto len = take( 16 );
+    const auto nlen = take( 16 );
+    if( overrun() || (len ^ 0xffffu) != nlen )
+      return inflate_status::corrupt;
+
+    size_t left = len;
+    while( left ) {
+      if( !make_room( sink ) )
+        return inflate_status::stopped;
+      size_t n = std::min( left, buffer_size - pos_ );
+
+      // Сначала берутся байты, которые уже прочитаны в bits_.
+      size_t i = 0;
+      for( ; i != n && count_ >= 8; ++i )
+        out_[ pos_ + i ] = static_cast< uint8_t >( take( 8 ) );
+      if( overrun() )
+        return inflate_status::corrupt;
+
+      const size_t direct = n - i;
+      if( static_cast< size_t >( end_ - in_ ) < direct )
+        return inflate_status::corrupt;
+      memcpy( out_.get() + pos_ + i, in_, direct );
+      in_ += direct;
+
+      pos_ += n;
+      left -= n;
+    }
+    return inflate_status::done;
+  }
+
+  template< typename Sink >
+  inflate_status dynamic( Sink & sink ) {
+    using namespace inflate_details;
+
+    static const uint8_t order[ 19 ] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15 };
+
+    const unsigned nlen = take( 5 ) + 257;
+    const unsigned ndist = take( 5 ) + 1;
+    const unsigned ncode = take( 4 ) + 4;
+    if( nlen > 286 || ndist > 30 )
+      return inflate_status::corrupt;
+
+    uint8_t lengths[ 320 ] = {};
+    for( unsigned i = 0; i != ncode; ++i )
+      lengths[ order[ i ] ] = static_cast< uint8_t >( take( 3 ) );
+
+    huffman code_lengths;
+    if( !code_lengths.build( lengths, 19 ) )
+      return inflate_status::corrupt;
+
+    for( unsigned i = 0; i < nlen + ndist; ) {
+      const int sym = decode( code_lengths );
+      if( sym < 0 || overrun() )
+        return inflate_status::corrupt;
+      if( sym < 16 ) {
+        lengths[ i++ ] = static_cast< uint8_t >( sym );
+        continue;
+      }
+
+      uint8_t value = 0;
+      unsigned repeat;
+      if( 16 == sym ) {
+        if( !i )
+          return inflate_status::corrupt;
+        value = lengths[ i - 1 ];
+        repeat = 3 + take( 2 );
+      }
+      else if( 17 == sym )
+        repeat = 3 + take( 3 );
+      else
+        repeat = 11 + take( 7 );
+
+      if( i + repeat > nlen + ndist )
+        return inflate_status::corrupt;
+      while( repeat-- )
+        lengths[ i++ ] = value;
+    }
+
+    // Без кода конца блока поток не может быть правильным.
+    if( !lengths[ 256 ] )
+      return inflate_status::corrupt;
+
+    huffman literals, distances;
+    if( !literals.build( lengths, nlen ) ||
+        !distances.build( lengths + nlen, ndist ) )
+      return inflate_status::corrupt;
+
+    return codes( literals, distances, sink );
+  }
+
+  template< typename Sink >
+  inflate_status codes(
+    const inflate_details::huffman & literals,
+    const inflate_details::huffman & distances,
+    Sink & sink )
+  {
+    using namespace inflate_details;
+
+    for(;;) {
+      int sym = decode( literals );
+      if( sym < 0 || overrun() )
+        return inflate_status::corrupt;
+
+      if( sym < 256 ) {
+        if( !make_room( sink ) )
+          return inflate_status::stopped;
+        out_[ pos_++ ] = static_cast< uint8_t >( sym );
+        continue;
+      }
+      if( 256 == sym )
+        return inflate_status::done;
+
+      sym -= 257;
+      if( sym >= 29 )
+        return inflate_status::corrupt;
+      const size_t len = length_base[ sym ] + take( length_extra[ sym ] );
+
+      sym = decode( distances );
+      if( sym < 0 || sym >= 30 )
+        return inflate_status::corrupt;
+      const size_t dist = dist_base[ sym ] + take( dist_extra[ sym ] );
+      if( overrun() )
+        return inflate_status::corrupt;
+
+      if( !make_room( sink ) )
+        return inflate_status::stopped;
+      if( dist > pos_ )
+        return inflate_status::corrupt;
+
+      uint8_t * to = out_.get() + pos_;
+      const uint8_t * from = to - dist;
+      if( dist >= len )
+        memcpy( to, from, len );
+      else
+        for( size_t i = 0; i != len; ++i )
+          to[ i ] = from[ i ];
+      pos_ += len;
+    }
+  }
+};
+
+constexpr size_t inflater::window_size;
+constexpr size_t inflater::buffer_size;
+constexpr size_t inflater::max_match;
+
+// Обновление CRC-32 (тот вариант, который используется в gzip и zip).
+uint32_t crc32_update( uint32_t crc, const void * data, size_t size ) {
+  struct table_t {
+    uint32_t values_[ 256 ];
+    table_t() {
+      for( uint32_t i = 0; i != 256; ++i ) {
+        uint32_t c = i;
+        for( int k = 0; k != 8; ++k )
+          c = (c & 1) ? 0xedb88320u ^ (c >> 1) : c >> 1;
+        values_[ i ] = c;
+      }
+    }
+  };
+  static const table_t table;
+
+  const auto * p = static_cast< const uint8_t * >( data );
+  crc = ~crc;
+  for( size_t i = 0; i != size; ++i )
+    crc = table.values_[ (crc ^ p[ i ]) & 0xff ] ^ (crc >> 8);
+  return ~crc;
+}
+
+// Размер заголовка одного члена gzip-файла или 0, если заголовок
+// поврежден или это не gzip.
+size_t gzip_header_size( const uint8_t * p, size_t size ) {
+  if( size < 18 || 0x1f != p[ 0 ] || 0x8b != p[ 1 ] || 8 != p[ 2 ] )
+    return 0;
+
+  const uint8_t flags = p[ 3 ];
+  size_t pos = 10;
+  if( flags & 4 ) {
+    if( size < pos + 2 )
+      return 0;
+    pos += 2 + (p[ pos ] | (size_t{ p[ pos + 1 ] } << 8));
+  }
+  for( uint8_t f : { uint8_t{ 8 }, uint8_t{ 16 } } )
+    if( flags & f ) {
+      while( pos < size && p[ pos ] )
+        ++pos;
+      ++pos;
+    }
+  if( flags & 2 )
+    pos += 2;
+
+  return pos < size ? pos : 0;
+}
+
+// Распаковка gzip-файла, который может состоять из нескольких членов
+// (например, после cat a.gz b.gz). Контрольные суммы проверяются.
+template< typename Sink >
+inflate_status gunzip(
+  const void * data,
+  size_t size,
+  inflater & inf,
+  Sink && sink )
+{
+  const auto * p = static_cast< const uint8_t * >( data );
+  size_t offset = 0;
+  do {
+    const auto header = gzip_header_size( p + offset, size - offset );
+    if( !header )
+      return inflate_status::corrupt;
+    offset += header;
+
+    uint32_t crc = 0;
+    uint32_t length = 0;
+    const auto r = inf.inflate( p + offset, size - offset,
+      [&]( const char * d, size_t n ) {
+        crc = crc32_update( crc, d, n );
+        length += static_cast< uint32_t >( n );
+        return sink( d, n );
+      } );
+    if( inflate_status::done != r )
+      return r;
+
+    offset += inf.consumed();
+    if( size - offset < 8 )
+      return inflate_status::corrupt;
+    const auto * trailer = p + offset;
+    const uint32_t stored_crc = trailer[ 0 ] | (uint32_t{ trailer[ 1 ] } << 8) |
+        (uint32_t{ trailer[ 2 ] } << 16) | (uint32_t{ trailer[ 3 ] } << 24);
+    const uint32_t stored_length = trailer[ 4 ] | (uint32_t{ trailer[ 5 ] } << 8) |
+        (uint32_t{ trailer[ 6 ] } << 16) | (uint32_t{ trailer[ 7 ] } << 24);
+    if( stored_crc != crc || stored_length != length )
+      return inflate_status::corrupt;
+    offset += 8;
+  }
+  while( offset != size );
+
+  return inflate_status::done;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <common/stuff.hpp>
+#include <common/mail_source.hpp>
+#include <common/imitation.hpp>
 
 //
 // Сообщения, которые необходимы для взаимодействия IO-агента с внешним миром.
@@ -9,17 +11,41 @@
 // Запрос на загрузку содержимого файла.
 struct load_email_request
 {
-  // Имя файла для загрузки.
-  string email_file_;
+  // Идентификатор файла для загрузки.
+  email_id_t email_file_;
   // Куда нужно прислать результат.
   mbox_t reply_to_;
+  // Если email хранится внутри большого файла, то где именно.
+  email_slice_t slice_{};
+  // После этого момента загрузка уже не нужна.
+  deadline_t deadline_{ no_deadline };
+  // Память email-а, учтенная в бюджете при приеме заявки в работу
+  // (см. memory_budget.hpp). Если не задана, то учет начинается
+  // при загрузке.
+  memory_ticket memory_{};
+  // Если не 0, то email из большого файла загружается порциями такого
+  // размера, и в ответ отсылается одна порция, которая начинается
+  // с chunk_offset_ от начала email-а (см. email_stream.hpp).
+  uint64_t chunk_offset_{ 0 };
+  size_t chunk_size_{ 0 };
 };
 
 // Успешный результат загрузки файла.
 struct load_email_succeed
 {
-  // Содержимое файла.
-  string content_;
+  // Содержимое файла. Размещается в арене, которая затем будет
+  // использоваться для всех остальных данных этого email-а.
+  email_content content_;
+};
+
+// Очередная порция email-а при загрузке порциями.
+struct load_email_chunk
+{
+  email_content content_;
+  // Смещение порции от начала email-а.
+  uint64_t offset_;
+  // Порция последняя.
+  bool last_;
 };
 
 // Неудачный результат загрузки файла.
@@ -29,6 +55,12 @@ struct load_email_failed
   string what_;
 };
 
+// Имя mbox-а IO-агента. IO-агентов может быть несколько (например,
+// для дублирования запросов), у каждого свой номер и свой mbox.
+string io_agent_mbox_name( unsigned shard = 0 ) {
+  return shard ? "io_agent_" + to_string( shard ) : string( "io_agent" );
+}
+
 //
 // Сам IO-агент.
 //
@@ -44,42 +76,142 @@ struct load_email_failed
 //   (т.е. отсылкой load_email_failed);
 // - на каждый 15-й запрос ответ не будет отсылаться вовсе.
 //
+// Если к моменту завершения загрузки истечет deadline запроса, то
+// вместо результата загрузки сразу же отсылается load_email_failed.
+//
 class io_agent final : public agent_t {
 public :
-  io_agent( context_t ctx ) : agent_t( ctx ) {
+  io_agent( context_t ctx, unsigned shard = 0 ) : agent_t( ctx ) {
     // Для взаимодействия с внешним миром IO-агент будет использовать
     // именованный mbox.
-    so_subscribe( so_environment().create_mbox( "io_agent" ) )
+    so_subscribe( so_environment().create_mbox( io_agent_mbox_name( shard ) ) )
       .event( &io_agent::on_request );
   }
 
 private :
   // Этот счетчик нужен для определения того, как среагировать
   // на очередной запрос.
-  int counter_{ 0 };
+  unsigned counter_{ 0 };
 
   void on_request( const load_email_request & msg ) {
-    ++counter_;
-    if( 0 == (counter_ % 15) )
+    if( deadline_expired( msg.deadline_ ) ) {
+      send< load_email_failed >( msg.reply_to_, "deadline exceeded" );
+      return;
+    }
+
+    // Email-ы из больших файлов не имитируются, а берутся прямо
+    // из отображенного в память файла.
+    if( !msg.slice_.empty() ) {
+      if( msg.chunk_size_ )
+        load_chunk( msg );
+      else
+        load_slice( msg );
+      return;
+    }
+
+    const auto imitation = imitate_io_request(
+        ++counter_, email_name_length( msg.email_file_ ) );
+    if( imitation.lost_ )
       {} // Вообще ничего не отсылаем, как будто запрос потерялся
          // где-то по дороге.
     else {
       // Для имитации задержки в выполнении запроса.
-      const auto pause = chrono::milliseconds( msg.email_file_.length() * 10 );
-      if( 0 == (counter_ % 7) )
+      const auto pause = imitation.pause_;
+      if( time_left( msg.deadline_, pause ) < pause )
+        // Результат все равно опоздает.
+        send< load_email_failed >( msg.reply_to_, "deadline exceeded" );
+      else if( imitation.failed_ )
         // Пришло время отослать отрицательный результат.
         send_delayed< load_email_failed >( so_environment(),
             msg.reply_to_, pause, "IO-operation failed" );
       else
         send_delayed< load_email_succeed >( so_environment(),
-            msg.reply_to_, pause, string() );
+            msg.reply_to_, pause,
+            email_content{ acquire_charged_arena( msg, 0 ), "", 0 } );
     }
   }
+
+  // Перед чтением оценка, с которой email был принят в работу,
+  // заменяется фактическим размером файла, а арена email-а начинает
+  // учитывать свои блоки в том же бюджете.
+  static email_arena_ref acquire_charged_arena(
+    const load_email_request & msg,
+    size_t file_size )
+  {
+    auto memory = msg.memory_ ?
+        msg.memory_ : make_memory_ticket( global_memory_budget(), 0 );
+    memory->settle( file_size );
+
+    auto arena = acquire_email_arena();
+    arena->charge_to( move(memory) );
+    return arena;
+  }
+
+  // Большой файл, в котором находится email, или nullptr, если email-а
+  // в нем нет.
+  static shared_ptr< const mail_source > find_source( const load_email_request & msg ) {
+    auto source = global_mail_sources().find( msg.email_file_ );
+    if( !source || msg.slice_.offset_ > source->size() ||
+        msg.slice_.length_ > source->size() - msg.slice_.offset_ )
+      return nullptr;
+    return source;
+  }
+
+  void load_slice( const load_email_request & msg ) {
+    const auto source = find_source( msg );
+    if( !source )
+      send< load_email_failed >( msg.reply_to_, "no such email in source" );
+    else {
+      const auto length = static_cast< size_t >( msg.slice_.length_ );
+      send< load_email_succeed >( msg.reply_to_,
+          email_content::borrow(
+              acquire_charged_arena( msg, length ),
+              source,
+              source->data() + msg.slice_.offset_,
+              length ) );
+    }
+  }
+
+  // Порции не копируются, а берутся прямо из отображенного в память
+  // файла. Память под email в бюджете уже учтена при приеме заявки
+  // в работу с оценкой по размеру порции, поэтому здесь она
+  // не уточняется.
+  void load_chunk( const load_email_request & msg ) {
+    const auto source = find_source( msg );
+    if( !source || msg.chunk_offset_ >= msg.slice_.length_ )
+      send< load_email_failed >( msg.reply_to_, "no such email in source" );
+    else {
+      const auto length = static_cast< size_t >( min< uint64_t >(
+          msg.chunk_size_, msg.slice_.length_ - msg.chunk_offset_ ) );
+      send< load_email_chunk >( msg.reply_to_,
+          email_content::borrow(
+              acquire_email_arena(),
+              source,
+              source->data() + msg.slice_.offset_ + msg.chunk_offset_,
+              length ),
+          msg.chunk_offset_,
+          msg.chunk_offset_ + length == msg.slice_.length_ );
+    }
+  }
+
 };
 
-void make_io_agent( environment_t & env ) {
-  env.introduce_coop( []( coop_t & coop ) {
-    coop.make_agent< io_agent >();
+void make_io_agent( environment_t & env, unsigned shards = 1 ) {
+  env.introduce_coop( [shards]( coop_t & coop ) {
+    for( unsigned i = 0; i != shards; ++i )
+      coop.make_agent< io_agent >( i );
+  } );
+}
+
+// IO-агенты на заданном диспетчере.
+void make_io_agent(
+  environment_t & env,
+  unsigned shards,
+  disp_binder_unique_ptr_t binder )
+{
+  env.introduce_coop( move(binder), [shards]( coop_t & coop ) {
+    for( unsigned i = 0; i != shards; ++i )
+      coop.make_agent< io_agent >( i );
   } );
 }
 
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+//
+// Вспомогательные средства для дублирования (hedging) запросов к IO-агенту.
+//
+// Если ответ на запрос загрузки не пришел за время, за которое обычно
+// приходят 95% ответов, то такой же запрос отсылается другому IO-агенту.
+// Используется тот ответ, который придет первым.
+//
+// Чтобы дублирование не удвоило нагрузку на IO-агентов в случае их
+// общей деградации, количество дублей ограничено бюджетом: каждый
+// обычный запрос пополняет бюджет на долю дубля, а каждый дубль
+// забирает из бюджета единицу.
+//
+
+//
+// Гистограмма наблюдаемых задержек ответов IO-агента.
+//
+// Задержки раскладываются по корзинам с экспоненциально растущей
+// шириной (по 4 корзины на каждое удвоение), поэтому оценка процентиля
+// получается с точностью около 20%, а запись -- это один атомарный
+// инкремент. Гистограмма общая для всех агентов email_analyzer.
+//
+class latency_histogram {
+  static constexpr unsigned sub_buckets = 4;
+  static constexpr unsigned bucket_count = 32 * sub_buckets;
+
+public :
+  using duration = std::chrono::microseconds;
+
+  void record( duration d ) {
+    buckets_[ bucket_of( static_cast< std::uint64_t >(
+        std::max< duration::rep >( d.count(), 1 ) ) ) ]
+        .fetch_add( 1, std::memory_order_relaxed );
+    total_.fetch_add( 1, std::memory_order_relaxed );
+  }
+
+  std::uint64_t samples() const {
+    return total_.load( std::memory_order_relaxed );
+  }
+
+  // Верхняя граница корзины, в которую попадает заданный процентиль.
+  duration percentile( double p ) const {
+    const auto total = samples();
+    const auto threshold = static_cast< std::uint64_t >(
+        static_cast< double >( total ) * p );
+
+    std::uint64_t seen = 0;
+    for( unsigned i = 0; i != bucket_count; ++i ) {
+      seen += buckets_[ i ].load( std::memory_order_relaxed );
+      if( seen > threshold )
+        return duration( upper_bound_of( i ) );
+    }
+    return duration( upper_bound_of( bucket_count - 1 ) );
+  }
+
+private :
+  std::array< std::atomic< std::uint64_t >, bucket_count > buckets_{};
+  std::atomic< std::uint64_t > total_{ 0 };
+
+  static unsigned bucket_of( std::uint64_t v ) {
+    unsigned log2 = 0;
+    while( (v >> log2) > 1 ) ++log2;
+    // Старший бит задает номер удвоения, два следующих -- номер
+    // корзины внутри удвоения.
+    const auto sub = log2 >= 2 ?
+        static_cast< unsigned >( (v >> (log2 - 2)) & (sub_buckets - 1) ) : 0u;
+    return std::min( log2 * sub_buckets + sub, bucket_count - 1 );
+  }
+
+  static std::uint64_t upper_bound_of( unsigned bucket ) {
+    const unsigned log2 = bucket / sub_buckets;
+    const unsigned sub = bucket % sub_buckets;
+    if( log2 < 2 )
+      return std::uint64_t{ 2 } << log2;
+    return ((std::uint64_t{ sub_buckets } + sub + 1) << (log2 - 2));
+  }
+};
+
+//
+// Бюджет на дублирующие запросы.
+//
+// Значения хранятся в тысячных долях запроса. Каждый обычный запрос
+// добавляет в бюджет ratio дубля, но не выше max_balance.
+//
+class retry_budget {
+public :
+  retry_budget( double ratio, unsigned max_balance )
+    : deposit_( static_cast< std::int64_t >( ratio * 1000 ) )
+    , max_balance_( std::int64_t{ max_balance } * 1000 )
+  {}
+
+  void deposit() {
+    auto v = balance_.load( std::memory_order_relaxed );
+    while( v < max_balance_ &&
+        !balance_.compare_exchange_weak( v,
+            std::min( v + deposit_, max_balance_ ),
+            std::memory_order_relaxed ) )
+      ;
+  }
+
+  bool try_withdraw() {
+    auto v = balance_.load( std::memory_order_relaxed );
+    while( v >= 1000 )
+      if( balance_.compare_exchange_weak( v, v - 1000,
+          std::memory_order_relaxed ) )
+        return true;
+    return false;
+  }
+
+private :
+  const std::int64_t deposit_;
+  const std::int64_t max_balance_;
+  std::atomic< std::int64_t > balance_{ 0 };
+};
+
+//
+// Общее для всех агентов email_analyzer состояние дублирования.
+//
+class io_hedging {
+public :
+  // Пока статистики мало, используется эта задержка.
+  static constexpr std::chrono::milliseconds default_delay{ 500 };
+  // Дублировать раньше этого смысла нет.
+  static constexpr std::chrono::milliseconds min_delay{ 20 };
+  static constexpr std::uint64_t min_samples = 100;
+
+  // Задержка, после которой нужно отослать дубль.
+  std::chrono::milliseconds hedge_delay() const {
+    if( latencies_.samples() < min_samples )
+      return default_delay;
+
+    return std::max( min_delay,
+        std::chrono::duration_cast< std::chrono::milliseconds >(
+            latencies_.percentile( 0.95 ) ) );
+  }
+
+  void on_request_sent() { budget_.deposit(); }
+  bool try_hedge() { return budget_.try_withdraw(); }
+
+  void on_reply( std::chrono::steady_clock::duration latency ) {
+    latencies_.record(
+        std::chrono::duration_cast< latency_histogram::duration >( latency ) );
+  }
+
+private :
+  latency_histogram latencies_;
+  // Не более одного дубля на десять запросов, с запасом
+  // на кратковременный всплеск в 50 дублей.
+  retry_budget budget_{ 0.1, 50 };
+};
+
+constexpr std::chrono::milliseconds io_hedging::default_delay;
+constexpr std::chrono::milliseconds io_hedging::min_delay;
+constexpr std::uint64_t io_hedging::min_samples;
+
+io_hedging & global_io_hedging() {
+  static io_hedging hedging;
+  return hedging;
+}
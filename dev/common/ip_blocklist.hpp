@@ -0,0 +1,558 @@
+#pragma once
+
+#include <common/messages.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#if defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+//
+// Список заблокированных IP-адресов (в виде CIDR-префиксов) и поиск
+// в нем по наибольшему совпадающему префиксу.
+//
+// Префиксы хранятся в сжатом многобитовом дереве в стиле Poptrie: каждый
+// узел покрывает 6 бит адреса (64 варианта), но хранит не 64 ссылки,
+// а две 64-битовые маски. По маске vector_ определяется, есть ли для
+// варианта дочерний узел, а по маске leafvec_ -- где начинаются серии
+// одинаковых листьев. Номер дочернего узла или листа вычисляется через
+// popcount. Дочерние узлы и листья одного узла лежат в памяти подряд.
+//
+// Узел занимает 24 байта, лист -- 1 байт, поэтому миллионы префиксов
+// помещаются в десятки мегабайт.
+//
+// Первые 18 бит адреса (три уровня дерева) разбираются одним обращением
+// к таблице прямой адресации. Поэтому поиск IPv4-адреса затрагивает
+// не более четырех мест в памяти.
+//
+// Дерево после построения не меняется. Для замены списка строится новое
+// дерево, которое затем атомарно подменяет старое (см. ip_blocklist_holder).
+// Проверки, которые уже работают со старым деревом, спокойно доработают
+// с ним.
+//
+
+// IPv4- или IPv6-адрес. Адрес хранится в виде 128-битового числа,
+// старшие биты в hi_. IPv4-адрес занимает старшие 32 бита.
+struct ip_address {
+  uint64_t hi_{ 0 };
+  uint64_t lo_{ 0 };
+  bool v4_{ false };
+
+  // count (не более 64) бит адреса, начиная с бита offset. Биты за
+  // пределами адреса считаются нулевыми.
+  uint64_t bits( unsigned offset, unsigned count ) const {
+    if( !count || offset >= 128 )
+      return 0;
+
+    uint64_t v;
+    if( offset < 64 ) {
+      v = hi_ << offset;
+      if( offset )
+        v |= lo_ >> (64 - offset);
+    }
+    else
+      v = lo_ << (offset - 64);
+    return v >> (64 - count);
+  }
+};
+
+namespace ip_blocklist_details {
+
+inline unsigned popcount( uint64_t v ) {
+#if defined(_MSC_VER)
+  return static_cast< unsigned >( __popcnt64( v ) );
+#else
+  return static_cast< unsigned >( __builtin_popcountll( v ) );
+#endif
+}
+
+inline bool parse_ipv4( const char * p, const char * end, uint32_t & r ) {
+  r = 0;
+  for( int part = 0; part != 4; ++part ) {
+    if( part ) {
+      if( p == end || '.' != *p )
+        return false;
+      ++p;
+    }
+    unsigned v = 0;
+    int digits = 0;
+    for( ; p != end && *p >= '0' && *p <= '9' && digits != 3; ++p, ++digits )
+      v = v * 10 + static_cast< unsigned >( *p - '0' );
+    if( !digits || v > 255 )
+      return false;
+    r = (r << 8) | v;
+  }
+  return p == end;
+}
+
+inline int hex_digit( char c ) {
+  if( c >= '0' && c <= '9' ) return c - '0';
+  if( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+  if( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+  return -1;
+}
+
+inline bool parse_ipv6( const char * p, const char * end, uint16_t (&groups)[ 8 ] ) {
+  int count = 0;
+  int gap = -1;
+
+  if( end - p >= 2 && ':' == p[ 0 ] && ':' == p[ 1 ] ) {
+    gap = 0;
+    p += 2;
+  }
+
+  while( p != end ) {
+    if( count == 8 )
+      return false;
+
+    // В конце адреса может стоять IPv4-адрес.
+    const char * group_end = p;
+    while( group_end != end && ':' != *group_end )
+      ++group_end;
+    uint32_t v4;
+    if( group_end == end && count <= 6 && parse_ipv4( p, end, v4 ) ) {
+      groups[ count++ ] = static_cast< uint16_t >( v4 >> 16 );
+      groups[ count++ ] = static_cast< uint16_t >( v4 );
+      p = end;
+      break;
+    }
+
+    unsigned v = 0;
+    int digits = 0;
+    for( int d; p != end && digits != 4 && (d = hex_digit( *p )) >= 0; ++p, ++digits )
+      v = (v << 4) | static_cast< unsigned >( d );
+    if( !digits )
+      return false;
+    groups[ count++ ] = static_cast< uint16_t >( v );
+
+    if( p == end )
+      break;
+    if( ':' != *p )
+      return false;
+    ++p;
+    if( p != end && ':' == *p ) {
+      if( gap >= 0 )
+        return false;
+      gap = count;
+      ++p;
+    }
+    else if( p == end )
+      return false;
+  }
+
+  if( gap < 0 )
+    return 8 == count;
+  if( count == 8 )
+    return false;
+
+  // Группы после "::" сдвигаются в конец адреса.
+  const int tail = count - gap;
+  for( int i = 0; i != tail; ++i )
+    groups[ 7 - i ] = groups[ count - 1 - i ];
+  for( int i = gap; i != 8 - tail; ++i )
+    groups[ i ] = 0;
+  return true;
+}
+
+// Длина префикса после '/': только десятичные цифры, не больше max.
+inline bool parse_prefix_length( const char * p, unsigned max, unsigned & r ) {
+  // strtoul пропускает пробелы и принимает знак, а пустую строку
+  // превращает в 0, поэтому первый символ проверяется отдельно.
+  if( *p < '0' || *p > '9' )
+    return false;
+
+  char * end;
+  const auto v = strtoul( p, &end, 10 );
+  if( *end || v > max )
+    return false;
+  r = static_cast< unsigned >( v );
+  return true;
+}
+
+} /* namespace ip_blocklist_details */
+
+// Разбор текстового представления IPv4- или IPv6-адреса.
+bool parse_ip_address( const char * p, size_t size, ip_address & r ) {
+  using namespace ip_blocklist_details;
+
+  const char * end = p + size;
+  uint32_t v4;
+  if( parse_ipv4( p, end, v4 ) ) {
+    r = ip_address{ uint64_t{ v4 } << 32, 0, true };
+    return true;
+  }
+
+  uint16_t groups[ 8 ];
+  if( !parse_ipv6( p, end, groups ) )
+    return false;
+
+  r = ip_address{ 0, 0, false };
+  for( int i = 0; i != 4; ++i ) {
+    r.hi_ = (r.hi_ << 16) | groups[ i ];
+    r.lo_ = (r.lo_ << 16) | groups[ i + 4 ];
+  }
+
+  // IPv4-адреса, записанные в виде ::ffff:a.b.c.d, ищутся среди IPv4.
+  if( 0 == r.hi_ && 0xffff00000000ULL == (r.lo_ & 0xffffffff00000000ULL) )
+    r = ip_address{ (r.lo_ & 0xffffffffULL) << 32, 0, true };
+  return true;
+}
+
+//
+// Сжатое дерево префиксов одного семейства адресов.
+//
+class prefix_trie {
+public :
+  static constexpr unsigned stride = 6;
+  static constexpr unsigned direct_bits = 3 * stride;
+
+  struct prefix {
+    ip_address key_;
+    unsigned length_;
+    uint8_t value_;
+  };
+
+  prefix_trie()
+    : nodes_( 1, node{ 0, 1, 0, 0 } )
+    , leaves_( 1, 0 )
+    , direct_( size_t{ 1 } << direct_bits, leaf_flag )
+  {}
+
+  explicit prefix_trie( const vector< prefix > & prefixes ) {
+    vector< const prefix * > all;
+    all.reserve( prefixes.size() );
+    for( const auto & p : prefixes )
+      all.push_back( &p );
+    // Более длинные префиксы применяются позже и перекрывают короткие.
+    stable_sort( all.begin(), all.end(),
+        []( const prefix * a, const prefix * b ) {
+          return a->length_ < b->length_;
+        } );
+
+    nodes_.resize( 1 );
+    build( 0, all, 0, 0 );
+    build_direct();
+  }
+
+  // Значение наиболее длинного префикса, которому соответствует адрес,
+  // или 0, если таких префиксов нет.
+  uint8_t lookup( const ip_address & a ) const {
+    using ip_blocklist_details::popcount;
+
+    const auto d = direct_[ a.bits( 0, direct_bits ) ];
+    if( d & leaf_flag )
+      return static_cast< uint8_t >( d );
+
+    const node * n = &nodes_[ d ];
+    for( unsigned offset = direct_bits;; offset += stride ) {
+      const uint64_t bit = uint64_t{ 1 } << a.bits( offset, stride );
+      if( n->vector_ & bit )
+        n = &nodes_[ n->base1_ + popcount( n->vector_ & (bit - 1) ) ];
+      else
+        return leaves_[ n->base0_ + popcount( n->leafvec_ & ((bit << 1) - 1) ) - 1 ];
+    }
+  }
+
+  size_t memory_size() const {
+    return nodes_.size() * sizeof(node) + leaves_.size() +
+        direct_.size() * sizeof(uint32_t);
+  }
+
+private :
+  struct node {
+    uint64_t vector_;
+    uint64_t leafvec_;
+    uint32_t base0_;
+    uint32_t base1_;
+  };
+
+  // Элемент таблицы прямой адресации: либо номер узла на глубине
+  // direct_bits, либо (если установлен leaf_flag) значение листа.
+  static constexpr uint32_t leaf_flag = 0x80000000u;
+
+  vector< node > nodes_;
+  vector< uint8_t > leaves_;
+  vector< uint32_t > direct_;
+
+  // Построение узла, который покрывает биты [offset, offset+stride)
+  // адреса. prefixes содержит только префиксы длиннее offset, которые
+  // проходят через этот узел, упорядоченные по длине. inherited --
+  // значение самого длинного из более коротких префиксов.
+  void build(
+    size_t index,
+    const vector< const prefix * > & prefixes,
+    unsigned offset,
+    uint8_t inherited )
+  {
+    const unsigned width = 1u << stride;
+
+    uint8_t values[ width ];
+    fill( begin( values ), end( values ), inherited );
+    vector< vector< const prefix * > > children( width );
+
+    for( const auto * p : prefixes ) {
+      if( p->length_ <= offset + stride ) {
+        // Префикс целиком заканчивается в этом узле и задает значение
+        // для нескольких соседних вариантов.
+        const unsigned used = p->length_ - offset;
+        const auto first = static_cast< unsigned >(
+            p->key_.bits( offset, used ) << (stride - used) );
+        fill( values + first, values + first + (1u << (stride - used)), p->value_ );
+      }
+      else
+        children[ p->key_.bits( offset, stride ) ].push_back( p );
+    }
+
+    node n{ 0, 0,
+        static_cast< uint32_t >( leaves_.size() ),
+        static_cast< uint32_t >( nodes_.size() ) };
+    bool has_leaf = false;
+    uint8_t last_leaf = 0;
+    size_t child_count = 0;
+    for( unsigned v = 0; v != width; ++v ) {
+      if( !children[ v ].empty() ) {
+        n.vector_ |= uint64_t{ 1 } << v;
+        ++child_count;
+      }
+      else if( !has_leaf || last_leaf != values[ v ] ) {
+        n.leafvec_ |= uint64_t{ 1 } << v;
+        leaves_.push_back( values[ v ] );
+        has_leaf = true;
+        last_leaf = values[ v ];
+      }
+    }
+
+    nodes_[ index ] = n;
+    nodes_.resize( nodes_.size() + child_count );
+
+    size_t child = n.base1_;
+    for( unsigned v = 0; v != width; ++v )
+      if( !children[ v ].empty() )
+        build( child++, children[ v ], offset + stride, values[ v ] );
+  }
+
+  // Заполнение таблицы прямой адресации спуском по первым уровням дерева.
+  void build_direct() {
+    using ip_blocklist_details::popcount;
+
+    direct_.resize( size_t{ 1 } << direct_bits );
+    for( uint64_t top = 0; top != direct_.size(); ++top ) {
+      const ip_address a{ top << (64 - direct_bits), 0, false };
+      uint32_t index = 0;
+      uint32_t entry = 0;
+      for( unsigned offset = 0; offset != direct_bits; offset += stride ) {
+        const auto & n = nodes_[ index ];
+        const uint64_t bit = uint64_t{ 1 } << a.bits( offset, stride );
+        if( n.vector_ & bit )
+          index = n.base1_ + popcount( n.vector_ & (bit - 1) );
+        else {
+          entry = leaf_flag | leaves_[
+              n.base0_ + popcount( n.leafvec_ & ((bit << 1) - 1) ) - 1 ];
+          break;
+        }
+      }
+      direct_[ top ] = entry ? entry : index;
+    }
+  }
+};
+
+constexpr unsigned prefix_trie::stride;
+constexpr unsigned prefix_trie::direct_bits;
+constexpr uint32_t prefix_trie::leaf_flag;
+
+//
+// Список заблокированных адресов обоих семейств.
+//
+class ip_blocklist {
+public :
+  ip_blocklist() = default;
+
+  ip_blocklist(
+    const vector< prefix_trie::prefix > & v4,
+    const vector< prefix_trie::prefix > & v6,
+    uint64_t version = 0 )
+    : v4_( v4 ), v6_( v6 ), version_( version )
+  {}
+
+  check_status find( const ip_address & a ) const {
+    switch( (a.v4_ ? v4_ : v6_).lookup( a ) ) {
+      case 1: return check_status::suspicious;
+      case 2: return check_status::dangerous;
+    }
+    return check_status::safe;
+  }
+
+  // Отпечаток содержимого списка. Одинаковые списки имеют одинаковую
+  // версию и в разных процессах (см. verdict_store.hpp).
+  uint64_t version() const { return version_; }
+
+private :
+  prefix_trie v4_;
+  prefix_trie v6_;
+  uint64_t version_{ 0 };
+};
+
+// Загрузка списка из текстового файла. Каждая строка содержит адрес
+// или префикс (192.0.2.0/24, 2001:db8::/32) и, возможно, статус
+// (suspicious или dangerous, по умолчанию dangerous). Пустые строки и
+// строки, начинающиеся с '#', пропускаются. Строки с ошибками (адрес или
+// длина префикса не разбираются) тоже пропускаются: испорченная длина
+// не должна превращаться в /0, который блокирует все адреса.
+ip_blocklist load_ip_blocklist( const string & file_name ) {
+  ifstream file( file_name );
+  if( !file )
+    throw runtime_error( "unable to open " + file_name );
+
+  vector< prefix_trie::prefix > v4, v6;
+  uint64_t version = 0xcbf29ce484222325ULL;
+  string line, cidr, status;
+  while( getline( file, line ) ) {
+    istringstream fields( line );
+    if( !(fields >> cidr) || '#' == cidr[ 0 ] )
+      continue;
+    if( !(fields >> status) )
+      status = "dangerous";
+
+    const auto slash = cidr.find( '/' );
+    ip_address a;
+    if( !parse_ip_address( cidr.data(), min( slash, cidr.size() ), a ) )
+      continue;
+
+    // Для ::ffff:a.b.c.d/N длина задана для IPv6-адреса, и она
+    // не может быть короче 96 бит самого префикса ::ffff:0:0.
+    const bool mapped_v4 = a.v4_ && string::npos != cidr.find( ':' );
+    const unsigned max_length = a.v4_ && !mapped_v4 ? 32 : 128;
+    unsigned length = max_length;
+    if( string::npos != slash &&
+        !ip_blocklist_details::parse_prefix_length(
+            cidr.c_str() + slash + 1, max_length, length ) )
+      continue;
+    if( mapped_v4 ) {
+      if( length < 96 )
+        continue;
+      length -= 96;
+    }
+
+    const uint8_t value = "suspicious" == status ? 1 : 2;
+    (a.v4_ ? v4 : v6).push_back( prefix_trie::prefix{ a, length, value } );
+
+    version = (version ^ a.hi_) * 0x100000001b3ULL;
+    version = (version ^ a.lo_) * 0x100000001b3ULL;
+    version = (version ^ (uint64_t{ length } << 8) ^ value) * 0x100000001b3ULL;
+  }
+
+  return ip_blocklist{ v4, v6, version };
+}
+
+//
+// Хранилище текущего списка. Список можно заменить в любой момент, не
+// останавливая проверки: те, кто уже получил старый список, продолжают
+// работать с ним, пока не освободят свою ссылку.
+//
+class ip_blocklist_holder {
+public :
+  shared_ptr< const ip_blocklist > get() const {
+    return atomic_load( &current_ );
+  }
+
+  void reload( const string & file_name ) {
+    // Новый список строится до подмены, поэтому на время построения
+    // проверки продолжают использовать старый.
+    shared_ptr< const ip_blocklist > fresh =
+        make_shared< ip_blocklist >( load_ip_blocklist( file_name ) );
+    const auto version = fresh->version();
+    atomic_store( &current_, move(fresh) );
+    // Версия меняется после подмены: тот, кто увидел новую версию,
+    // уже проверяет по новому списку.
+    version_.store( version, memory_order_release );
+  }
+
+  // Версия текущего списка (0, если список не загружен).
+  uint64_t version() const {
+    return version_.load( memory_order_acquire );
+  }
+
+private :
+  shared_ptr< const ip_blocklist > current_;
+  atomic< uint64_t > version_{ 0 };
+};
+
+// Общий список. Если задана переменная окружения EMAIL_IP_BLOCKLIST,
+// то список загружается из указанного в ней файла при первом обращении.
+// Примеры обращаются к списку еще до запуска SObjectizer
+// (см. load_check_data).
+ip_blocklist_holder & global_ip_blocklist() {
+  static ip_blocklist_holder holder;
+  static const bool loaded = []{
+    if( const char * path = getenv( "EMAIL_IP_BLOCKLIST" ) )
+      holder.reload( path );
+    return true;
+  }();
+  (void)loaded;
+  return holder;
+}
+
+//
+// Агент, который следит за изменением файла со списком и перестраивает
+// список. Работает на собственной нити, чтобы построение большого
+// списка не задерживало других агентов.
+//
+class ip_blocklist_reloader final : public agent_t {
+  struct check_file : public signal_t {};
+
+public :
+  ip_blocklist_reloader( context_t ctx, string file_name )
+    : agent_t( ctx ), file_name_( move(file_name) )
+  {
+    so_subscribe_self().event< check_file >( &ip_blocklist_reloader::on_check_file );
+  }
+
+  virtual void so_evt_start() override {
+    last_modified_ = modification_time();
+    timer_ = send_periodic< check_file >( *this, 5s, 5s );
+  }
+
+private :
+  const string file_name_;
+  time_t last_modified_{ 0 };
+  timer_id_t timer_;
+
+  time_t modification_time() const {
+    struct stat st;
+    return 0 == stat( file_name_.c_str(), &st ) ? st.st_mtime : 0;
+  }
+
+  void on_check_file() {
+    const auto modified = modification_time();
+    if( !modified || modified == last_modified_ )
+      return;
+
+    try {
+      global_ip_blocklist().reload( file_name_ );
+      last_modified_ = modified;
+    }
+    catch( const exception & ) {
+      // Файл мог быть прочитан в момент записи. Попробуем еще раз
+      // при следующей проверке, а пока работаем со старым списком.
+    }
+  }
+};
+
+// Запуск ip_blocklist_reloader, если список задан через EMAIL_IP_BLOCKLIST.
+void make_ip_blocklist_reloader( environment_t & env ) {
+  if( const char * path = getenv( "EMAIL_IP_BLOCKLIST" ) )
+    env.introduce_coop(
+      disp::one_thread::create_private_disp( env )->binder(),
+      [path]( coop_t & coop ) {
+        coop.make_agent< ip_blocklist_reloader >( path );
+      } );
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <common/email_id.hpp>
+#include <common/mapped_file.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+//
+// Источник содержимого для email-ов, которые хранятся не каждый в своем
+// файле, а все вместе в одном большом хранилище (например, в mbox-файле).
+//
+// Email-ы из такого источника описываются в check_request парой
+// "смещение+длина", а IO-агент берет их содержимое прямо из источника,
+// без копирования.
+//
+class mail_source {
+public :
+  virtual ~mail_source() = default;
+
+  virtual const char * data() const = 0;
+  virtual std::size_t size() const = 0;
+};
+
+//
+// Файл, целиком отображенный в память.
+//
+class mapped_mail_file final : public mail_source {
+public :
+  explicit mapped_mail_file( const std::string & file_name )
+    : file_( file_name, file_access::sequential )
+  {}
+
+  const char * data() const override { return file_.data(); }
+  std::size_t size() const override { return file_.size(); }
+
+private :
+  const mapped_file file_;
+};
+
+//
+// Данные в памяти (например, распакованная часть сжатого mbox-а).
+//
+class memory_mail_source final : public mail_source {
+public :
+  explicit memory_mail_source( std::string data ) : data_( std::move(data) ) {}
+
+  const char * data() const override { return data_.data(); }
+  std::size_t size() const override { return data_.size(); }
+
+private :
+  const std::string data_;
+};
+
+//
+// Реестр источников. Ключом является идентификатор имени источника,
+// тот же самый, что передается в check_request::email_file_.
+//
+class mail_source_registry {
+public :
+  void add( email_id_t id, std::shared_ptr< const mail_source > source ) {
+    std::lock_guard< std::mutex > lock{ lock_ };
+    sources_[ id.value() ] = std::move(source);
+  }
+
+  void remove( email_id_t id ) {
+    std::lock_guard< std::mutex > lock{ lock_ };
+    sources_.erase( id.value() );
+  }
+
+  std::shared_ptr< const mail_source > find( email_id_t id ) const {
+    std::lock_guard< std::mutex > lock{ lock_ };
+    auto it = sources_.find( id.value() );
+    return it != sources_.end() ? it->second : nullptr;
+  }
+
+private :
+  mutable std::mutex lock_;
+  std::unordered_map< std::uint64_t, std::shared_ptr< const mail_source > > sources_;
+};
+
+mail_source_registry & global_mail_sources() {
+  static mail_source_registry registry;
+  return registry;
+}
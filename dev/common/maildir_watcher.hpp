@@ -0,0 +1,271 @@
+#pragma once
+
+#include <common/stuff.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <unordered_set>
+
+#include <dirent.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+
+//
+// Дескрипторы, через которые работает maildir_watcher.
+//
+// Создаются в main() до запуска SObjectizer Environment, чтобы
+// несуществующий Maildir или нехватка дескрипторов обнаруживались
+// при запуске с понятным сообщением, а не исключением из so_evt_start(),
+// которое аварийно завершило бы все приложение.
+//
+class maildir_watch {
+public :
+  explicit maildir_watch( const vector< string > & maildirs ) {
+    inotify_fd_ = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+    stop_fd_ = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+
+    sigset_t signals;
+    sigemptyset( &signals );
+    sigaddset( &signals, SIGINT );
+    sigaddset( &signals, SIGTERM );
+    signal_fd_ = signalfd( -1, &signals, SFD_NONBLOCK | SFD_CLOEXEC );
+
+    if( inotify_fd_ < 0 || stop_fd_ < 0 || signal_fd_ < 0 ) {
+      close_all();
+      throw runtime_error( "unable to create descriptors for maildir_watcher" );
+    }
+
+    for( const auto & m : maildirs ) {
+      const auto dir = m + "/new";
+      const int wd = inotify_add_watch( inotify_fd_, dir.c_str(),
+          IN_MOVED_TO | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_DELETE );
+      if( wd < 0 ) {
+        close_all();
+        throw runtime_error( "unable to watch " + dir + ": " + strerror( errno ) );
+      }
+      watches_.emplace( wd, dir );
+    }
+  }
+
+  ~maildir_watch() {
+    close_all();
+  }
+
+  maildir_watch( const maildir_watch & ) = delete;
+  maildir_watch & operator=( const maildir_watch & ) = delete;
+
+  int inotify_fd() const { return inotify_fd_; }
+  int stop_fd() const { return stop_fd_; }
+  int signal_fd() const { return signal_fd_; }
+
+  // Watch descriptor -> путь к каталогу new/.
+  const map< int, string > & watches() const { return watches_; }
+
+private :
+  int inotify_fd_{ -1 };
+  int stop_fd_{ -1 };
+  int signal_fd_{ -1 };
+  map< int, string > watches_;
+
+  void close_all() {
+    for( int fd : { inotify_fd_, stop_fd_, signal_fd_ } )
+      if( fd >= 0 )
+        ::close( fd );
+    inotify_fd_ = stop_fd_ = signal_fd_ = -1;
+  }
+};
+
+//
+// Агент, который отслеживает появление новых писем в каталогах new/
+// Maildir-ов и отсылает для них check_request-ы агенту-менеджеру.
+//
+// За всеми каталогами следит одна-единственная нить, которая ждет
+// событий inotify в poll(). После пробуждения вычитываются все
+// накопившиеся события (так пачка одновременно доставленных писем
+// обрабатывается за одно пробуждение), и только после этого отсылаются
+// check_request-ы. Никаких дополнительных задержек для накопления
+// пачки не делается, поэтому от появления файла до отсылки запроса
+// проходят единицы микросекунд.
+//
+// Если очередь событий inotify переполнилась (IN_Q_OVERFLOW), то
+// часть событий потеряна, и все каталоги просматриваются заново.
+// Повторная отсылка писем, проверка которых еще идет, исключается
+// за счет множества известных файлов. Файл удаляется из этого
+// множества, когда приходит результат его проверки или когда его
+// забирают из new/ (например, переносят в cur/). Поэтому множество
+// не растет вместе с количеством проверенных писем, а проверенные,
+// но оставшиеся в new/ письма после переполнения проверяются еще раз.
+//
+// Эта же нить ловит SIGINT/SIGTERM через signalfd и завершает работу
+// SObjectizer Environment. Для этого сигналы должны быть заблокированы
+// во всех нитях приложения (см. block_termination_signals()).
+//
+// Загрузка содержимого писем по-прежнему выполняется IO-агентом.
+//
+class maildir_watcher final : public agent_t {
+public :
+  maildir_watcher(
+    context_t ctx,
+    mbox_t checker_mbox,
+    unique_ptr< maildir_watch > watch )
+    : agent_t( ctx )
+    , checker_( move(checker_mbox) )
+    , watch_( move(watch) )
+    , budget_( check_budget_from_env() )
+  {
+    so_subscribe_self().event( &maildir_watcher::on_result );
+  }
+
+  virtual void so_evt_start() override {
+    results_ = make_result_sink( *this, result_sink_params_from_env() );
+
+    watcher_thread_ = thread( [this]{ watch(); } );
+  }
+
+  virtual void so_evt_finish() override {
+    const uint64_t one = 1;
+    if( watcher_thread_.joinable() ) {
+      (void)::write( watch_->stop_fd(), &one, sizeof(one) );
+      watcher_thread_.join();
+    }
+  }
+
+private :
+  const mbox_t checker_;
+  const unique_ptr< maildir_watch > watch_;
+  const chrono::milliseconds budget_;
+  mbox_t results_;
+
+  // Файлы, проверка которых еще идет. Пополняется нитью
+  // watcher_thread_, а очищается и ею, и при получении результатов.
+  mutex known_lock_;
+  unordered_set< string > known_files_;
+
+  // Используется только нитью watcher_thread_.
+  vector< string > batch_;
+
+  thread watcher_thread_;
+
+  void on_result( const check_result & msg ) {
+    {
+      lock_guard< mutex > lock{ known_lock_ };
+      known_files_.erase( email_name( msg.email_file_ ) );
+    }
+    send< check_result >( results_, msg );
+    // Каждый файл проверяется один раз, так что его имя больше
+    // не понадобится.
+    send< forget_email_name >( results_, msg.email_file_ );
+  }
+
+  void watch() {
+    // Письма, которые уже лежат в new/, тоже нужно проверить.
+    rescan();
+    flush_batch();
+
+    pollfd fds[ 3 ] = {
+        { watch_->inotify_fd(), POLLIN, 0 },
+        { watch_->stop_fd(), POLLIN, 0 },
+        { watch_->signal_fd(), POLLIN, 0 } };
+    for(;;) {
+      if( ::poll( fds, 3, -1 ) < 0 ) {
+        if( EINTR == errno ) continue;
+        break;
+      }
+
+      if( fds[ 1 ].revents )
+        break;
+      if( fds[ 2 ].revents ) {
+        so_environment().stop();
+        break;
+      }
+      if( fds[ 0 ].revents ) {
+        if( drain_events() )
+          rescan();
+        flush_batch();
+      }
+    }
+  }
+
+  // Вычитывание всех накопившихся событий. Возвращает true, если
+  // inotify сообщил о потере событий.
+  bool drain_events() {
+    alignas( inotify_event ) char buf[ 64 * 1024 ];
+    bool overflow = false;
+
+    for(;;) {
+      const auto n = ::read( watch_->inotify_fd(), buf, sizeof(buf) );
+      if( n <= 0 )
+        // EAGAIN: все накопившиеся события вычитаны.
+        break;
+
+      for( char * p = buf; p < buf + n; ) {
+        const auto * ev = reinterpret_cast< const inotify_event * >( p );
+        p += sizeof(inotify_event) + ev->len;
+
+        if( ev->mask & IN_Q_OVERFLOW ) {
+          overflow = true;
+          continue;
+        }
+        if( !ev->len )
+          continue;
+
+        auto it = watch_->watches().find( ev->wd );
+        if( it == watch_->watches().end() )
+          continue;
+
+        auto path = it->second + "/" + ev->name;
+        if( ev->mask & (IN_MOVED_FROM | IN_DELETE) ) {
+          lock_guard< mutex > lock{ known_lock_ };
+          known_files_.erase( path );
+        }
+        else
+          add_file( move(path) );
+      }
+    }
+
+    return overflow;
+  }
+
+  void rescan() {
+    for( const auto & w : watch_->watches() ) {
+      DIR * dir = ::opendir( w.second.c_str() );
+      if( !dir )
+        continue;
+
+      while( const dirent * e = ::readdir( dir ) )
+        if( '.' != e->d_name[ 0 ] )
+          add_file( w.second + "/" + e->d_name );
+
+      ::closedir( dir );
+    }
+  }
+
+  void add_file( string path ) {
+    lock_guard< mutex > lock{ known_lock_ };
+    if( known_files_.insert( path ).second )
+      batch_.push_back( move(path) );
+  }
+
+  void flush_batch() {
+    for( auto & path : batch_ )
+      send< check_request >( checker_,
+          intern_email_name( move(path) ), so_direct_mbox(),
+          email_slice_t{}, make_deadline( budget_ ) );
+    batch_.clear();
+  }
+};
+
+// Блокировка сигналов завершения работы. Должна вызываться в main()
+// до запуска SObjectizer Environment, чтобы все нити приложения
+// унаследовали эту маску, и сигналы доставлялись только через signalfd.
+void block_termination_signals() {
+  sigset_t signals;
+  sigemptyset( &signals );
+  sigaddset( &signals, SIGINT );
+  sigaddset( &signals, SIGTERM );
+  pthread_sigmask( SIG_BLOCK, &signals, nullptr );
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#else
+  #include <fstream>
+  #include <iterator>
+#endif
+
+// Как будет просматриваться содержимое файла. От этого зависит, какие
+// подсказки будут даны ядру.
+enum class file_access {
+  // Файл будет прочитан последовательно и целиком.
+  sequential,
+  // Обращения будут в случайные места файла (модели, индексы и т.п.).
+  random
+};
+
+//
+// Файл, целиком отображенный в память только для чтения.
+//
+// Там, где нет mmap (Windows), содержимое файла просто загружается
+// в память целиком.
+//
+class mapped_file {
+public :
+  explicit mapped_file(
+    const std::string & file_name,
+    file_access access = file_access::sequential )
+  {
+#if !defined(_WIN32)
+    const int fd = ::open( file_name.c_str(), O_RDONLY );
+    if( fd < 0 )
+      throw std::runtime_error( "unable to open " + file_name );
+
+    struct stat st;
+    if( ::fstat( fd, &st ) < 0 ) {
+      ::close( fd );
+      throw std::runtime_error( "unable to stat " + file_name );
+    }
+    size_ = static_cast< std::size_t >( st.st_size );
+
+    if( size_ ) {
+      void * p = ::mmap( nullptr, size_, PROT_READ, MAP_SHARED, fd, 0 );
+      if( MAP_FAILED == p ) {
+        ::close( fd );
+        throw std::runtime_error( "unable to mmap " + file_name );
+      }
+      // Если файл будет просматриваться последовательно, то пусть ядро
+      // читает его с опережением и не держит уже прочитанные страницы.
+      // MADV_WILLNEED не используется: для многогигабайтного mbox-а это
+      // чтение всего файла сразу. При случайном доступе опережающее
+      // чтение только вытесняет нужные страницы. Рекомендации madvise
+      // -- это не флаги, поэтому их нельзя объединять через '|'.
+      ::madvise( p, size_, file_access::sequential == access ?
+          MADV_SEQUENTIAL : MADV_RANDOM );
+      data_ = static_cast< const char * >( p );
+    }
+
+    // Отображение остается действительным и после закрытия файла.
+    ::close( fd );
+#else
+    (void)access;
+    std::ifstream file( file_name, std::ios::binary );
+    if( !file )
+      throw std::runtime_error( "unable to open " + file_name );
+    content_.assign( std::istreambuf_iterator< char >( file ),
+        std::istreambuf_iterator< char >() );
+#endif
+  }
+  ~mapped_file() {
+#if !defined(_WIN32)
+    if( size_ )
+      ::munmap( const_cast< char * >( data_ ), size_ );
+#endif
+  }
+
+  mapped_file( const mapped_file & ) = delete;
+  mapped_file & operator=( const mapped_file & ) = delete;
+
+#if !defined(_WIN32)
+  const char * data() const { return data_; }
+  std::size_t size() const { return size_; }
+#else
+  const char * data() const { return content_.data(); }
+  std::size_t size() const { return content_.size(); }
+#endif
+
+private :
+#if !defined(_WIN32)
+  const char * data_{ "" };
+  std::size_t size_{ 0 };
+#else
+  std::string content_;
+#endif
+};
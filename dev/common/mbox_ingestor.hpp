@@ -0,0 +1,242 @@
+#pragma once
+
+#include <common/stuff.hpp>
+#include <common/mail_source.hpp>
+#include <common/mbox_splitter.hpp>
+#include <common/compressed_mbox.hpp>
+
+//
+// Агент, который берет email-ы для проверки не из имитатора, а из
+// настоящих mbox-файлов.
+//
+// Каждый mbox-файл отображается в память, разбивается на письма
+// параллельно несколькими нитями, после чего для каждого письма
+// отсылается check_request со смещением и длиной письма внутри файла.
+// Сами письма никуда не копируются: IO-агент берет их содержимое прямо
+// из отображенного в память файла.
+//
+// Сжатые mbox-файлы (gzip, zstd) распознаются по сигнатуре и читаются
+// каждый на своей нити (см. compressed_mbox.hpp). Распакованные сегменты
+// присылаются агенту по мере готовности и регистрируются как отдельные
+// источники под именами "<файл>#<номер сегмента>", а письма из них сразу
+// же становятся в очередь на проверку. Сегмент удаляется, когда получены
+// результаты для всех его писем, а в памяти одновременно находится
+// не более max_segments сегментов.
+//
+// Чтобы не переполнить список ожидания analyzer_manager-а (и не получить
+// массу check_timedout), одновременно в обработке находится не более
+// max_in_flight писем. Следующие письма отсылаются по мере поступления
+// результатов.
+//
+class mbox_ingestor final : public agent_t {
+  struct send_next : public signal_t {};
+
+  // Очередной сегмент сжатого файла распакован.
+  struct segment_ready {
+    string file_;
+    size_t number_;
+    mbox_segment segment_;
+  };
+
+  // Чтение сжатого файла закончено.
+  struct reader_finished {
+    string file_;
+    // Описание ошибки, если чтение закончилось неудачно.
+    string error_;
+  };
+
+  struct pending_email {
+    email_id_t source_;
+    email_slice_t slice_;
+  };
+
+  static constexpr size_t segment_size = 4 * 1024 * 1024;
+  static constexpr size_t max_segments = 8;
+
+public :
+  mbox_ingestor(
+    context_t ctx,
+    mbox_t checker_mbox,
+    vector< string > files,
+    size_t max_in_flight = 256 )
+    : agent_t( ctx )
+    , checker_( move(checker_mbox) )
+    , files_( move(files) )
+    , max_in_flight_( max_in_flight )
+    , budget_( check_budget_from_env() )
+  {
+    so_subscribe_self()
+      .event< send_next >( &mbox_ingestor::on_send_next )
+      .event( &mbox_ingestor::on_result )
+      .event( &mbox_ingestor::on_segment_ready )
+      .event( &mbox_ingestor::on_reader_finished );
+  }
+
+  virtual void so_evt_start() override {
+    results_ = make_result_sink( *this, result_sink_params_from_env() );
+
+    size_t plain_files = 0;
+    for( const auto & f : files_ )
+      if( is_compressed( f ) )
+        start_reader( f );
+      else {
+        split_file( f );
+        ++plain_files;
+      }
+
+    cout << "*** " << emails_.size() << " email(s) found in "
+        << plain_files << " file(s)";
+    if( !readers_.empty() )
+      cout << ", " << readers_.size() << " compressed file(s) are being read";
+    cout << endl;
+
+    if( finished() )
+      so_environment().stop();
+    else
+      send< send_next >( *this );
+  }
+
+  virtual void so_evt_finish() override {
+    credits_.close();
+    for( auto & r : readers_ )
+      r.join();
+
+    for( const auto id : file_ids_ )
+      global_mail_sources().remove( id );
+    for( const auto & s : segments_ )
+      global_mail_sources().remove( email_id_t{ s.first } );
+  }
+
+private :
+  const mbox_t checker_;
+  const vector< string > files_;
+  const size_t max_in_flight_;
+  const chrono::milliseconds budget_;
+  mbox_t results_;
+
+  // Идентификаторы несжатых файлов, отображенных в память.
+  vector< email_id_t > file_ids_;
+
+  vector< pending_email > emails_;
+  size_t emails_sent_{ 0 };
+  size_t results_received_{ 0 };
+
+  // Нити, которые читают сжатые файлы, и сколько из них еще работает.
+  vector< thread > readers_;
+  size_t readers_running_{ 0 };
+  segment_credits credits_{ max_segments };
+  // Сколько результатов еще ждет каждый из сегментов в памяти.
+  map< uint64_t, size_t > segments_;
+
+  bool finished() const {
+    return !readers_running_ && results_received_ >= emails_.size();
+  }
+
+  static bool is_compressed( const string & file_name ) {
+    const mapped_file file( file_name, file_access::random );
+    return mbox_compression::none !=
+        detect_mbox_compression( file.data(), file.size() );
+  }
+
+  void start_reader( const string & file_name ) {
+    ++readers_running_;
+    readers_.emplace_back(
+      [this, file_name, self = so_direct_mbox()] {
+        string error;
+        try {
+          size_t number = 0;
+          read_compressed_mbox( file_name, segment_size,
+            [&]( mbox_segment segment ) {
+              if( !credits_.acquire() )
+                return false;
+              send< segment_ready >( self, file_name, number++, move(segment) );
+              return true;
+            } );
+        }
+        catch( const exception & x ) {
+          error = x.what();
+        }
+        send< reader_finished >( self, file_name, error );
+      } );
+  }
+
+  void on_segment_ready( const segment_ready & msg ) {
+    const auto source = intern_email_name(
+        msg.file_ + "#" + to_string( msg.number_ ) );
+    const auto & messages = msg.segment_.messages_;
+    if( messages.empty() ) {
+      release_email_name( source );
+      credits_.release();
+      return;
+    }
+
+    global_mail_sources().add( source, msg.segment_.source_ );
+    segments_[ source.value() ] = messages.size();
+
+    emails_.reserve( emails_.size() + messages.size() );
+    for( const auto & m : messages )
+      emails_.push_back( pending_email{
+          source, email_slice_t{ m.offset_, m.length_ } } );
+
+    on_send_next();
+  }
+
+  void on_reader_finished( const reader_finished & msg ) {
+    --readers_running_;
+    if( !msg.error_.empty() )
+      cerr << "*** " << msg.file_ << ": " << msg.error_ << endl;
+
+    if( finished() )
+      so_environment().stop();
+  }
+
+  // Когда получены все результаты для сегмента, он больше не нужен.
+  void release_segment( email_id_t source ) {
+    const auto it = segments_.find( source.value() );
+    if( it == segments_.end() || --it->second )
+      return;
+
+    segments_.erase( it );
+    global_mail_sources().remove( source );
+    send< forget_email_name >( results_, source );
+    credits_.release();
+  }
+
+  void split_file( const string & file_name ) {
+    auto file = make_shared< mapped_mail_file >( file_name );
+    const auto source = intern_email_name( file_name );
+
+    const auto messages = split_mbox( file->data(), file->size() );
+    emails_.reserve( emails_.size() + messages.size() );
+    for( const auto & m : messages )
+      emails_.push_back( pending_email{
+          source, email_slice_t{ m.offset_, m.length_ } } );
+
+    global_mail_sources().add( source, move(file) );
+    file_ids_.push_back( source );
+  }
+
+  void on_send_next() {
+    while( emails_sent_ < emails_.size() &&
+        emails_sent_ - results_received_ < max_in_flight_ ) {
+      const auto & e = emails_[ emails_sent_ ];
+      send< check_request >( checker_, e.source_, so_direct_mbox(), e.slice_,
+          make_deadline( budget_ ) );
+      ++emails_sent_;
+    }
+  }
+
+  void on_result( const check_result & msg ) {
+    send< check_result >( results_, msg );
+    release_segment( msg.email_file_ );
+
+    ++results_received_;
+    if( finished() )
+      so_environment().stop();
+    else
+      on_send_next();
+  }
+};
+
+constexpr size_t mbox_ingestor::segment_size;
+constexpr size_t mbox_ingestor::max_segments;
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
+//
+// Разбиение mbox-файла на отдельные письма.
+//
+// Каждое письмо в mbox начинается со строки "From ...". Поиск таких
+// строк выполняется параллельно: содержимое делится на равные куски,
+// каждый кусок просматривается своей нитью. Внутри куска используется
+// SSE2: за одну итерацию проверяется 16 позиций на сочетание "\nF",
+// и только для найденных кандидатов сравнивается остаток "rom ".
+//
+
+struct mbox_message_t {
+  // Смещение начала письма (сразу после строки "From ...").
+  std::uint64_t offset_;
+  // Длина письма.
+  std::uint64_t length_;
+};
+
+namespace mbox_splitter_details {
+
+const char separator[] = "From ";
+const std::size_t separator_size = sizeof(separator) - 1;
+
+// Проверка того, что с позиции pos (это начало строки) начинается
+// разделитель писем.
+bool is_separator( const char * data, std::size_t size, std::size_t pos ) {
+  return pos + separator_size <= size &&
+      0 == std::memcmp( data + pos, separator, separator_size );
+}
+
+// Поиск начал строк "From " в диапазоне [begin, end). Позиция считается
+// началом строки, если перед ней стоит '\n'. Позиция 0 проверяется
+// отдельно.
+void scan_chunk(
+  const char * data,
+  std::size_t size,
+  std::size_t begin,
+  std::size_t end,
+  std::vector< std::uint64_t > & found )
+{
+  std::size_t pos = begin;
+
+#if defined(__SSE2__)
+  const __m128i nl = _mm_set1_epi8( '\n' );
+  const __m128i f = _mm_set1_epi8( 'F' );
+  // Нужно, чтобы были доступны 17 байт: 16 для '\n' и следующие за ними.
+  while( pos + 16 <= end && pos + 17 <= size ) {
+    const auto a = _mm_loadu_si128( reinterpret_cast< const __m128i * >( data + pos ) );
+    const auto b = _mm_loadu_si128( reinterpret_cast< const __m128i * >( data + pos + 1 ) );
+    auto mask = static_cast< unsigned >( _mm_movemask_epi8(
+        _mm_and_si128( _mm_cmpeq_epi8( a, nl ), _mm_cmpeq_epi8( b, f ) ) ) );
+    while( mask ) {
+      const auto bit = static_cast< std::size_t >( __builtin_ctz( mask ) );
+      if( is_separator( data, size, pos + bit + 1 ) )
+        found.push_back( pos + bit + 1 );
+      mask &= mask - 1;
+    }
+    pos += 16;
+  }
+#endif
+
+  while( pos < end ) {
+    const void * nl = std::memchr( data + pos, '\n', end - pos );
+    if( !nl )
+      break;
+    pos = static_cast< std::size_t >( static_cast< const char * >( nl ) - data ) + 1;
+    if( is_separator( data, size, pos ) )
+      found.push_back( pos );
+  }
+}
+
+} /* namespace mbox_splitter_details */
+
+std::vector< mbox_message_t > split_mbox(
+  const char * data,
+  std::size_t size,
+  unsigned threads = std::thread::hardware_concurrency() )
+{
+  using namespace mbox_splitter_details;
+
+  // Мелкие файлы нет смысла просматривать параллельно.
+  const std::size_t min_chunk = 1024 * 1024;
+  threads = static_cast< unsigned >( std::max< std::size_t >( 1,
+      std::min< std::size_t >( std::max( threads, 1u ), size / min_chunk ) ) );
+
+  std::vector< std::vector< std::uint64_t > > found( threads );
+  const std::size_t chunk = size / threads + 1;
+  {
+    std::vector< std::thread > workers;
+    for( unsigned i = 1; i < threads; ++i )
+      workers.emplace_back( [&, i] {
+        scan_chunk( data, size, std::min( size, i * chunk ),
+            std::min( size, (i + 1) * chunk ), found[ i ] );
+      } );
+    // Первый кусок просматривается текущей нитью.
+    if( is_separator( data, size, 0 ) )
+      found[ 0 ].push_back( 0 );
+    scan_chunk( data, size, 0, std::min( size, chunk ), found[ 0 ] );
+
+    for( auto & w : workers )
+      w.join();
+  }
+
+  std::vector< std::uint64_t > starts;
+  for( auto & f : found )
+    starts.insert( starts.end(), f.begin(), f.end() );
+
+  std::vector< mbox_message_t > messages;
+  messages.reserve( starts.size() );
+  for( std::size_t i = 0; i != starts.size(); ++i ) {
+    const std::uint64_t end = i + 1 < starts.size() ? starts[ i + 1 ] : size;
+    // Сама строка "From ..." в письмо не входит.
+    const void * eol = std::memchr( data + starts[ i ], '\n',
+        static_cast< std::size_t >( end - starts[ i ] ) );
+    if( !eol )
+      continue;
+
+    const auto offset = static_cast< std::uint64_t >(
+        static_cast< const char * >( eol ) - data ) + 1;
+    if( offset < end )
+      messages.push_back( mbox_message_t{ offset, end - offset } );
+  }
+
+  return messages;
+}
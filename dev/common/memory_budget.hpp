@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+
+//
+// Учет памяти, которую занимают email-ы, находящиеся в обработке.
+//
+// Ограничение количества одновременно проверяемых email-ов не ограничивает
+// расход памяти: один email размером 50 МБ обходится дороже, чем тысячи
+// маленьких. Поэтому вся память, которая выделяется под email-ы, учитывается
+// в одном общем бюджете:
+//
+//   - analyzer_manager берет очередную заявку в работу только тогда, когда
+//     в бюджете есть место для ее предварительной оценки (admission);
+//   - загрузчик перед чтением заменяет оценку фактическим размером файла;
+//   - арена email-а учитывает каждый новый блок, поэтому в бюджет попадает
+//     и все, что создается при разборе;
+//   - распаковка вложенных архивов учитывает свои буферы на время проверки.
+//
+// Бюджет задается переменной окружения EMAIL_MEMORY_BUDGET_MB. Если она
+// не задана, то бюджет не ограничен, но учет все равно ведется.
+//
+
+class memory_budget {
+public :
+  // limit == 0 означает отсутствие ограничения.
+  explicit memory_budget( std::size_t limit = 0 ) : limit_( limit ) {}
+
+  memory_budget( const memory_budget & ) = delete;
+  memory_budget & operator=( const memory_budget & ) = delete;
+
+  // Резервирование, которое не должно выходить за ограничение.
+  bool try_reserve( std::size_t bytes ) {
+    auto used = used_.load( std::memory_order_relaxed );
+    do {
+      if( limit_ && (used + bytes > limit_) )
+        return false;
+    }
+    while( !used_.compare_exchange_weak( used, used + bytes,
+        std::memory_order_relaxed ) );
+
+    update_peak( used + bytes );
+    return true;
+  }
+
+  // Учет памяти, которая уже выделена или обязательно будет выделена.
+  // Может выходить за ограничение: в этом случае новые заявки не будут
+  // приниматься, пока память не освободится.
+  void charge( std::size_t bytes ) {
+    update_peak( used_.fetch_add( bytes, std::memory_order_relaxed ) + bytes );
+  }
+
+  void release( std::size_t bytes ) {
+    used_.fetch_sub( bytes, std::memory_order_relaxed );
+  }
+
+  std::size_t limit() const { return limit_; }
+  std::size_t used() const { return used_.load( std::memory_order_relaxed ); }
+  std::size_t peak() const { return peak_.load( std::memory_order_relaxed ); }
+
+private :
+  const std::size_t limit_;
+  std::atomic< std::size_t > used_{ 0 };
+  std::atomic< std::size_t > peak_{ 0 };
+
+  void update_peak( std::size_t used ) {
+    auto peak = peak_.load( std::memory_order_relaxed );
+    while( peak < used &&
+        !peak_.compare_exchange_weak( peak, used, std::memory_order_relaxed ) )
+      {}
+  }
+};
+
+// Общий бюджет, размер которого задается в EMAIL_MEMORY_BUDGET_MB.
+memory_budget & global_memory_budget() {
+  static memory_budget budget{ []{
+      const char * mb = std::getenv( "EMAIL_MEMORY_BUDGET_MB" );
+      return mb ? static_cast< std::size_t >( std::atol( mb ) ) << 20 : std::size_t{ 0 };
+    }() };
+  return budget;
+}
+
+//
+// Память одного email-а, учтенная в бюджете.
+//
+// Разделяется между анализатором, загрузчиком и ареной email-а,
+// поэтому вся учтенная память возвращается в бюджет тогда, когда
+// email перестает использоваться всеми ими.
+//
+class memory_reservation {
+public :
+  memory_reservation( memory_budget & budget, std::size_t estimate )
+    : budget_( budget ), estimate_( estimate ), held_( estimate )
+  {}
+  ~memory_reservation() {
+    budget_.release( held_.load( std::memory_order_relaxed ) );
+  }
+
+  memory_reservation( const memory_reservation & ) = delete;
+  memory_reservation & operator=( const memory_reservation & ) = delete;
+
+  // Замена предварительной оценки фактическим размером. Выполняется
+  // один раз, повторные вызовы (например, от дублирующего запроса
+  // к другому IO-агенту) учитывают еще одну копию.
+  void settle( std::size_t actual ) {
+    const auto estimate = estimate_.exchange( 0, std::memory_order_relaxed );
+    if( actual > estimate )
+      charge( actual - estimate );
+    else {
+      held_.fetch_sub( estimate - actual, std::memory_order_relaxed );
+      budget_.release( estimate - actual );
+    }
+  }
+
+  void charge( std::size_t bytes ) {
+    held_.fetch_add( bytes, std::memory_order_relaxed );
+    budget_.charge( bytes );
+  }
+
+  std::size_t held() const { return held_.load( std::memory_order_relaxed ); }
+
+private :
+  memory_budget & budget_;
+  std::atomic< std::size_t > estimate_;
+  std::atomic< std::size_t > held_;
+};
+
+using memory_ticket = std::shared_ptr< memory_reservation >;
+
+// Резервирование estimate байт, если бюджет это позволяет.
+// Иначе возвращается пустой указатель.
+memory_ticket try_make_memory_ticket( memory_budget & budget, std::size_t estimate ) {
+  if( !budget.try_reserve( estimate ) )
+    return memory_ticket{};
+  return std::make_shared< memory_reservation >( budget, estimate );
+}
+
+// Резервирование без проверки ограничения.
+memory_ticket make_memory_ticket( memory_budget & budget, std::size_t estimate ) {
+  budget.charge( estimate );
+  return std::make_shared< memory_reservation >( budget, estimate );
+}
+
+//
+// Временный учет памяти на время одной операции (например, буфера
+// для распаковки вложенного архива).
+//
+class scoped_memory_charge {
+public :
+  explicit scoped_memory_charge( memory_budget & budget ) : budget_( budget ) {}
+  ~scoped_memory_charge() { budget_.release( bytes_ ); }
+
+  scoped_memory_charge( const scoped_memory_charge & ) = delete;
+  scoped_memory_charge & operator=( const scoped_memory_charge & ) = delete;
+
+  void charge( std::size_t bytes ) {
+    bytes_ += bytes;
+    budget_.charge( bytes );
+  }
+
+private :
+  memory_budget & budget_;
+  std::size_t bytes_{ 0 };
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <so_5/all.hpp>
+
+#include <common/email_id.hpp>
+
+using namespace std;
+using namespace chrono_literals;
+
+using namespace so_5;
+
+//
+// Сообщения, которыми агенты-анализаторы обмениваются с внешним миром.
+//
+
+// Положение email-а внутри большого файла, в котором хранится сразу
+// много email-ов (например, mbox). Если длина нулевая, то email занимает
+// весь файл целиком.
+struct email_slice_t {
+  uint64_t offset_;
+  uint64_t length_;
+
+  bool empty() const { return 0 == length_; }
+};
+
+ostream & operator<<( ostream & to, const email_slice_t & slice ) {
+  if( !slice.empty() )
+    to << '@' << slice.offset_;
+  return to;
+}
+
+// Момент времени, после которого результат проверки уже никому
+// не нужен. Все стадии проверки сравнивают с ним текущее время и не
+// выполняют работу, результат которой заведомо опоздает.
+using deadline_t = chrono::steady_clock::time_point;
+
+// Проверка без ограничения по времени.
+const deadline_t no_deadline = deadline_t::max();
+
+bool deadline_expired( deadline_t deadline ) {
+  return deadline <= chrono::steady_clock::now();
+}
+
+// Сколько времени осталось до наступления deadline, но не больше limit.
+chrono::milliseconds time_left( deadline_t deadline, chrono::milliseconds limit ) {
+  if( no_deadline == deadline )
+    return limit;
+
+  const auto left = chrono::duration_cast< chrono::milliseconds >(
+      deadline - chrono::steady_clock::now() );
+  return max( chrono::milliseconds::zero(), min( left, limit ) );
+}
+
+// Сообщение для проверки одного файла с email-ом.
+struct check_request {
+  // Идентификатор проверяемого файла.
+  email_id_t email_file_;
+  // Кому нужно отослать результат проверки.
+  so_5::mbox_t reply_to_;
+  // Где именно в файле находится email.
+  email_slice_t slice_{};
+  // До какого момента нужно получить результат.
+  deadline_t deadline_{ no_deadline };
+};
+
+// Статус проверки, который будет возвращен в ответном сообщении.
+enum class check_status {
+  safe,
+  suspicious,
+  dangerous,
+  check_failure,
+  check_timedout
+};
+
+const char * status_name( check_status st ) {
+  const char * v = "safe";
+  if( check_status::suspicious == st ) v = "suspicious";
+  else if( check_status::dangerous == st ) v = "dangerous";
+  else if( check_status::check_failure == st ) v = "check_failure";
+  else if( check_status::check_timedout == st ) v = "check_timedout";
+
+  return v;
+}
+
+ostream & operator<<( ostream & to, check_status st ) {
+  return (to << status_name( st ));
+}
+
+// Сообщение с результатом проверки одного файла с email.
+// Содержит не только статус проверки, но и идентификатор проверяемого
+// файла. Он нужен лишь для того, чтобы облегчить сопоставление
+// получаемых результатов проверки.
+//
+// Сообщение не содержит строк и других динамических данных,
+// поэтому его копирование сводится к копированию нескольких байт.
+struct check_result {
+  email_id_t email_file_;
+  check_status status_;
+  email_slice_t slice_{};
+};
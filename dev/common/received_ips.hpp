@@ -0,0 +1,80 @@
+#pragma once
+
+#include <common/ip_blocklist.hpp>
+
+#include <cstring>
+
+//
+// Извлечение IP-адресов ретрансляторов из заголовков Received.
+//
+// Каждый почтовый сервер, через который прошел email, добавляет заголовок
+// вида
+//
+//   Received: from mail.example.com (mail.example.com [192.0.2.1])
+//       by mx.example.org with ESMTP id ...
+//
+// Адреса берутся только из квадратных скобок (в том числе в форме
+// [IPv6:2001:db8::1]), т.к. именно их записывает принимающий сервер.
+// Имена в заголовке отправитель может подставить любые. Заголовок может
+// продолжаться на следующих строках, которые начинаются с пробела
+// или табуляции.
+//
+
+namespace received_ips_details {
+
+inline bool starts_with_ci( const char * p, size_t size, const char * word ) {
+  const auto n = strlen( word );
+  if( size < n )
+    return false;
+  for( size_t i = 0; i != n; ++i ) {
+    char c = p[ i ];
+    if( c >= 'A' && c <= 'Z' )
+      c = static_cast< char >( c + 32 );
+    if( c != word[ i ] )
+      return false;
+  }
+  return true;
+}
+
+template< typename F >
+void scan_brackets( const char * p, size_t size, F && on_address ) {
+  const char * end = p + size;
+  while( nullptr != (p = static_cast< const char * >( memchr( p, '[', end - p ) )) ) {
+    ++p;
+    const auto * close = static_cast< const char * >( memchr( p, ']', end - p ) );
+    if( !close )
+      break;
+
+    const char * first = p;
+    if( starts_with_ci( first, close - first, "ipv6:" ) )
+      first += 5;
+
+    ip_address a;
+    if( parse_ip_address( first, static_cast< size_t >( close - first ), a ) )
+      on_address( a );
+    p = close + 1;
+  }
+}
+
+} /* namespace received_ips_details */
+
+template< typename Headers, typename F >
+void for_each_received_ip( const Headers & headers, F && on_address ) {
+  using namespace received_ips_details;
+
+  bool in_received = false;
+  for( const auto & h : headers ) {
+    if( h.empty() )
+      continue;
+
+    if( ' ' == h[ 0 ] || '\t' == h[ 0 ] ) {
+      if( !in_received )
+        continue;
+    }
+    else
+      in_received = starts_with_ci( h.data(), h.size(), "received:" );
+
+    if( in_received )
+      scan_brackets( h.data(), h.size(), on_address );
+  }
+}
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <common/messages.hpp>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+//
+// Агент для сохранения результатов проверки.
+//
+// Вывод результатов на консоль с принудительным сбросом буфера после
+// каждой строки обходится дорого. Поэтому результаты отсылаются этому
+// агенту, а он накапливает их в буфере и записывает пачками на своей
+// собственной рабочей нити. Отсылка check_result агенту никогда не
+// блокирует отправителя.
+//
+// Буфер записывается, когда его размер превышает max_buffer_ или когда
+// истекает flush_interval_. Очередь входящих результатов ограничена
+// max_queued_: если запись не успевает за поступлением результатов,
+// то лишние результаты отбрасываются, а не накапливаются в памяти.
+// Отброшенные результаты подсчитываются. Их количество записывается
+// в результаты отдельной записью примерно в том месте, где они были
+// бы выведены, а общее количество выводится в stderr при завершении.
+//
+// Имена email-ов агент берет из таблицы интернирования уже после того,
+// как результат был ему отослан. Поэтому отправитель, которому имя
+// больше не нужно, не освобождает его сам, а отсылает агенту
+// forget_email_name вслед за последним результатом с этим именем.
+//
+
+// Имя email-а больше не нужно отправителю результатов и может быть
+// освобождено после вывода уже отосланных результатов.
+struct forget_email_name {
+  email_id_t email_file_;
+};
+
+// Формат записи результатов.
+enum class result_format {
+  // "email -> status", как выводилось раньше.
+  text,
+  // Один JSON-объект на строку.
+  jsonl,
+  // Компактные двоичные записи (см. result_sink::append_binary).
+  binary
+};
+
+struct result_sink_params {
+  // Куда писать результаты. "-" означает стандартный поток вывода.
+  string path_{ "-" };
+  result_format format_{ result_format::text };
+  // Сколько байт можно накопить перед принудительной записью.
+  size_t max_buffer_{ 64 * 1024 };
+  // Сколько результатов может ждать своей очереди.
+  unsigned max_queued_{ 100000 };
+  // Как часто записывать неполный буфер.
+  chrono::milliseconds flush_interval_{ 100 };
+};
+
+// Параметры могут задаваться через переменные окружения:
+// EMAIL_RESULTS, EMAIL_RESULTS_FORMAT (text, jsonl, binary)
+// и EMAIL_RESULTS_FLUSH_MS. Неизвестный формат считается ошибкой,
+// иначе результаты молча записывались бы не в том формате.
+result_sink_params result_sink_params_from_env() {
+  result_sink_params params;
+
+  if( const char * path = getenv( "EMAIL_RESULTS" ) )
+    params.path_ = path;
+
+  if( const char * format = getenv( "EMAIL_RESULTS_FORMAT" ) ) {
+    const string f{ format };
+    if( "text" == f ) params.format_ = result_format::text;
+    else if( "jsonl" == f ) params.format_ = result_format::jsonl;
+    else if( "binary" == f ) params.format_ = result_format::binary;
+    else
+      throw runtime_error( "unknown EMAIL_RESULTS_FORMAT: " + f );
+  }
+
+  if( const char * ms = getenv( "EMAIL_RESULTS_FLUSH_MS" ) )
+    params.flush_interval_ = chrono::milliseconds( atol( ms ) );
+
+  return params;
+}
+
+class result_sink final : public agent_t {
+  struct flush_buffer : public signal_t {};
+  // Часть результатов была отброшена.
+  struct results_dropped : public signal_t {};
+
+public :
+  result_sink( context_t ctx, result_sink_params params )
+    : agent_t( ctx
+        // Лишний результат только подсчитывается. Счетчик увеличивается
+        // на нити отправителя, поэтому он атомарный.
+        + limit_then_transform( params.max_queued_,
+            [this]( const check_result & ) {
+              dropped_.fetch_add( 1, memory_order_relaxed );
+              return make_transformed< results_dropped >( so_direct_mbox() );
+            } )
+        + limit_then_drop< results_dropped >( 1 )
+        // Если запрос отброшен, то имя просто останется в таблице.
+        + limit_then_drop< forget_email_name >( params.max_queued_ )
+        + limit_then_drop< flush_buffer >( 1 ) )
+    , params_( move(params) )
+  {
+    so_subscribe_self()
+      .event( &result_sink::on_result )
+      .event( &result_sink::on_forget )
+      .event< flush_buffer >( &result_sink::on_flush )
+      .event< results_dropped >( &result_sink::append_dropped );
+  }
+
+  virtual void so_evt_start() override {
+    if( "-" == params_.path_ )
+      out_ = stdout;
+    else {
+      out_ = fopen( params_.path_.c_str(), "wb" );
+      if( !out_ )
+        throw runtime_error( "unable to open " + params_.path_ );
+    }
+
+    buffer_.reserve( params_.max_buffer_ + 1024 );
+    if( result_format::binary == params_.format_ )
+      buffer_.append( "ESR1", 4 );
+
+    flush_timer_ = send_periodic< flush_buffer >( *this,
+        params_.flush_interval_, params_.flush_interval_ );
+  }
+
+  virtual void so_evt_finish() override {
+    append_dropped();
+    on_flush();
+    if( reported_dropped_ )
+      cerr << "*** " << reported_dropped_ << " result(s) dropped: "
+          "output did not keep up" << endl;
+    if( out_ && stdout != out_ )
+      fclose( out_ );
+  }
+
+private :
+  const result_sink_params params_;
+
+  FILE * out_{ nullptr };
+  string buffer_;
+  // Имя email-а для форматов, в которых оно не дописывается в buffer_
+  // как есть. Строка используется повторно, чтобы не выделять память
+  // под каждое имя.
+  string name_;
+  timer_id_t flush_timer_;
+
+  atomic< size_t > dropped_{ 0 };
+  // Сколько отброшенных результатов уже отмечено в выводе.
+  size_t reported_dropped_{ 0 };
+
+  void on_result( const check_result & msg ) {
+    switch( params_.format_ ) {
+      case result_format::text: append_text( msg ); break;
+      case result_format::jsonl: append_json( msg ); break;
+      case result_format::binary: append_binary( msg ); break;
+    }
+
+    if( buffer_.size() >= params_.max_buffer_ )
+      on_flush();
+  }
+
+  // Запись о результатах, отброшенных после предыдущей такой записи.
+  void append_dropped() {
+    const auto total = dropped_.load( memory_order_relaxed );
+    const auto count = total - reported_dropped_;
+    if( !count )
+      return;
+    reported_dropped_ = total;
+
+    switch( params_.format_ ) {
+      case result_format::text:
+        buffer_ += "*** " + to_string( count ) + " result(s) dropped\n";
+        break;
+
+      case result_format::jsonl:
+        buffer_ += "{\"dropped\":" + to_string( count ) + "}\n";
+        break;
+
+      case result_format::binary:
+        append_binary_record( dropped_marker, count, "", 0 );
+        break;
+    }
+  }
+
+  void on_forget( const forget_email_name & msg ) {
+    release_email_name( msg.email_file_ );
+  }
+
+  void on_flush() {
+    if( !buffer_.empty() && out_ ) {
+      fwrite( buffer_.data(), 1, buffer_.size(), out_ );
+      fflush( out_ );
+    }
+    buffer_.clear();
+  }
+
+  const string & load_name( email_id_t id ) {
+    name_.clear();
+    append_email_name( id, name_ );
+    return name_;
+  }
+
+  void append_text( const check_result & msg ) {
+    append_email_name( msg.email_file_, buffer_ );
+    if( !msg.slice_.empty() ) {
+      buffer_ += '@';
+      buffer_ += to_string( msg.slice_.offset_ );
+    }
+    buffer_ += " -> ";
+    buffer_ += status_name( msg.status_ );
+    buffer_ += '\n';
+  }
+
+  void append_json( const check_result & msg ) {
+    load_name( msg.email_file_ );
+    buffer_ += "{\"email\":\"";
+    for( char c : name_ ) {
+      if( '"' == c || '\\' == c ) {
+        buffer_ += '\\';
+        buffer_ += c;
+      }
+      else if( static_cast< unsigned char >( c ) < 0x20 ) {
+        char escaped[ 8 ];
+        snprintf( escaped, sizeof(escaped), "\\u%04x", c );
+        buffer_ += escaped;
+      }
+      else
+        buffer_ += c;
+    }
+    buffer_ += "\",\"offset\":";
+    buffer_ += to_string( msg.slice_.offset_ );
+    buffer_ += ",\"status\":\"";
+    buffer_ += status_name( msg.status_ );
+    buffer_ += "\"}\n";
+  }
+
+  // Двоичная запись: статус (1 байт), смещение внутри файла (8 байт),
+  // длина имени (2 байта) и само имя. Числа записываются в порядке байт
+  // текущей платформы. В начале файла стоит сигнатура "ESR1".
+  // Запись об отброшенных результатах имеет статус dropped_marker,
+  // на месте смещения -- их количество, имя пустое.
+  static constexpr uint8_t dropped_marker = 0xff;
+
+  void append_binary( const check_result & msg ) {
+    const auto & name = load_name( msg.email_file_ );
+    append_binary_record( static_cast< uint8_t >( msg.status_ ),
+        msg.slice_.offset_, name.data(), name.size() );
+  }
+
+  void append_binary_record(
+    uint8_t status,
+    uint64_t offset,
+    const char * name,
+    size_t size )
+  {
+    const auto name_size = static_cast< uint16_t >( min< size_t >( size, 0xffff ) );
+
+    buffer_.append( reinterpret_cast< const char * >( &status ), sizeof(status) );
+    buffer_.append( reinterpret_cast< const char * >( &offset ), sizeof(offset) );
+    buffer_.append( reinterpret_cast< const char * >( &name_size ), sizeof(name_size) );
+    buffer_.append( name, name_size );
+  }
+};
+
+// Создание агента result_sink в дочерней кооперации. Агент будет работать
+// на собственной рабочей нити. Возвращается mbox, на который нужно
+// отсылать результаты.
+mbox_t make_result_sink( agent_t & parent, result_sink_params params ) {
+  mbox_t sink;
+  introduce_child_coop( parent,
+    disp::one_thread::create_private_disp( parent.so_environment() )->binder(),
+    [&]( coop_t & coop ) {
+      sink = coop.make_agent< result_sink >( move(params) )->so_direct_mbox();
+    } );
+  return sink;
+}
@@ -0,0 +1,330 @@
+#pragma once
+
+#include <common/messages.hpp>
+#include <common/mapped_file.hpp>
+
+#include <cstdlib>
+#include <cstring>
+
+// Вариант с AVX2 собирается всегда, когда компилятор умеет собирать
+// отдельные функции под AVX2 (GCC и clang для x86), а выбирается
+// во время работы, если процессор его поддерживает. С MSVC он
+// собирается только при /arch:AVX2.
+#if defined(__AVX2__) || \
+    (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)))
+  #define EMAIL_SPAM_AVX2_GATHER
+  #include <immintrin.h>
+#endif
+
+//
+// Статистическая оценка email-а линейным классификатором.
+//
+// Заголовки и тело разбиваются на слова (последовательности букв и цифр
+// без учета регистра). Каждое слово и каждая пара соседних слов
+// хэшируются в номер признака из фиксированного диапазона 2^bits и
+// в знак (+1 или -1). Оценка email-а -- это сумма весов модели для всех
+// встреченных признаков с учетом знаков плюс смещение. Сам вектор
+// признаков нигде не строится: номера признаков накапливаются пачками,
+// и для каждой пачки сразу же вычисляется вклад в сумму.
+//
+// Если процессор поддерживает AVX2, то веса для пачки выбираются
+// по восемь за раз командой gather. Специальных ключей компилятора для
+// этого не нужно: проверка выполняется во время работы (см. ниже).
+// Скорость оценки выводит self_check (проверка spam_classifier).
+//
+// Формат файла модели (числа в порядке байт текущей платформы):
+//
+//   "ESM1"                     сигнатура;
+//   uint32_t bits              размерность модели 2^bits;
+//   float bias                 смещение;
+//   float suspicious           порог для check_status::suspicious;
+//   float dangerous            порог для check_status::dangerous;
+//   float weights[ 2^bits ]    веса признаков.
+//
+// Файл отображается в память и не копируется.
+//
+
+namespace spam_classifier_details {
+
+// Хэш-значения для слов из заголовков и из тела различаются, т.к. одно
+// и то же слово в теме письма и в тексте значит разное.
+const uint64_t headers_seed = 0x6a09e667f3bcc908ULL;
+const uint64_t body_seed = 0xbb67ae8584caa73bULL;
+
+inline uint64_t finalize( uint64_t h ) {
+  h ^= h >> 31;
+  h *= 0x7fb5d329728ea185ULL;
+  h ^= h >> 27;
+  h *= 0x81dadef4bc2dd44dULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// Сумма weights[ indexes[ i ] ] со знаками из signs (в signs либо 0,
+// либо знаковый бит float-а).
+inline float scalar_signed_sum(
+  const float * weights,
+  const uint32_t * indexes,
+  const uint32_t * signs,
+  size_t count )
+{
+  float sum = 0.0f;
+  for( size_t i = 0; i < count; ++i ) {
+    const float w = weights[ indexes[ i ] ];
+    sum += signs[ i ] ? -w : w;
+  }
+  return sum;
+}
+
+#if defined(EMAIL_SPAM_AVX2_GATHER)
+
+#if !defined(__AVX2__)
+__attribute__(( target( "avx2" ) ))
+#endif
+inline float avx2_signed_gather_sum(
+  const float * weights,
+  const uint32_t * indexes,
+  const uint32_t * signs,
+  size_t count )
+{
+  size_t i = 0;
+  __m256 acc = _mm256_setzero_ps();
+  for( ; i + 8 <= count; i += 8 ) {
+    const __m256i idx = _mm256_loadu_si256(
+        reinterpret_cast< const __m256i * >( indexes + i ) );
+    const __m256i sgn = _mm256_loadu_si256(
+        reinterpret_cast< const __m256i * >( signs + i ) );
+    const __m256 w = _mm256_i32gather_ps( weights, idx, 4 );
+    acc = _mm256_add_ps( acc, _mm256_xor_ps( w, _mm256_castsi256_ps( sgn ) ) );
+  }
+
+  alignas( 32 ) float lanes[ 8 ];
+  _mm256_store_ps( lanes, acc );
+  float sum = 0.0f;
+  for( float v : lanes )
+    sum += v;
+  return sum + scalar_signed_sum( weights, indexes + i, signs + i, count - i );
+}
+
+#endif
+
+// Можно ли использовать avx2_signed_gather_sum на этом процессоре.
+inline bool avx2_gather_available() {
+#if defined(__AVX2__)
+  return true;
+#elif defined(EMAIL_SPAM_AVX2_GATHER)
+  static const bool available = __builtin_cpu_supports( "avx2" );
+  return available;
+#else
+  return false;
+#endif
+}
+
+inline float signed_gather_sum(
+  const float * weights,
+  const uint32_t * indexes,
+  const uint32_t * signs,
+  size_t count )
+{
+#if defined(EMAIL_SPAM_AVX2_GATHER)
+  if( avx2_gather_available() )
+    return avx2_signed_gather_sum( weights, indexes, signs, count );
+#endif
+  return scalar_signed_sum( weights, indexes, signs, count );
+}
+
+} /* namespace spam_classifier_details */
+
+class spam_model {
+  struct header {
+    char magic_[ 4 ];
+    uint32_t bits_;
+    float bias_;
+    float suspicious_;
+    float dangerous_;
+  };
+
+  // Накопитель признаков одного email-а.
+  class accumulator {
+    static constexpr size_t batch_size = 256;
+
+  public :
+    accumulator( const float * weights, uint32_t mask )
+      : weights_( weights ), mask_( mask )
+    {}
+
+    void add( uint64_t feature ) {
+      const auto h = spam_classifier_details::finalize( feature );
+      indexes_[ count_ ] = static_cast< uint32_t >( h ) & mask_;
+      signs_[ count_ ] = static_cast< uint32_t >( h >> 32 ) & 0x80000000u;
+      if( ++count_ == batch_size )
+        flush();
+    }
+
+    float sum() {
+      flush();
+      return sum_;
+    }
+
+  private :
+    const float * weights_;
+    const uint32_t mask_;
+
+    uint32_t indexes_[ batch_size ];
+    uint32_t signs_[ batch_size ];
+    size_t count_{ 0 };
+    float sum_{ 0.0f };
+
+    void flush() {
+      sum_ += spam_classifier_details::signed_gather_sum(
+          weights_, indexes_, signs_, count_ );
+      count_ = 0;
+    }
+  };
+
+  // Разбиение текста на слова. Каждое слово дает признак само по себе
+  // и в паре с предыдущим словом. Текст может поступать порциями,
+  // слово на границе порций при этом не разрывается.
+  class tokenizer {
+  public :
+    explicit tokenizer( uint64_t seed ) : seed_( seed ) {}
+
+    void feed( accumulator & acc, const char * data, size_t size ) {
+      const auto * p = reinterpret_cast< const unsigned char * >( data );
+      const auto * end = p + size;
+      while( p != end ) {
+        if( !in_word_ ) {
+          while( p != end && !is_token_char( *p ) )
+            ++p;
+          if( p == end )
+            break;
+
+          // FNV-1a по словам без учета регистра.
+          in_word_ = true;
+          h_ = seed_ ^ 0xcbf29ce484222325ULL;
+        }
+
+        for( ; p != end && is_token_char( *p ); ++p ) {
+          const unsigned char c = (*p >= 'A' && *p <= 'Z') ? *p + 32 : *p;
+          h_ = (h_ ^ c) * 0x100000001b3ULL;
+        }
+        if( p != end )
+          end_word( acc );
+      }
+    }
+
+    // Конец текста завершает и последнее слово.
+    void finish( accumulator & acc ) {
+      if( in_word_ )
+        end_word( acc );
+    }
+
+  private :
+    const uint64_t seed_;
+    bool in_word_{ false };
+    uint64_t h_{ 0 };
+    uint64_t previous_{ 0 };
+
+    void end_word( accumulator & acc ) {
+      in_word_ = false;
+      acc.add( h_ );
+      if( previous_ )
+        acc.add( previous_ * 31 + h_ );
+      previous_ = h_;
+    }
+  };
+
+  static bool is_token_char( unsigned char c ) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+        (c >= 'A' && c <= 'Z') || c >= 0x80;
+  }
+
+public :
+  explicit spam_model( const string & file_name )
+    : file_( file_name, file_access::random )
+  {
+    if( file_.size() < sizeof(header) )
+      throw runtime_error( "too small spam model file: " + file_name );
+
+    memcpy( &header_, file_.data(), sizeof(header) );
+    if( 0 != memcmp( header_.magic_, "ESM1", 4 ) || header_.bits_ > 30 ||
+        file_.size() < sizeof(header) + (size_t{ 1 } << header_.bits_) * sizeof(float) )
+      throw runtime_error( "invalid spam model file: " + file_name );
+
+    weights_ = reinterpret_cast< const float * >( file_.data() + sizeof(header) );
+    mask_ = static_cast< uint32_t >( (size_t{ 1 } << header_.bits_) - 1 );
+  }
+
+  template< typename Headers, typename Body >
+  float score( const Headers & headers, const Body & body ) const {
+    scorer s{ *this };
+    for( const auto & h : headers )
+      s.add_header( h.data(), h.size() );
+    s.add_body( body.data(), body.size() );
+    return s.score();
+  }
+
+  // Оценка email-а, который может поступать порциями: сначала
+  // заголовки (каждый целиком), затем тело частями.
+  class scorer {
+  public :
+    explicit scorer( const spam_model & model )
+      : model_( model ), acc_{ model.weights_, model.mask_ }
+      , body_( spam_classifier_details::body_seed )
+    {}
+
+    void add_header( const char * data, size_t size ) {
+      tokenizer t{ spam_classifier_details::headers_seed };
+      t.feed( acc_, data, size );
+      t.finish( acc_ );
+    }
+
+    void add_body( const char * data, size_t size ) {
+      body_.feed( acc_, data, size );
+    }
+
+    float score() {
+      body_.finish( acc_ );
+      return model_.header_.bias_ + acc_.sum();
+    }
+
+  private :
+    const spam_model & model_;
+    accumulator acc_;
+    tokenizer body_;
+  };
+
+  check_status classify( float score ) const {
+    if( score >= header_.dangerous_ )
+      return check_status::dangerous;
+    if( score >= header_.suspicious_ )
+      return check_status::suspicious;
+    return check_status::safe;
+  }
+
+private :
+  const mapped_file file_;
+  header header_;
+  const float * weights_;
+  uint32_t mask_;
+};
+
+// Модель, которая указана в переменной окружения EMAIL_SPAM_MODEL.
+// Если переменная не задана, то возвращается nullptr и оценка
+// не выполняется.
+const spam_model * global_spam_model() {
+  static const unique_ptr< spam_model > model = []{
+    const char * path = getenv( "EMAIL_SPAM_MODEL" );
+    return path ? make_unique< spam_model >( path ) : unique_ptr< spam_model >{};
+  }();
+  return model.get();
+}
+
+template< typename Email >
+check_status score_email( const Email & email ) {
+  const auto * model = global_spam_model();
+  if( !model )
+    return check_status::safe;
+
+  return model->classify( model->score( email.headers(), email.body() ) );
+}
@@ -1,84 +1,196 @@
 #pragma once
 
-#include <so_5/all.hpp>
+#include <common/messages.hpp>
+#include <common/email_arena.hpp>
+#include <common/result_sink.hpp>
+#include <common/timer_mechanism.hpp>
+#include <common/fuzzy_index.hpp>
+#include <common/url_extractor.hpp>
+#include <common/domain_set.hpp>
+#include <common/received_ips.hpp>
+#include <common/archive_inspector.hpp>
+#include <common/imitation.hpp>
+#include <common/bench_stats.hpp>
 
-using namespace std;
-using namespace chrono_literals;
-
-using namespace so_5;
-
-// Сообщение для проверки одного файла с email-ом.
-struct check_request {
-  // Имя проверяемого файла.
-  string email_file_;
-  // Кому нужно отослать результат проверки.
-  so_5::mbox_t reply_to_;
-};
-
-// Статус проверки, который будет возвращен в ответном сообщении.
-enum class check_status {
-  safe,
-  suspicious,
-  dangerous,
-  check_failure,
-  check_timedout
-};
-
-ostream & operator<<( ostream & to, check_status st ) {
-  const char * v = "safe";
-  if( check_status::suspicious == st ) v = "suspicious";
-  else if( check_status::dangerous == st ) v = "dangerous";
-  else if( check_status::check_failure == st ) v = "check_failure";
-  else if( check_status::check_timedout == st ) v = "check_timedout";
-
-  return (to << v);
-}
-
-// Сообщение с результатом проверки одного файла с email.
-// Содержит не только статус проверки, но и имя проверяемого файла.
-// Это имя нужно лишь для того, чтобы облегчить сопоставление
-// получаемых результатов проверки.
-struct check_result {
-  string email_file_;
-  check_status status_;
-};
+#include <cstdio>
+#include <cstring>
 
 //
 // Средства для имитации основных действий агентов.
 //
 
-string load_email_from_file( const string & file_name ) {
+email_content load_email_from_file( email_id_t email_file ) {
   // Просто имитируем паузу в зависимости от длины имени файла.
   this_thread::sleep_for( chrono::milliseconds(
-        file_name.length() * 10 ) );
-  return string();
+        email_name_length( email_file ) * 10 ) );
+  // Содержимое email-а сразу размещается в арене, из которой затем
+  // будут браться данные и для разобранного email-а.
+  return email_content{ acquire_email_arena(), "", 0 };
 }
 
-class parsed_email {
-  vector< string > headers_;
-  string body_;
-  vector< string > attachments_;
+// Разобранный email. Параметризуется аллокатором для того, чтобы все
+// его данные можно было разместить в арене email-а.
+template< typename Allocator >
+class basic_parsed_email {
+  template< typename T >
+  using rebind_t = typename allocator_traits< Allocator >::template rebind_alloc< T >;
 
 public :
+  using string_type = basic_string< char, char_traits< char >, rebind_t< char > >;
+  using strings_type = vector< string_type, rebind_t< string_type > >;
+
+  explicit basic_parsed_email( const Allocator & alloc = Allocator() )
+    : headers_( alloc ), body_( alloc ), attachments_( alloc )
+  {}
+
   const auto & headers() const { return headers_; }
   const auto & body() const { return body_; }
   const auto & attachments() const { return attachments_; }
+
+  // Очень упрощенный разбор: строки до первой пустой строки считаются
+  // заголовками, все остальное -- телом письма.
+  void parse( const char * data, size_t size ) {
+    const char * const end = data + size;
+    while( data != end ) {
+      const char * eol = static_cast< const char * >(
+          memchr( data, '\n', static_cast< size_t >(end - data) ) );
+      if( !eol ) eol = end;
+
+      const char * line_end = eol;
+      if( line_end != data && '\r' == *(line_end - 1) ) --line_end;
+      if( line_end == data ) {
+        // Пустая строка отделяет заголовки от тела.
+        data = (eol == end ? end : eol + 1);
+        break;
+      }
+
+      headers_.emplace_back( data, line_end, headers_.get_allocator() );
+      data = (eol == end ? end : eol + 1);
+    }
+    body_.assign( data, end );
+  }
+
+private :
+  strings_type headers_;
+  string_type body_;
+  strings_type attachments_;
 };
 
-shared_ptr< parsed_email > parse_email( const string & ) {
-  return make_shared< parsed_email >();
+using parsed_email = basic_parsed_email< arena_allocator< char > >;
+
+// Ссылка на разобранный email. Пока жива хотя бы одна такая ссылка,
+// жива и арена, в которой email размещен.
+class parsed_email_ref {
+public :
+  parsed_email_ref( email_arena_ref arena, const parsed_email * email )
+    : arena_( move(arena) ), email_( email )
+  {}
+
+  const parsed_email & operator*() const { return *email_; }
+  const parsed_email * operator->() const { return email_; }
+
+private :
+  email_arena_ref arena_;
+  const parsed_email * email_;
+};
+
+parsed_email_ref parse_email( const email_content & content ) {
+  // Разобранный email размещается в той же арене, что и содержимое.
+  auto arena = content.arena() ? content.arena() : acquire_email_arena();
+  auto * email = arena->create< parsed_email >( arena_allocator< char >{ *arena } );
+  email->parse( content.data(), content.size() );
+  return parsed_email_ref{ move(arena), email };
 }
 
-check_status check_headers( const vector< string > & ) {
-  return check_status::safe;
+// Адреса серверов, через которые прошел email, проверяются по списку
+// заблокированных адресов. Результатом является худший из статусов.
+template< typename Headers >
+check_status check_headers( const Headers & headers ) {
+  auto status = check_status::safe;
+
+  if( const auto blocklist = global_ip_blocklist().get() )
+    for_each_received_ip( headers, [&]( const ip_address & a ) {
+        status = max( status, blocklist->find( a ) );
+      } );
+
+  return status;
 }
 
-check_status check_body( const string & ) {
+// Тело сначала сравнивается с известным спамом по нечеткому отпечатку,
+// затем проверяется репутация доменов из ссылок. Если найдено совпадение,
+// то более дорогая проверка по сигнатурам уже не нужна.
+template< typename Body >
+check_status check_body( const Body & body ) {
+  fuzzy_hasher hasher;
+  hasher.update( body.data(), body.size() );
+  const auto status = global_fuzzy_index().find( hasher.finish() );
+  if( check_status::safe != status )
+    return status;
+
+  if( const auto * bad_domains = global_bad_domains() ) {
+    bool found = false;
+    extract_url_hosts( body.data(), body.size(),
+      [&]( const char * host, size_t size ) {
+        found = found || bad_domains->contains_domain_of( host, size );
+      } );
+    if( found )
+      return check_status::dangerous;
+  }
+
   return check_status::safe;
 }
 
-check_status check_attachments( const vector< string > & ) {
-  return check_status::safe;
+// Каждое вложение проверяется по сигнатурам, а архивы распаковываются
+// с ограничениями на глубину вложенности и объем (см. archive_inspector).
+template< typename Attachments >
+check_status check_attachments( const Attachments & attachments ) {
+  auto status = check_status::safe;
+  for( const auto & a : attachments ) {
+    status = max( status, local_archive_inspector().inspect( a.data(), a.size() ) );
+    if( check_status::dangerous == status )
+      break;
+  }
+  return status;
+}
+
+// Загрузка данных, которая выполняется до запуска SObjectizer. Если
+// файл, заданный через переменную окружения, окажется испорченным, то
+// исключение с именем этой переменной выйдет из main, а не из обработчика
+// агента, где оно аварийно завершило бы все приложение.
+template< typename Loader >
+void load_from_env( const char * name, Loader && loader ) {
+  try {
+    loader();
+  }
+  catch( const exception & x ) {
+    throw runtime_error( string( name ) + ": " + x.what() );
+  }
+}
+
+// Файлы, которые нужны проверкам, загружаются заранее, а не при первом
+// обращении в обработчике агента.
+void load_check_data() {
+  load_from_env( "EMAIL_FUZZY_DB", []{ global_fuzzy_index(); } );
+  load_from_env( "EMAIL_BAD_DOMAINS", []{ global_bad_domains(); } );
+  load_from_env( "EMAIL_IP_BLOCKLIST", []{ global_ip_blocklist(); } );
+  load_from_env( "EMAIL_IMITATION", []{ global_imitation_model(); } );
+  // Параметры вывода результатов разбираются в so_evt_start агентов,
+  // поэтому ошибку в них лучше обнаружить заранее.
+  result_sink_params_from_env();
+}
+
+// Сколько времени отводится на проверку одного email-а. Задается через
+// переменную окружения EMAIL_CHECK_BUDGET_MS. Если она не задана, то
+// время проверки не ограничивается.
+chrono::milliseconds check_budget_from_env() {
+  const char * ms = getenv( "EMAIL_CHECK_BUDGET_MS" );
+  return chrono::milliseconds( ms ? atol( ms ) : 0 );
+}
+
+// Момент, до которого должна завершиться проверка, начатая сейчас.
+deadline_t make_deadline( chrono::milliseconds budget ) {
+  return budget > chrono::milliseconds::zero() ?
+      chrono::steady_clock::now() + budget : no_deadline;
 }
 
 //
@@ -95,30 +207,58 @@ public :
     size_t total_requests )
     : agent_t( ctx )
     , checker_( move(checker_mbox) )
-    , total_requests_( total_requests )
+    , total_requests_( bench_requests_from_env() ?
+        bench_requests_from_env() : total_requests )
+    , budget_( check_budget_from_env() )
   {
+    // При замере количество запросов задается извне, а по завершении
+    // выводится строка с показателями.
+    if( bench_requests_from_env() )
+      bench_ = make_unique< bench_stats >( total_requests_ );
+
     so_subscribe_self()
       .event< initiate_next >( &requests_initiator::on_next )
       .event( &requests_initiator::on_result );
   }
 
   virtual void so_evt_start() override {
+    // Результаты выводятся не самим агентом, а отдельным агентом
+    // на собственной рабочей нити.
+    results_ = make_result_sink( *this, result_sink_params_from_env() );
+
     send< initiate_next >( *this );
   }
 
 private :
   const mbox_t checker_;
+  mbox_t results_;
 
   const size_t total_requests_;
+  const chrono::milliseconds budget_;
   size_t requests_sent_{ 0 };
   size_t results_received_{ 0 };
 
+  unique_ptr< bench_stats > bench_;
+
   void on_next() {
+    // Имя файла формируется в буфере на стеке, динамическая память
+    // потребуется только при помещении имени в таблицу интернирования.
+    char name[ 32 ];
+    const auto len = snprintf( name, sizeof(name),
+        "email_%zu.mbox", requests_sent_ );
+
+    const auto email_file = intern_email_name(
+        string( name, static_cast< size_t >(len) ) );
+    if( bench_ )
+      bench_->on_sent( email_file );
+
     // Инициируем запрос на провеку.
     send< check_request >(
         checker_,
-        "email_" + to_string( requests_sent_ ) + ".mbox",
-        so_direct_mbox() );
+        email_file,
+        so_direct_mbox(),
+        email_slice_t{},
+        make_deadline( budget_ ) );
 
     ++requests_sent_;
     if( requests_sent_ < total_requests_ )
@@ -126,17 +266,24 @@ private :
   }
 
   void on_result( const check_result & msg ) {
-    cout << msg.email_file_ << " -> " << msg.status_ << endl;
+    send< check_result >( results_, msg );
+    if( bench_ )
+      bench_->on_result( msg.email_file_ );
 
     ++results_received_;
-    if( results_received_ >= total_requests_ )
+    if( results_received_ >= total_requests_ ) {
+      if( bench_ )
+        bench_->report( cerr );
       // Работу всего приложения можно завершать.
       so_environment().stop();
+    }
   }
 };
 
 template< typename manager_type >
-void do_imitation( size_t total_requests ) {
+void do_imitation( size_t total_requests, timer_mechanism timer ) {
+  load_check_data();
+
   // Запускаем SObjectizer Environment и сразу же указываем,
   // какие действия должны быть выполнены при старте.
   // Завершение работы приложения будет выполнено когда имитатор
@@ -159,6 +306,9 @@ void do_imitation( size_t total_requests ) {
       [checker_mbox, total_requests]( coop_t & coop ) {
         coop.make_agent< requests_initiator >( checker_mbox, total_requests );
       } );
+  },
+  [timer]( environment_params_t & params ) {
+    use_timer_mechanism( params, timer );
   } );
 }
 
@@ -0,0 +1,439 @@
+#pragma once
+
+#include <common/messages.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+#if defined(__linux__)
+  #include <pthread.h>
+  #include <sched.h>
+  #include <time.h>
+#endif
+
+//
+// Размещение рабочих нитей конвейера по процессорам.
+//
+// Нити делятся на три роли:
+// - service: таймерная нить SObjectizer, IO-агенты, имитатор запросов,
+//   запись результатов и прочие одиночные нити;
+// - analyzers: пул нитей агентов email_analyzer;
+// - checkers: пул нитей агентов-checker-ов.
+//
+// Если задана переменная окружения EMAIL_PLACEMENT, то размер пулов
+// и привязка нитей к процессорам определяются по топологии машины
+// (доступные процессу CPU и их NUMA-узлы). Значение переменной:
+//
+//   auto                       один CPU под service (если CPU не меньше
+//                              четырех), остальные поровну между
+//                              analyzers и checkers;
+//   analyzers=N,checkers=M     явно заданное количество нитей, можно
+//                              добавить service=K (CPU под service)
+//                              и pin=0 (не привязывать нити).
+//
+// CPU раздаются ролям подряд в порядке NUMA-узлов, поэтому нити одной
+// роли по возможности оказываются на одном узле. Если нитей больше,
+// чем CPU, то нити не привязываются.
+//
+// В SObjectizer 5.5 нельзя вмешаться в запуск рабочих нитей
+// диспетчеров, поэтому привязка делается в два шага. Нить, которая
+// запускает SObjectizer, привязывается к CPU роли service, и все
+// создаваемые SObjectizer-ом нити наследуют эту привязку. Нить пула
+// analyzers или checkers перепривязывается к своему CPU, когда на ней
+// впервые стартует агент этой роли (см. pin_current_thread()).
+//
+// Фактическое размещение выводится в файл EMAIL_PLACEMENT_REPORT (или
+// в cerr) при завершении работы. Вместе с ним выводится измеренная
+// загрузка нитей каждой роли (процессорное время, деленное на время
+// работы) и предлагаемое по этой загрузке количество нитей, которое
+// можно указать в EMAIL_PLACEMENT при следующем запуске: размер пула
+// в SObjectizer 5.5 нельзя менять на ходу.
+//
+// Без EMAIL_PLACEMENT размеры пулов прежние, нити не привязываются.
+//
+
+enum class placement_role { service, analyzers, checkers };
+
+const char * placement_role_name( placement_role role ) {
+  const char * v = "service";
+  if( placement_role::analyzers == role ) v = "analyzers";
+  else if( placement_role::checkers == role ) v = "checkers";
+
+  return v;
+}
+
+// Доступные процессу CPU и номера их NUMA-узлов.
+struct cpu_topology {
+  vector< unsigned > cpus_;
+  vector< unsigned > nodes_;
+};
+
+namespace thread_placement_details {
+
+// Разбор списка вида "0-3,8,10-11" (формат /sys/devices/system).
+inline vector< unsigned > parse_cpu_list( const string & list ) {
+  vector< unsigned > cpus;
+  istringstream in( list );
+  string range;
+  while( getline( in, range, ',' ) ) {
+    if( range.empty() || !isdigit( static_cast< unsigned char >( range[ 0 ] ) ) )
+      continue;
+    const auto dash = range.find( '-' );
+    const auto first = static_cast< unsigned >( stoul( range.substr( 0, dash ) ) );
+    const auto last = string::npos == dash ?
+        first : static_cast< unsigned >( stoul( range.substr( dash + 1 ) ) );
+    for( auto c = first; c <= last; ++c )
+      cpus.push_back( c );
+  }
+  return cpus;
+}
+
+inline string format_cpu_list( const vector< unsigned > & cpus ) {
+  string r;
+  for( size_t i = 0; i != cpus.size(); ) {
+    size_t j = i;
+    while( j + 1 != cpus.size() && cpus[ j + 1 ] == cpus[ j ] + 1 )
+      ++j;
+    if( !r.empty() )
+      r += ',';
+    r += to_string( cpus[ i ] );
+    if( j != i )
+      r += '-' + to_string( cpus[ j ] );
+    i = j + 1;
+  }
+  return r.empty() ? string( "-" ) : r;
+}
+
+} /* namespace thread_placement_details */
+
+cpu_topology detect_cpu_topology() {
+  cpu_topology t;
+
+#if defined(__linux__)
+  // Учитываются только CPU, которые разрешены процессу (например,
+  // внутри контейнера или при запуске через taskset).
+  cpu_set_t allowed;
+  CPU_ZERO( &allowed );
+  if( 0 == sched_getaffinity( 0, sizeof(allowed), &allowed ) ) {
+    for( unsigned c = 0; c != CPU_SETSIZE; ++c )
+      if( CPU_ISSET( c, &allowed ) ) {
+        t.cpus_.push_back( c );
+        t.nodes_.push_back( 0 );
+      }
+
+    for( unsigned node = 0;; ++node ) {
+      ifstream file( "/sys/devices/system/node/node" + to_string( node ) + "/cpulist" );
+      string list;
+      if( !file || !getline( file, list ) )
+        break;
+      for( auto c : thread_placement_details::parse_cpu_list( list ) ) {
+        const auto it = find( t.cpus_.begin(), t.cpus_.end(), c );
+        if( it != t.cpus_.end() )
+          t.nodes_[ static_cast< size_t >( it - t.cpus_.begin() ) ] = node;
+      }
+    }
+  }
+#endif
+
+  if( t.cpus_.empty() )
+    for( unsigned c = 0, n = max( 1u, thread::hardware_concurrency() ); c != n; ++c ) {
+      t.cpus_.push_back( c );
+      t.nodes_.push_back( 0 );
+    }
+
+  // CPU одного узла идут подряд.
+  vector< size_t > order( t.cpus_.size() );
+  for( size_t i = 0; i != order.size(); ++i )
+    order[ i ] = i;
+  stable_sort( order.begin(), order.end(),
+      [&t]( size_t a, size_t b ) { return t.nodes_[ a ] < t.nodes_[ b ]; } );
+  cpu_topology sorted;
+  for( auto i : order ) {
+    sorted.cpus_.push_back( t.cpus_[ i ] );
+    sorted.nodes_.push_back( t.nodes_[ i ] );
+  }
+  return sorted;
+}
+
+struct placement_plan {
+  // Включено ли размещение вообще (задана ли EMAIL_PLACEMENT).
+  bool enabled_{ false };
+  bool pin_{ false };
+  size_t analyzer_threads_{ max( 1u, thread::hardware_concurrency() ) };
+  size_t checker_threads_{ 2 };
+  vector< unsigned > service_cpus_;
+  vector< unsigned > analyzer_cpus_;
+  vector< unsigned > checker_cpus_;
+
+  const vector< unsigned > & cpus_of( placement_role role ) const {
+    if( placement_role::analyzers == role ) return analyzer_cpus_;
+    if( placement_role::checkers == role ) return checker_cpus_;
+    return service_cpus_;
+  }
+};
+
+// Построение плана по значению EMAIL_PLACEMENT.
+placement_plan make_placement_plan(
+  const string & spec,
+  const cpu_topology & topology )
+{
+  placement_plan plan;
+  plan.enabled_ = true;
+
+  const auto & cpus = topology.cpus_;
+  size_t service = cpus.size() >= 4 ? 1 : 0;
+  size_t analyzers = 0, checkers = 0;
+  bool pin = true;
+
+  if( "auto" == spec ) {
+    analyzers = max< size_t >( 1, (cpus.size() - service + 1) / 2 );
+    checkers = max< size_t >( 1, cpus.size() - service - analyzers );
+  }
+  else {
+    istringstream in( spec );
+    string item;
+    while( getline( in, item, ',' ) ) {
+      const auto eq = item.find( '=' );
+      if( string::npos == eq )
+        throw runtime_error( "invalid EMAIL_PLACEMENT item: " + item );
+      const auto name = item.substr( 0, eq );
+      const auto value = static_cast< size_t >( stoul( item.substr( eq + 1 ) ) );
+      if( "analyzers" == name ) analyzers = value;
+      else if( "checkers" == name ) checkers = value;
+      else if( "service" == name ) service = value;
+      else if( "pin" == name ) pin = 0 != value;
+      else
+        throw runtime_error( "unknown EMAIL_PLACEMENT item: " + name );
+    }
+    if( !analyzers || !checkers )
+      throw runtime_error( "EMAIL_PLACEMENT must set analyzers and checkers" );
+  }
+
+  plan.analyzer_threads_ = analyzers;
+  plan.checker_threads_ = checkers;
+
+  // Если CPU на всех не хватает, то привязка только мешает.
+  plan.pin_ = pin && service + analyzers + checkers <= cpus.size();
+  if( plan.pin_ ) {
+    auto it = cpus.begin();
+    plan.service_cpus_.assign( it, it + static_cast< ptrdiff_t >( service ) );
+    it += static_cast< ptrdiff_t >( service );
+    plan.analyzer_cpus_.assign( it, it + static_cast< ptrdiff_t >( analyzers ) );
+    it += static_cast< ptrdiff_t >( analyzers );
+    plan.checker_cpus_.assign( it, it + static_cast< ptrdiff_t >( checkers ) );
+  }
+
+  return plan;
+}
+
+const placement_plan & global_placement_plan() {
+  static const placement_plan plan = []{
+    const char * spec = getenv( "EMAIL_PLACEMENT" );
+    return spec ?
+        make_placement_plan( spec, detect_cpu_topology() ) : placement_plan{};
+  }();
+  return plan;
+}
+
+namespace thread_placement_details {
+
+inline bool set_affinity( const vector< unsigned > & cpus ) {
+#if defined(__linux__)
+  if( cpus.empty() )
+    return false;
+  cpu_set_t set;
+  CPU_ZERO( &set );
+  for( auto c : cpus )
+    CPU_SET( c, &set );
+  return 0 == pthread_setaffinity_np( pthread_self(), sizeof(set), &set );
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+} /* namespace thread_placement_details */
+
+//
+// Нити пулов analyzers и checkers. Нужны для отчета о размещении.
+//
+class placement_registry {
+public :
+  struct thread_info {
+    placement_role role_;
+    // CPU, к которому привязана нить, или -1.
+    int cpu_;
+#if defined(__linux__)
+    clockid_t clock_;
+#endif
+  };
+
+  // Регистрация текущей нити и ее привязка к очередному CPU роли.
+  void add_current_thread( placement_role role, const placement_plan & plan ) {
+    thread_info info{ role, -1
+#if defined(__linux__)
+        , CLOCK_THREAD_CPUTIME_ID
+#endif
+    };
+#if defined(__linux__)
+    pthread_getcpuclockid( pthread_self(), &info.clock_ );
+#endif
+
+    lock_guard< mutex > lock{ lock_ };
+    const auto index = static_cast< size_t >( count_if(
+        threads_.begin(), threads_.end(),
+        [role]( const thread_info & t ) { return t.role_ == role; } ) );
+    const auto & cpus = plan.cpus_of( role );
+    if( plan.pin_ && !cpus.empty() ) {
+      const auto cpu = cpus[ index % cpus.size() ];
+      if( thread_placement_details::set_affinity( vector< unsigned >{ cpu } ) )
+        info.cpu_ = static_cast< int >( cpu );
+    }
+    threads_.push_back( info );
+  }
+
+  template< typename F >
+  void for_each( F && f ) const {
+    lock_guard< mutex > lock{ lock_ };
+    for( const auto & t : threads_ )
+      f( t );
+  }
+
+private :
+  mutable mutex lock_;
+  vector< thread_info > threads_;
+};
+
+placement_registry & global_placement_registry() {
+  static placement_registry registry;
+  return registry;
+}
+
+// Привязка нити, которая запускает SObjectizer, к CPU роли service.
+// Должна вызываться до запуска SObjectizer Environment.
+void apply_service_placement() {
+  const auto & plan = global_placement_plan();
+  if( plan.pin_ )
+    thread_placement_details::set_affinity( plan.service_cpus_ );
+}
+
+// Привязка текущей нити к CPU заданной роли. Выполняется только один
+// раз для каждой нити, последующие вызовы ничего не стоят.
+void pin_current_thread( placement_role role ) {
+  thread_local bool registered = false;
+  if( registered )
+    return;
+  registered = true;
+
+  const auto & plan = global_placement_plan();
+  if( plan.enabled_ )
+    global_placement_registry().add_current_thread( role, plan );
+}
+
+//
+// Агент, который периодически замеряет процессорное время нитей
+// из placement_registry и при завершении работы выводит отчет.
+//
+// Замер делается заранее, а не в момент вывода отчета, т.к. при
+// завершении работы рабочие нити пулов могут уже закончиться.
+//
+class placement_reporter final : public agent_t {
+  struct sample : public signal_t {};
+
+public :
+  placement_reporter( context_t ctx ) : agent_t( ctx ) {
+    so_subscribe_self().event< sample >( &placement_reporter::on_sample );
+  }
+
+  virtual void so_evt_start() override {
+    started_at_ = chrono::steady_clock::now();
+    timer_ = send_periodic< sample >( *this, 500ms, 500ms );
+  }
+
+  virtual void so_evt_finish() override {
+    on_sample();
+
+    const char * path = getenv( "EMAIL_PLACEMENT_REPORT" );
+    if( path ) {
+      ofstream file( path );
+      report( file );
+    }
+    else
+      report( cerr );
+  }
+
+private :
+  timer_id_t timer_;
+  chrono::steady_clock::time_point started_at_;
+  chrono::steady_clock::time_point sampled_at_;
+  // Процессорное время каждой нити из реестра (в том же порядке).
+  vector< double > cpu_seconds_;
+
+  void on_sample() {
+    vector< double > seconds;
+    global_placement_registry().for_each(
+      [&seconds]( const placement_registry::thread_info & t ) {
+        double v = -1;
+#if defined(__linux__)
+        timespec ts{};
+        if( 0 == clock_gettime( t.clock_, &ts ) )
+          v = static_cast< double >( ts.tv_sec ) + ts.tv_nsec / 1e9;
+#else
+        (void)t;
+#endif
+        seconds.push_back( v );
+      } );
+
+    // Закончившиеся нити сохраняют последнее измеренное значение.
+    for( size_t i = 0; i != seconds.size(); ++i )
+      if( seconds[ i ] < 0 && i < cpu_seconds_.size() )
+        seconds[ i ] = cpu_seconds_[ i ];
+    cpu_seconds_ = move(seconds);
+    sampled_at_ = chrono::steady_clock::now();
+  }
+
+  void report( ostream & to ) const {
+    using namespace thread_placement_details;
+
+    const auto & plan = global_placement_plan();
+    const chrono::duration< double > running = sampled_at_ - started_at_;
+
+    to << "placement: role=service cpus=" << format_cpu_list( plan.service_cpus_ ) << "\n"
+        << "placement: role=analyzers threads=" << plan.analyzer_threads_
+        << " cpus=" << format_cpu_list( plan.analyzer_cpus_ ) << "\n"
+        << "placement: role=checkers threads=" << plan.checker_threads_
+        << " cpus=" << format_cpu_list( plan.checker_cpus_ ) << "\n";
+
+    double busy[ 3 ] = {};
+    size_t i = 0;
+    global_placement_registry().for_each(
+      [&]( const placement_registry::thread_info & t ) {
+        const auto seconds = i < cpu_seconds_.size() ? cpu_seconds_[ i ] : -1.0;
+        ++i;
+        to << "placement: thread role=" << placement_role_name( t.role_ )
+            << " cpu=" << t.cpu_ << " cpu_seconds=" << max( 0.0, seconds ) << "\n";
+        busy[ static_cast< size_t >( t.role_ ) ] += max( 0.0, seconds );
+      } );
+
+    // Предлагаемое количество нитей: загрузка с запасом в 25%.
+    for( auto role : { placement_role::analyzers, placement_role::checkers } ) {
+      const auto cores = running.count() > 0 ?
+          busy[ static_cast< size_t >( role ) ] / running.count() : 0.0;
+      to << "placement: demand role=" << placement_role_name( role )
+          << " busy_cores=" << cores
+          << " suggested_threads=" << max( 1.0, ceil( cores * 1.25 ) ) << "\n";
+    }
+    to.flush();
+  }
+};
+
+void make_placement_reporter( environment_t & env ) {
+  env.introduce_coop( []( coop_t & coop ) {
+    coop.make_agent< placement_reporter >();
+  } );
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <so_5/all.hpp>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+//
+// Выбор механизма таймеров для SObjectizer Environment.
+//
+// В конвейере на каждый email приходится несколько таймеров: отложенные
+// ответы IO-агента и checker-ов, тайм-ауты ожидания ответов. Когда
+// одновременно обрабатываются сотни тысяч email-ов, от механизма
+// таймеров зависит, не станет ли нить таймеров узким местом:
+//
+// - wheel: взведение и отмена за O(1), но срабатывание с точностью до
+//   шага колеса;
+// - heap: взведение и отмена за O(log n), точное срабатывание;
+// - list: взведение за O(n) в худшем случае, подходит только если
+//   таймеров мало или у них одинаковые задержки.
+//
+// Замеры для типичной нагрузки конвейера выполняет timer_bench.
+//
+enum class timer_mechanism { wheel, heap, list };
+
+const char * timer_mechanism_name( timer_mechanism m ) {
+  const char * v = "wheel";
+  if( timer_mechanism::heap == m ) v = "heap";
+  else if( timer_mechanism::list == m ) v = "list";
+  return v;
+}
+
+// Механизм таймеров можно задать через переменную окружения EMAIL_TIMER
+// (wheel, heap или list). По умолчанию используется wheel, как и в
+// самом SObjectizer. Неизвестное имя считается ошибкой: иначе замер
+// молча выполнялся бы не с тем механизмом, который был задан.
+timer_mechanism timer_mechanism_from_env() {
+  const char * v = std::getenv( "EMAIL_TIMER" );
+  if( !v )
+    return timer_mechanism::wheel;
+
+  const std::string name{ v };
+  if( "wheel" == name ) return timer_mechanism::wheel;
+  if( "heap" == name ) return timer_mechanism::heap;
+  if( "list" == name ) return timer_mechanism::list;
+  throw std::runtime_error( "unknown EMAIL_TIMER: " + name );
+}
+
+void use_timer_mechanism(
+  so_5::environment_params_t & params,
+  timer_mechanism m )
+{
+  switch( m ) {
+    case timer_mechanism::wheel:
+      params.timer_thread( so_5::timer_wheel_factory() );
+    break;
+    case timer_mechanism::heap:
+      params.timer_thread( so_5::timer_heap_factory() );
+    break;
+    case timer_mechanism::list:
+      params.timer_thread( so_5::timer_list_factory() );
+    break;
+  }
+}
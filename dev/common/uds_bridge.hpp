@@ -0,0 +1,779 @@
+#pragma once
+
+#include <common/stuff.hpp>
+#include <common/mail_source.hpp>
+
+#include <cerrno>
+#include <climits>
+#include <deque>
+#include <limits>
+#include <unordered_map>
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+//
+// Мост для передачи check_request/check_result между процессами через
+// Unix domain sockets.
+//
+// Фронтальный процесс запускает агента bridge_front, который принимает
+// check_request-ы вместо analyzer_manager-а и раздает их нескольким
+// рабочим процессам. В каждом рабочем процессе работает собственный
+// конвейер из v7 и агент bridge_worker, который принимает запросы из
+// сокета и отсылает обратно результаты.
+//
+// Deadline запроса передается в виде оставшегося времени в миллисекундах
+// (0 -- без ограничения), т.к. часы процессов не обязаны совпадать.
+// Запросы с уже истекшим deadline в рабочие процессы не отсылаются.
+//
+
+namespace bridge_proto {
+
+enum class frame_type : uint8_t { request = 1, result = 2, ping = 3, pong = 4 };
+
+#pragma pack(push, 1)
+// Заголовок каждого кадра. За ним следует size_ байт содержимого.
+struct frame_header {
+  uint32_t size_;
+  frame_type type_;
+};
+
+// Содержимое кадра request. За ним следует имя файла.
+struct request_body {
+  uint64_t id_;
+  uint64_t offset_;
+  uint64_t length_;
+  uint32_t budget_ms_;
+  uint16_t name_size_;
+};
+
+struct result_body {
+  uint64_t id_;
+  uint8_t status_;
+};
+
+struct ping_body {
+  uint64_t stamp_;
+};
+#pragma pack(pop)
+
+// Самое длинное имя файла, которое помещается в request_body::name_size_.
+const size_t max_name_size = numeric_limits< uint16_t >::max();
+
+// Самый большой кадр: request с именем максимальной длины. Кадр,
+// заголовок которого объявляет больший размер, означает ошибку
+// в протоколе, и соединение разрывается.
+const size_t max_frame_size = sizeof(request_body) + max_name_size;
+
+//
+// Накопитель исходящих кадров.
+//
+// Заголовки кадров складываются во внутренний буфер, а имена файлов
+// не копируются в него, а забираются вместе со строкой и хранятся
+// до вызова flush(). Все накопленное отсылается одним вызовом writev.
+//
+class frame_writer {
+  struct segment {
+    // Если name_ истинно, то данные -- это names_[ index_ ], иначе они
+    // лежат в buffer_ по смещению index_.
+    bool name_;
+    size_t index_;
+    size_t size_;
+  };
+
+public :
+  bool empty() const { return segments_.empty(); }
+
+  // Возвращает false, если имя не помещается в кадр. В этом случае
+  // ничего не добавляется: обрезанное имя указывало бы на другой файл.
+  bool add_request(
+    uint64_t id,
+    string name,
+    const email_slice_t & slice,
+    deadline_t deadline )
+  {
+    if( name.size() > max_name_size )
+      return false;
+
+    const auto name_size = static_cast< uint16_t >( name.size() );
+    const auto budget = no_deadline == deadline ? 0u :
+        static_cast< uint32_t >( std::max< chrono::milliseconds::rep >( 1,
+            time_left( deadline, chrono::hours( 24 ) ).count() ) );
+    add_frame( frame_type::request,
+        request_body{ id, slice.offset_, slice.length_, budget, name_size },
+        name_size );
+    segments_.push_back( segment{ true, names_.size(), name_size } );
+    names_.push_back( move(name) );
+    return true;
+  }
+
+  void add_result( uint64_t id, check_status status ) {
+    add_frame( frame_type::result,
+        result_body{ id, static_cast< uint8_t >( status ) } );
+  }
+
+  void add_ping( frame_type type, uint64_t stamp ) {
+    add_frame( type, ping_body{ stamp } );
+  }
+
+  // Отсылка всего накопленного. Возвращает false при ошибке записи.
+  bool flush( int fd ) {
+    iovecs_.clear();
+    for( const auto & s : segments_ )
+      iovecs_.push_back( iovec{
+          const_cast< char * >( s.name_ ?
+              names_[ s.index_ ].data() : buffer_.data() + s.index_ ),
+          s.size_ } );
+
+    bool ok = true;
+    size_t first = 0;
+    while( ok && first < iovecs_.size() ) {
+      const auto count = static_cast< int >(
+          std::min< size_t >( iovecs_.size() - first, IOV_MAX ) );
+      const auto n = ::writev( fd, &iovecs_[ first ], count );
+      if( n < 0 ) {
+        ok = (EINTR == errno);
+        continue;
+      }
+      // Пропускаем то, что уже записано. Частично записанный
+      // сегмент корректируется на месте.
+      auto written = static_cast< size_t >( n );
+      while( written && first < iovecs_.size() ) {
+        auto & v = iovecs_[ first ];
+        if( written >= v.iov_len ) {
+          written -= v.iov_len;
+          ++first;
+        }
+        else {
+          v.iov_base = static_cast< char * >( v.iov_base ) + written;
+          v.iov_len -= written;
+          written = 0;
+        }
+      }
+    }
+
+    segments_.clear();
+    buffer_.clear();
+    names_.clear();
+    return ok;
+  }
+
+private :
+  vector< char > buffer_;
+  vector< string > names_;
+  vector< segment > segments_;
+  vector< iovec > iovecs_;
+
+  template< typename Body >
+  void add_frame( frame_type type, const Body & body, size_t extra = 0 ) {
+    const frame_header header{
+        static_cast< uint32_t >( sizeof(Body) + extra ), type };
+
+    const auto offset = buffer_.size();
+    const auto * h = reinterpret_cast< const char * >( &header );
+    const auto * b = reinterpret_cast< const char * >( &body );
+    buffer_.insert( buffer_.end(), h, h + sizeof(header) );
+    buffer_.insert( buffer_.end(), b, b + sizeof(body) );
+
+    // Соседние заголовки и тела объединяются в один сегмент.
+    if( !segments_.empty() && !segments_.back().name_ &&
+        segments_.back().index_ + segments_.back().size_ == offset )
+      segments_.back().size_ += sizeof(header) + sizeof(body);
+    else
+      segments_.push_back( segment{ false, offset, sizeof(header) + sizeof(body) } );
+  }
+};
+
+//
+// Разбор входящего потока байт на кадры.
+//
+// Размер кадра берется из заголовка, присланного другой стороной,
+// поэтому ему нельзя доверять: кадры больше max_frame_size не
+// принимаются, и буфер не может вырасти больше, чем на один такой кадр
+// и одну порцию чтения.
+//
+class frame_reader {
+public :
+  // Чтение очередной порции данных. Возвращает результат read().
+  ssize_t read_from( int fd ) {
+    if( buffer_.size() - filled_ < 64 * 1024 )
+      buffer_.resize( filled_ + 64 * 1024 );
+
+    ssize_t n;
+    do
+      n = ::read( fd, buffer_.data() + filled_, buffer_.size() - filled_ );
+    while( n < 0 && EINTR == errno );
+
+    if( n > 0 )
+      filled_ += static_cast< size_t >( n );
+    return n;
+  }
+
+  // Обработка всех полностью полученных кадров. Возвращает false,
+  // если встретился кадр больше max_frame_size. После этого соединение
+  // нужно разорвать, т.к. границы следующих кадров уже неизвестны.
+  template< typename Handler >
+  bool consume( Handler && handler ) {
+    size_t pos = 0;
+    while( filled_ - pos >= sizeof(frame_header) ) {
+      frame_header header;
+      memcpy( &header, buffer_.data() + pos, sizeof(header) );
+      if( header.size_ > max_frame_size )
+        return false;
+      if( filled_ - pos - sizeof(header) < header.size_ )
+        break;
+
+      handler( header.type_, buffer_.data() + pos + sizeof(header), header.size_ );
+      pos += sizeof(header) + header.size_;
+    }
+
+    memmove( buffer_.data(), buffer_.data() + pos, filled_ - pos );
+    filled_ -= pos;
+    return true;
+  }
+
+private :
+  vector< char > buffer_;
+  size_t filled_{ 0 };
+};
+
+template< typename Body >
+bool read_body( const char * data, size_t size, Body & body ) {
+  if( size < sizeof(Body) )
+    return false;
+  memcpy( &body, data, sizeof(Body) );
+  return true;
+}
+
+uint64_t now_stamp() {
+  return static_cast< uint64_t >(
+      chrono::steady_clock::now().time_since_epoch().count() );
+}
+
+int connect_to( const string & path ) {
+  const int fd = ::socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+  if( fd < 0 )
+    return -1;
+
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  strncpy( addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1 );
+  if( ::connect( fd, reinterpret_cast< sockaddr * >( &addr ), sizeof(addr) ) < 0 ) {
+    ::close( fd );
+    return -1;
+  }
+  return fd;
+}
+
+int listen_on( const string & path ) {
+  const int fd = ::socket( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0 );
+  if( fd < 0 )
+    throw runtime_error( "unable to create socket" );
+
+  ::unlink( path.c_str() );
+  sockaddr_un addr{};
+  addr.sun_family = AF_UNIX;
+  strncpy( addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1 );
+  if( ::bind( fd, reinterpret_cast< sockaddr * >( &addr ), sizeof(addr) ) < 0 ||
+      ::listen( fd, 16 ) < 0 ) {
+    ::close( fd );
+    throw runtime_error( "unable to listen on " + path );
+  }
+  return fd;
+}
+
+} /* namespace bridge_proto */
+
+//
+// Агент фронтального процесса.
+//
+// Каждый запрос отдается тому рабочему процессу, у которого сейчас
+// меньше всего необработанных запросов. Запросы отсылаются без ожидания
+// ответов на предыдущие, а все, что накопилось за время обработки
+// текущей пачки сообщений, отсылается одним writev.
+//
+// Раз в секунду каждому рабочему процессу отсылается ping. Если от
+// процесса долго ничего не было слышно, или соединение разорвано,
+// процесс считается неработоспособным, а его незавершенные запросы
+// передаются другим процессам. К потерянным процессам периодически
+// делаются попытки переподключиться.
+//
+class bridge_front final : public agent_t {
+  struct flush : public signal_t {};
+  struct check_health : public signal_t {};
+
+  // Пачка ответов, полученных нитью чтения.
+  struct results_arrived {
+    size_t worker_;
+    unsigned generation_;
+    vector< pair< uint64_t, check_status > > results_;
+  };
+
+  struct worker_lost {
+    size_t worker_;
+    unsigned generation_;
+  };
+
+  using clock = chrono::steady_clock;
+
+  struct worker {
+    string path_;
+    int fd_{ -1 };
+    // Увеличивается при каждом переподключении, чтобы отличать
+    // сообщения от нитей чтения старых соединений.
+    unsigned generation_{ 0 };
+    thread reader_;
+    bridge_proto::frame_writer writer_;
+    size_t outstanding_{ 0 };
+    clock::time_point last_seen_;
+  };
+
+  struct pending_request {
+    check_request request_;
+    size_t worker_;
+  };
+
+public :
+  bridge_front( context_t ctx, vector< string > worker_paths )
+    : agent_t( ctx )
+  {
+    for( auto & p : worker_paths ) {
+      workers_.emplace_back( new worker() );
+      workers_.back()->path_ = move(p);
+    }
+
+    so_subscribe_self()
+      .event( &bridge_front::on_check_request )
+      .event( &bridge_front::on_results )
+      .event( &bridge_front::on_worker_lost )
+      .event< flush >( &bridge_front::on_flush )
+      .event< check_health >( &bridge_front::on_check_health );
+  }
+
+  virtual void so_evt_start() override {
+    for( size_t i = 0; i != workers_.size(); ++i )
+      connect_worker( i );
+
+    health_timer_ = send_periodic< check_health >( *this, 1s, 1s );
+  }
+
+  virtual void so_evt_finish() override {
+    for( auto & w : workers_ )
+      disconnect_worker( *w );
+  }
+
+private :
+  const chrono::seconds silence_limit_{ 3 };
+
+  vector< unique_ptr< worker > > workers_;
+  unordered_map< uint64_t, pending_request > pending_;
+  uint64_t last_id_{ 0 };
+  bool flush_scheduled_{ false };
+  timer_id_t health_timer_;
+
+  void on_check_request( const check_request & msg ) {
+    const auto id = ++last_id_;
+    pending_.emplace( id, pending_request{ msg, 0 } );
+    route( id );
+  }
+
+  void on_results( const results_arrived & msg ) {
+    auto & w = *workers_[ msg.worker_ ];
+    if( w.generation_ != msg.generation_ )
+      return;
+
+    w.last_seen_ = clock::now();
+    for( const auto & r : msg.results_ ) {
+      auto it = pending_.find( r.first );
+      // Ответ мог прийти и от процесса, который уже был признан
+      // неработоспособным, поэтому проверяем, кому отдан запрос.
+      if( it == pending_.end() || it->second.worker_ != msg.worker_ )
+        continue;
+
+      const auto & req = it->second.request_;
+      send< check_result >( req.reply_to_, req.email_file_, r.second, req.slice_ );
+      --w.outstanding_;
+      pending_.erase( it );
+    }
+  }
+
+  void on_worker_lost( const worker_lost & msg ) {
+    auto & w = *workers_[ msg.worker_ ];
+    if( w.generation_ != msg.generation_ || w.fd_ < 0 )
+      return;
+
+    cerr << "*** bridge: worker " << w.path_ << " lost" << endl;
+    disconnect_worker( w );
+
+    // Все незавершенные запросы этого процесса отдаем другим.
+    // route() может удалять элементы из pending_, поэтому сначала
+    // собираем идентификаторы.
+    vector< uint64_t > orphans;
+    for( const auto & p : pending_ )
+      if( p.second.worker_ == msg.worker_ )
+        orphans.push_back( p.first );
+    for( auto id : orphans )
+      route( id );
+  }
+
+  void on_flush() {
+    flush_scheduled_ = false;
+    for( size_t i = 0; i != workers_.size(); ++i ) {
+      auto & w = *workers_[ i ];
+      if( w.fd_ >= 0 && !w.writer_.empty() && !w.writer_.flush( w.fd_ ) )
+        // Нить чтения тоже заметит разрыв соединения.
+        ::shutdown( w.fd_, SHUT_RDWR );
+    }
+  }
+
+  void on_check_health() {
+    const auto now = clock::now();
+    for( size_t i = 0; i != workers_.size(); ++i ) {
+      auto & w = *workers_[ i ];
+      if( w.fd_ < 0 )
+        connect_worker( i );
+      else if( w.last_seen_ + silence_limit_ < now )
+        // Нить чтения получит ошибку и сообщит о потере процесса.
+        ::shutdown( w.fd_, SHUT_RDWR );
+      else
+        w.writer_.add_ping( bridge_proto::frame_type::ping, bridge_proto::now_stamp() );
+    }
+    schedule_flush();
+  }
+
+  // Выбор наименее загруженного рабочего процесса для запроса.
+  void route( uint64_t id ) {
+    auto & p = pending_.at( id );
+
+    if( deadline_expired( p.request_.deadline_ ) ) {
+      send< check_result >( p.request_.reply_to_, p.request_.email_file_,
+          check_status::check_timedout, p.request_.slice_ );
+      pending_.erase( id );
+      return;
+    }
+
+    worker * target = nullptr;
+    size_t target_index = 0;
+    for( size_t i = 0; i != workers_.size(); ++i ) {
+      auto & w = *workers_[ i ];
+      if( w.fd_ >= 0 && (!target || w.outstanding_ < target->outstanding_) ) {
+        target = &w;
+        target_index = i;
+      }
+    }
+
+    if( !target ) {
+      // Отдать запрос некому.
+      send< check_result >( p.request_.reply_to_, p.request_.email_file_,
+          check_status::check_failure, p.request_.slice_ );
+      pending_.erase( id );
+      return;
+    }
+
+    if( !target->writer_.add_request( id,
+        email_name( p.request_.email_file_ ),
+        p.request_.slice_,
+        p.request_.deadline_ ) ) {
+      // Имя не помещается в кадр, рабочий процесс его не получит.
+      send< check_result >( p.request_.reply_to_, p.request_.email_file_,
+          check_status::check_failure, p.request_.slice_ );
+      pending_.erase( id );
+      return;
+    }
+
+    p.worker_ = target_index;
+    ++target->outstanding_;
+    schedule_flush();
+  }
+
+  void schedule_flush() {
+    // Все, что будет добавлено до обработки сигнала flush, уйдет
+    // одним вызовом writev.
+    if( !flush_scheduled_ ) {
+      flush_scheduled_ = true;
+      send< flush >( *this );
+    }
+  }
+
+  void connect_worker( size_t index ) {
+    auto & w = *workers_[ index ];
+    w.fd_ = bridge_proto::connect_to( w.path_ );
+    if( w.fd_ < 0 )
+      return;
+
+    ++w.generation_;
+    w.outstanding_ = 0;
+    w.last_seen_ = clock::now();
+    w.reader_ = thread( [this, index, fd = w.fd_, generation = w.generation_] {
+        read_results( index, fd, generation );
+      } );
+  }
+
+  void disconnect_worker( worker & w ) {
+    if( w.fd_ >= 0 ) {
+      ::shutdown( w.fd_, SHUT_RDWR );
+      if( w.reader_.joinable() )
+        w.reader_.join();
+      ::close( w.fd_ );
+      w.fd_ = -1;
+    }
+    w.outstanding_ = 0;
+    w.writer_ = bridge_proto::frame_writer{};
+  }
+
+  // Тело нити чтения для одного соединения.
+  void read_results( size_t index, int fd, unsigned generation ) {
+    using namespace bridge_proto;
+
+    frame_reader reader;
+    while( reader.read_from( fd ) > 0 ) {
+      vector< pair< uint64_t, check_status > > results;
+      bool heard = false;
+      const bool valid = reader.consume(
+        [&]( frame_type type, const char * data, size_t size ) {
+          heard = true;
+          result_body r;
+          if( frame_type::result == type && read_body( data, size, r ) )
+            results.emplace_back( r.id_, static_cast< check_status >( r.status_ ) );
+        } );
+      if( !valid ) {
+        cerr << "*** bridge: oversized frame from " << workers_[ index ]->path_ << endl;
+        break;
+      }
+
+      if( heard )
+        send< results_arrived >( so_direct_mbox(), index, generation, move(results) );
+    }
+
+    send< worker_lost >( so_direct_mbox(), index, generation );
+  }
+};
+
+//
+// Агент рабочего процесса.
+//
+// Принимает соединения от фронтального процесса, передает полученные
+// запросы своему analyzer_manager-у и отсылает обратно результаты.
+// Сокеты обслуживаются одной нитью.
+//
+class bridge_worker final : public agent_t {
+  struct flush : public signal_t {};
+
+  struct incoming_request {
+    uint64_t id_;
+    string name_;
+    email_slice_t slice_;
+    deadline_t deadline_;
+  };
+
+  struct requests_arrived {
+    int connection_;
+    vector< incoming_request > requests_;
+    vector< uint64_t > pings_;
+  };
+
+  struct connection_closed {
+    int connection_;
+  };
+
+  // Кому нужно вернуть результат.
+  struct waiting_request {
+    int connection_;
+    uint64_t id_;
+  };
+
+public :
+  bridge_worker( context_t ctx, mbox_t checker_mbox, string socket_path )
+    : agent_t( ctx )
+    , checker_( move(checker_mbox) )
+    , socket_path_( move(socket_path) )
+  {
+    so_subscribe_self()
+      .event( &bridge_worker::on_requests )
+      .event( &bridge_worker::on_connection_closed )
+      .event( &bridge_worker::on_result )
+      .event< flush >( &bridge_worker::on_flush );
+  }
+
+  virtual void so_evt_start() override {
+    listen_fd_ = bridge_proto::listen_on( socket_path_ );
+    stop_fd_ = eventfd( 0, EFD_CLOEXEC );
+    io_thread_ = thread( [this]{ serve(); } );
+  }
+
+  virtual void so_evt_finish() override {
+    const uint64_t one = 1;
+    (void)::write( stop_fd_, &one, sizeof(one) );
+    io_thread_.join();
+
+    for( auto & c : writers_ )
+      ::close( c.first );
+    ::close( listen_fd_ );
+    ::close( stop_fd_ );
+    ::unlink( socket_path_.c_str() );
+  }
+
+private :
+  const mbox_t checker_;
+  const string socket_path_;
+
+  int listen_fd_{ -1 };
+  int stop_fd_{ -1 };
+  thread io_thread_;
+
+  // Эти данные используются только на рабочей нити агента.
+  map< int, bridge_proto::frame_writer > writers_;
+  map< pair< uint64_t, uint64_t >, deque< waiting_request > > waiting_;
+  bool flush_scheduled_{ false };
+
+  void on_requests( const requests_arrived & msg ) {
+    auto & writer = writers_[ msg.connection_ ];
+    for( auto stamp : msg.pings_ )
+      writer.add_ping( bridge_proto::frame_type::pong, stamp );
+
+    for( const auto & r : msg.requests_ ) {
+      const auto email = intern_email_name( r.name_ );
+      if( !r.slice_.empty() )
+        ensure_source( email );
+
+      waiting_[ make_pair( email.value(), r.slice_.offset_ ) ]
+          .push_back( waiting_request{ msg.connection_, r.id_ } );
+      send< check_request >( checker_, email, so_direct_mbox(), r.slice_,
+          r.deadline_ );
+    }
+
+    schedule_flush();
+  }
+
+  void on_connection_closed( const connection_closed & msg ) {
+    // Сам сокет закрывается только здесь, чтобы его номер не мог быть
+    // повторно использован, пока для него еще есть данные.
+    writers_.erase( msg.connection_ );
+    ::close( msg.connection_ );
+  }
+
+  void on_result( const check_result & msg ) {
+    auto it = waiting_.find( make_pair( msg.email_file_.value(), msg.slice_.offset_ ) );
+    if( it == waiting_.end() )
+      return;
+
+    const auto w = it->second.front();
+    it->second.pop_front();
+    if( it->second.empty() )
+      waiting_.erase( it );
+
+    // Имя, полученное в запросе, интернировалось для каждого запроса
+    // отдельно. Имена mbox-файлов остаются в таблице вместе
+    // с отображенными файлами (см. ensure_source).
+    if( msg.slice_.empty() )
+      release_email_name( msg.email_file_ );
+
+    auto c = writers_.find( w.connection_ );
+    if( c != writers_.end() ) {
+      c->second.add_result( w.id_, msg.status_ );
+      schedule_flush();
+    }
+  }
+
+  void on_flush() {
+    flush_scheduled_ = false;
+    for( auto & c : writers_ )
+      if( !c.second.empty() && !c.second.flush( c.first ) )
+        ::shutdown( c.first, SHUT_RDWR );
+  }
+
+  void schedule_flush() {
+    if( !flush_scheduled_ ) {
+      flush_scheduled_ = true;
+      send< flush >( *this );
+    }
+  }
+
+  // Email-ы из mbox-файлов берутся из того же файла, что и во
+  // фронтальном процессе. Файл отображается в память при первом
+  // обращении к нему.
+  static void ensure_source( email_id_t source ) {
+    if( global_mail_sources().find( source ) )
+      return;
+    try {
+      global_mail_sources().add( source,
+          make_shared< mapped_mail_file >( email_name( source ) ) );
+    }
+    catch( const exception & ) {
+      // IO-агент ответит load_email_failed.
+    }
+  }
+
+  // Тело нити, обслуживающей сокеты.
+  void serve() {
+    using namespace bridge_proto;
+
+    map< int, frame_reader > readers;
+    vector< pollfd > fds;
+    for(;;) {
+      fds.clear();
+      fds.push_back( pollfd{ stop_fd_, POLLIN, 0 } );
+      fds.push_back( pollfd{ listen_fd_, POLLIN, 0 } );
+      for( const auto & r : readers )
+        fds.push_back( pollfd{ r.first, POLLIN, 0 } );
+
+      if( ::poll( fds.data(), fds.size(), -1 ) < 0 ) {
+        if( EINTR == errno ) continue;
+        break;
+      }
+
+      if( fds[ 0 ].revents )
+        break;
+
+      if( fds[ 1 ].revents ) {
+        const int c = ::accept4( listen_fd_, nullptr, nullptr, SOCK_CLOEXEC );
+        if( c >= 0 )
+          readers.emplace( c, frame_reader{} );
+      }
+
+      for( size_t i = 2; i < fds.size(); ++i ) {
+        if( !fds[ i ].revents )
+          continue;
+
+        const int c = fds[ i ].fd;
+        auto & reader = readers[ c ];
+        if( reader.read_from( c ) <= 0 ) {
+          readers.erase( c );
+          send< connection_closed >( so_direct_mbox(), c );
+          continue;
+        }
+
+        requests_arrived msg{ c, {}, {} };
+        const bool valid = reader.consume(
+          [&]( frame_type type, const char * data, size_t size ) {
+            request_body r;
+            ping_body p;
+            if( frame_type::request == type && read_body( data, size, r ) &&
+                size >= sizeof(r) + r.name_size_ )
+              msg.requests_.push_back( incoming_request{
+                  r.id_,
+                  string( data + sizeof(r), r.name_size_ ),
+                  email_slice_t{ r.offset_, r.length_ },
+                  make_deadline( chrono::milliseconds( r.budget_ms_ ) ) } );
+            else if( frame_type::ping == type && read_body( data, size, p ) )
+              msg.pings_.push_back( p.stamp_ );
+          } );
+        if( !valid ) {
+          // Фронтальный процесс переотправит незавершенные запросы
+          // после переподключения.
+          readers.erase( c );
+          ::shutdown( c, SHUT_RDWR );
+          send< connection_closed >( so_direct_mbox(), c );
+          continue;
+        }
+
+        if( !msg.requests_.empty() || !msg.pings_.empty() )
+          send< requests_arrived >( so_direct_mbox(), move(msg) );
+      }
+    }
+  }
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+//
+// Извлечение имен хостов из URL-ов, которые встречаются в тексте email-а.
+//
+// Ищутся как ссылки со схемой (http://, https://, в любом регистре, в том
+// числе внутри HTML-атрибутов вроде href="..."), так и ссылки без схемы,
+// начинающиеся с "www.". Текст просматривается двумя проходами через
+// memchr: по символам ':' и по символам '.', поэтому на обычном тексте
+// без ссылок просмотр идет со скоростью memchr.
+//
+// Тело email-а может быть в кодировке quoted-printable, в которой
+// длинные строки разбиваются "мягкими" переносами ("=" в конце строки).
+// Такие переносы внутри имени хоста пропускаются.
+//
+// Для каждого найденного хоста вызывается on_host( const char *, size_t ).
+// Имя передается в нижнем регистре, без порта и без учетной записи
+// ("user@"). Буфер с именем действителен только во время вызова.
+//
+
+namespace url_extractor_details {
+
+const size_t max_host_size = 253;
+
+inline char lower( char c ) {
+  return (c >= 'A' && c <= 'Z') ? static_cast< char >( c + 32 ) : c;
+}
+
+inline bool is_host_char( char c ) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+      (c >= '0' && c <= '9') || '-' == c || '.' == c || '_' == c;
+}
+
+// Длина мягкого переноса quoted-printable в позиции p или 0.
+inline size_t soft_break_at( const char * p, const char * end ) {
+  if( p == end || '=' != *p )
+    return 0;
+  if( p + 1 != end && '\n' == p[ 1 ] )
+    return 2;
+  if( p + 2 < end && '\r' == p[ 1 ] && '\n' == p[ 2 ] )
+    return 3;
+  return 0;
+}
+
+// Разбор имени хоста, которое начинается в позиции p.
+template< typename F >
+void read_host( const char * p, const char * end, F && on_host ) {
+  char host[ max_host_size + 1 ];
+  size_t size = 0;
+  bool too_long = false;
+
+  for(;;) {
+    if( const auto skip = soft_break_at( p, end ) ) {
+      p += skip;
+      continue;
+    }
+    if( p == end )
+      break;
+
+    const char c = *p;
+    if( is_host_char( c ) ) {
+      if( size < max_host_size )
+        host[ size++ ] = lower( c );
+      else
+        too_long = true;
+      ++p;
+    }
+    else if( '@' == c ) {
+      // Все, что было до '@', это учетная запись, а не хост.
+      size = 0;
+      too_long = false;
+      ++p;
+    }
+    else
+      break;
+  }
+
+  while( size && '.' == host[ size - 1 ] )
+    --size;
+  if( size && !too_long && memchr( host, '.', size ) )
+    on_host( static_cast< const char * >( host ), size );
+}
+
+// Совпадает ли текст, заканчивающийся в позиции p (не включая ее),
+// с word без учета регистра. word задается в нижнем регистре.
+inline bool ends_with( const char * begin, const char * p, const char * word ) {
+  const auto n = strlen( word );
+  if( static_cast< size_t >( p - begin ) < n )
+    return false;
+  for( size_t i = 0; i != n; ++i )
+    if( lower( p[ i - n ] ) != word[ i ] )
+      return false;
+  return true;
+}
+
+} /* namespace url_extractor_details */
+
+template< typename F >
+void extract_url_hosts( const char * data, size_t size, F && on_host ) {
+  using namespace url_extractor_details;
+
+  const char * const end = data + size;
+
+  // Ссылки со схемой: ищем "://" и проверяем, что перед ним http или https.
+  for( const char * p = data;
+      nullptr != (p = static_cast< const char * >( memchr( p, ':', end - p ) ));
+      ++p )
+  {
+    if( end - p < 3 || '/' != p[ 1 ] || '/' != p[ 2 ] )
+      continue;
+    if( ends_with( data, p, "http" ) || ends_with( data, p, "https" ) )
+      read_host( p + 3, end, on_host );
+  }
+
+  // Ссылки без схемы: "www." в начале слова. Если перед "www." стоит
+  // "//", то эта ссылка уже была найдена первым проходом.
+  for( const char * p = data;
+      nullptr != (p = static_cast< const char * >( memchr( p, '.', end - p ) ));
+      ++p )
+  {
+    if( !ends_with( data, p, "www" ) )
+      continue;
+    const char * start = p - 3;
+    if( start != data && (is_host_char( start[ -1 ] ) || '/' == start[ -1 ]) )
+      continue;
+    read_host( start, end, on_host );
+  }
+}
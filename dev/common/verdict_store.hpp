@@ -0,0 +1,508 @@
+#pragma once
+
+#include <common/messages.hpp>
+#include <common/ip_blocklist.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include <sys/stat.h>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/file.h>
+  #include <sys/mman.h>
+  #include <unistd.h>
+#endif
+
+//
+// Хранилище вердиктов, которое переживает перезапуск.
+//
+// Одни и те же письма (рассылки, повторные доставки) приходят в течение
+// дня много раз. Хранилище запоминает результат проверки содержимого
+// email-а, и email, содержимое которого уже проверялось, не раздается
+// checker-ам повторно. Хранилище находится в файле, который отображается
+// в память, поэтому после перезапуска проверки сразу же продолжают
+// пользоваться накопленными вердиктами, а несколько процессов (например,
+// v7_bridge) пользуются одним хранилищем одновременно.
+//
+// Это хэш-таблица с открытой адресацией фиксированного размера. Ключ --
+// 128-битовый хэш содержимого email-а, который вычисляется с параметром,
+// выбранным случайно при создании файла. Email ищется в окне из
+// probe_window ячеек подряд. Если в окне нет места, то новый вердикт
+// вытесняет тот, срок хранения которого заканчивается раньше всех.
+//
+// Вердикт действителен, пока не истек его срок хранения (TTL) и пока
+// не изменились правила проверки: вместе с вердиктом хранится версия
+// правил (см. current_rules_version), и вердикт, полученный по другим
+// правилам, не используется.
+//
+// Каждая ячейка защищена счетчиком последовательности (seqlock). Писатель
+// делает счетчик нечетным, записывает ячейку и снова делает его четным.
+// Читатель не берет никаких блокировок: он читает счетчик, ячейку и еще
+// раз счетчик, и если счетчик нечетный или изменился, то ячейка считается
+// отсутствующей. Писатели не ждут друг друга: если ячейку уже кто-то
+// пишет, то вердикт просто не запоминается. Если процесс упал во время
+// записи, то ячейка так и остается нечетной и не используется, пока
+// хранилище не откроет процесс, который работает с файлом один: он
+// освобождает такие ячейки. Контрольная сумма ячейки защищает от ячеек,
+// которые записаны на диск не полностью (например, при отключении
+// питания).
+//
+// Формат файла (числа в порядке байт текущей платформы):
+//
+//   "EVS1"                       сигнатура;
+//   uint32_t slot_size           размер ячейки;
+//   uint64_t slots               количество ячеек (степень двойки);
+//   uint64_t seed                параметр хэш-функции;
+//   uint64_t reserved[ 5 ]       дополнение заголовка до 64 байт;
+//   slot cells[ slots ]          ячейки по 64 байта.
+//
+// Хранилище используется, если в переменной окружения EMAIL_VERDICT_STORE
+// задано имя файла (только для POSIX-платформ). Если файла нет, то он
+// создается с EMAIL_VERDICT_STORE_SLOTS ячейками (по умолчанию 2^20).
+// Срок хранения вердиктов задается в секундах в EMAIL_VERDICT_TTL
+// (по умолчанию сутки).
+//
+
+namespace verdict_store_details {
+
+static_assert( 2 == ATOMIC_LLONG_LOCK_FREE,
+    "verdict store requires lock-free 64-bit atomics" );
+
+struct file_header {
+  char magic_[ 4 ];
+  uint32_t slot_size_;
+  uint64_t slots_;
+  uint64_t seed_;
+  uint64_t reserved_[ 5 ];
+};
+
+// Ячейка занимает одну строку кэша. Все поля атомарные, т.к. их
+// одновременно читают и пишут несколько процессов.
+struct slot {
+  // Четный -- ячейка не изменяется, нечетный -- идет запись.
+  atomic< uint64_t > sequence_;
+  atomic< uint64_t > key_hi_;
+  atomic< uint64_t > key_lo_;
+  atomic< uint64_t > rules_version_;
+  // Время в секундах от начала эпохи Unix. 0 -- ячейка свободна.
+  atomic< uint64_t > expires_at_;
+  atomic< uint64_t > status_;
+  atomic< uint64_t > checksum_;
+  atomic< uint64_t > reserved_;
+};
+
+static_assert( 64 == sizeof(file_header), "unexpected header size" );
+static_assert( 64 == sizeof(slot), "unexpected slot size" );
+
+inline uint64_t mix64( uint64_t v ) {
+  v ^= v >> 33;
+  v *= 0xff51afd7ed558ccdULL;
+  v ^= v >> 33;
+  v *= 0xc4ceb9fe1a85ec53ULL;
+  v ^= v >> 33;
+  return v;
+}
+
+inline uint64_t rotl( uint64_t v, unsigned r ) {
+  return (v << r) | (v >> (64 - r));
+}
+
+inline uint64_t load64( const char * p ) {
+  uint64_t v;
+  memcpy( &v, p, sizeof(v) );
+  return v;
+}
+
+inline uint64_t checksum_of(
+  uint64_t hi, uint64_t lo, uint64_t rules, uint64_t expires, uint64_t status )
+{
+  return mix64( hi ^ mix64( lo ^ mix64( rules ^ mix64( expires ^ mix64( status ) ) ) ) );
+}
+
+inline uint64_t unix_now() {
+  return static_cast< uint64_t >( chrono::duration_cast< chrono::seconds >(
+      chrono::system_clock::now().time_since_epoch() ).count() );
+}
+
+// Запоминаются только окончательные результаты проверки.
+inline bool is_definitive( check_status status ) {
+  return check_status::safe == status ||
+      check_status::suspicious == status ||
+      check_status::dangerous == status;
+}
+
+} /* namespace verdict_store_details */
+
+// Ключ содержимого email-а в хранилище.
+struct verdict_key {
+  uint64_t hi_;
+  uint64_t lo_;
+};
+
+// 128-битовый хэш содержимого (по схеме MurmurHash3 x64/128).
+verdict_key hash_email_content( const char * data, size_t size, uint64_t seed ) {
+  using namespace verdict_store_details;
+
+  const uint64_t c1 = 0x87c37b91114253d5ULL;
+  const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+  uint64_t h1 = seed;
+  uint64_t h2 = seed ^ 0x9e3779b97f4a7c15ULL;
+  const auto block = [&]( uint64_t k1, uint64_t k2 ) {
+    h1 ^= rotl( k1 * c1, 31 ) * c2;
+    h1 = rotl( h1, 27 ) + h2;
+    h1 = h1 * 5 + 0x52dce729;
+    h2 ^= rotl( k2 * c2, 33 ) * c1;
+    h2 = rotl( h2, 31 ) + h1;
+    h2 = h2 * 5 + 0x38495ab5;
+  };
+
+  const char * const end = data + (size & ~size_t{ 15 });
+  for( const char * p = data; p != end; p += 16 )
+    block( load64( p ), load64( p + 8 ) );
+
+  // Хвост дополняется нулями до целого блока.
+  if( const auto tail = size & 15 ) {
+    char last[ 16 ] = {};
+    memcpy( last, end, tail );
+    block( load64( last ), load64( last + 8 ) );
+  }
+
+  h1 ^= size;
+  h2 ^= size;
+  h1 += h2;
+  h2 += h1;
+  h1 = mix64( h1 );
+  h2 = mix64( h2 );
+  h1 += h2;
+  h2 += h1;
+  return verdict_key{ h1, h2 };
+}
+
+class verdict_store {
+public :
+  // Сколько ячеек подряд просматривается при поиске и вставке.
+  static constexpr uint64_t probe_window = 8;
+
+  verdict_store(
+    const string & file_name,
+    uint64_t slots,
+    chrono::seconds ttl )
+    : ttl_( static_cast< uint64_t >( ttl.count() ) )
+  {
+#if !defined(_WIN32)
+    using namespace verdict_store_details;
+
+    fd_ = ::open( file_name.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644 );
+    if( fd_ < 0 )
+      throw runtime_error( "unable to open " + file_name );
+
+    try {
+      open_shared( file_name, slots );
+    }
+    catch( ... ) {
+      ::close( fd_ );
+      throw;
+    }
+#else
+    (void)slots;
+    throw runtime_error( "verdict store is not supported on this platform: " +
+        file_name );
+#endif
+  }
+  ~verdict_store() {
+#if !defined(_WIN32)
+    ::munmap( mapping_, mapping_size_ );
+    // Вместе с файлом закрывается и разделяемая блокировка.
+    ::close( fd_ );
+#endif
+  }
+
+  verdict_store( const verdict_store & ) = delete;
+  verdict_store & operator=( const verdict_store & ) = delete;
+
+  verdict_key key_of( const char * data, size_t size ) const {
+    return hash_email_content( data, size, seed_ );
+  }
+
+  // Поиск действующего вердикта. Не блокирует ни этот процесс,
+  // ни другие процессы, которые работают с тем же файлом.
+  bool find(
+    const verdict_key & key,
+    uint64_t rules_version,
+    check_status & status ) const
+  {
+    using namespace verdict_store_details;
+
+    const auto now = unix_now();
+    for( uint64_t i = 0; i != probe_window; ++i ) {
+      const slot & s = slots_[ (key.hi_ + i) & mask_ ];
+
+      const auto before = s.sequence_.load( memory_order_acquire );
+      if( before & 1 )
+        continue;
+      const auto hi = s.key_hi_.load( memory_order_relaxed );
+      const auto lo = s.key_lo_.load( memory_order_relaxed );
+      const auto rules = s.rules_version_.load( memory_order_relaxed );
+      const auto expires = s.expires_at_.load( memory_order_relaxed );
+      const auto value = s.status_.load( memory_order_relaxed );
+      const auto checksum = s.checksum_.load( memory_order_relaxed );
+      atomic_thread_fence( memory_order_acquire );
+      if( s.sequence_.load( memory_order_relaxed ) != before )
+        // Ячейку как раз сейчас перезаписывают.
+        continue;
+
+      if( hi != key.hi_ || lo != key.lo_ )
+        continue;
+      if( rules != rules_version || expires <= now ||
+          checksum != checksum_of( hi, lo, rules, expires, value ) ||
+          !is_definitive( static_cast< check_status >( value ) ) )
+        // Устаревшая копия. Действующая может быть дальше в окне.
+        continue;
+
+      status = static_cast< check_status >( value );
+      return true;
+    }
+    return false;
+  }
+
+  // Запоминание вердикта. Неокончательные результаты (сбой, тайм-аут)
+  // не запоминаются. Если подходящая ячейка сейчас занята другим
+  // писателем, то вердикт тоже не запоминается.
+  void remember(
+    const verdict_key & key,
+    uint64_t rules_version,
+    check_status status )
+  {
+    using namespace verdict_store_details;
+
+    if( !is_definitive( status ) )
+      return;
+
+    const auto now = unix_now();
+    slot & s = choose_slot( key, rules_version, now );
+
+    auto sequence = s.sequence_.load( memory_order_relaxed );
+    if( (sequence & 1) || !s.sequence_.compare_exchange_strong(
+        sequence, sequence + 1, memory_order_relaxed ) )
+      return;
+    // Запись полей не должна стать видна раньше нечетного счетчика.
+    atomic_thread_fence( memory_order_release );
+
+    const auto expires = now + ttl_;
+    const auto value = static_cast< uint64_t >( status );
+    s.key_hi_.store( key.hi_, memory_order_relaxed );
+    s.key_lo_.store( key.lo_, memory_order_relaxed );
+    s.rules_version_.store( rules_version, memory_order_relaxed );
+    s.expires_at_.store( expires, memory_order_relaxed );
+    s.status_.store( value, memory_order_relaxed );
+    s.checksum_.store( checksum_of( key.hi_, key.lo_, rules_version, expires, value ),
+        memory_order_relaxed );
+
+    s.sequence_.store( sequence + 2, memory_order_release );
+  }
+
+  uint64_t slots() const { return mask_ + 1; }
+
+private :
+  using slot = verdict_store_details::slot;
+
+  const uint64_t ttl_;
+
+  int fd_{ -1 };
+  void * mapping_{ nullptr };
+  size_t mapping_size_{ 0 };
+
+  slot * slots_{ nullptr };
+  uint64_t mask_{ 0 };
+  uint64_t seed_{ 0 };
+
+#if !defined(_WIN32)
+  // Каждый процесс держит разделяемую блокировку файла, пока работает
+  // с ним. Исключительную блокировку получает только тот, кто работает
+  // с файлом один: он создает файл или освобождает ячейки, запись
+  // в которые была прервана.
+  void open_shared( const string & file_name, uint64_t slots ) {
+    if( 0 == ::flock( fd_, LOCK_EX | LOCK_NB ) ) {
+      prepare_exclusive( file_name, slots );
+      // Блокировка заменяется на разделяемую не атомарно, но в этот
+      // промежуток другой процесс может только повторить подготовку.
+      if( ::flock( fd_, LOCK_SH ) < 0 )
+        throw runtime_error( "unable to lock " + file_name );
+    }
+    else {
+      // Файлом уже пользуются. Если его как раз сейчас создают, то
+      // ждем, пока создание закончится.
+      if( ::flock( fd_, LOCK_SH ) < 0 )
+        throw runtime_error( "unable to lock " + file_name );
+      map_file( file_name );
+    }
+  }
+
+  void prepare_exclusive( const string & file_name, uint64_t slots ) {
+    using namespace verdict_store_details;
+
+    struct stat st;
+    if( ::fstat( fd_, &st ) < 0 )
+      throw runtime_error( "unable to stat " + file_name );
+
+    // Файл без сигнатуры (например, создание было прервано) создается
+    // заново.
+    file_header header{};
+    if( static_cast< size_t >( st.st_size ) < sizeof(header) ||
+        sizeof(header) != ::pread( fd_, &header, sizeof(header), 0 ) ||
+        0 != memcmp( header.magic_, "EVS1", 4 ) )
+      create_file( file_name, slots );
+
+    map_file( file_name );
+
+    for( uint64_t i = 0; i <= mask_; ++i ) {
+      slot & s = slots_[ i ];
+      const auto sequence = s.sequence_.load( memory_order_relaxed );
+      if( sequence & 1 ) {
+        s.expires_at_.store( 0, memory_order_relaxed );
+        s.checksum_.store( 0, memory_order_relaxed );
+        s.sequence_.store( sequence + 1, memory_order_release );
+      }
+    }
+  }
+
+  void create_file( const string & file_name, uint64_t slots ) {
+    using namespace verdict_store_details;
+
+    uint64_t count = 1;
+    while( count < max( slots, probe_window ) )
+      count <<= 1;
+
+    file_header header{};
+    header.slot_size_ = sizeof(slot);
+    header.slots_ = count;
+    random_device rd;
+    header.seed_ = (uint64_t{ rd() } << 32) ^ rd();
+
+    // Ячейки создаются пустыми (файл разреженный), а сигнатура
+    // записывается последней, когда все остальное уже на месте.
+    if( ::ftruncate( fd_, 0 ) < 0 ||
+        ::ftruncate( fd_, static_cast< off_t >(
+            sizeof(header) + count * sizeof(slot) ) ) < 0 ||
+        sizeof(header) != ::pwrite( fd_, &header, sizeof(header), 0 ) ||
+        ::fsync( fd_ ) < 0 ||
+        4 != ::pwrite( fd_, "EVS1", 4, 0 ) ||
+        ::fsync( fd_ ) < 0 )
+      throw runtime_error( "unable to create " + file_name );
+  }
+
+  void map_file( const string & file_name ) {
+    using namespace verdict_store_details;
+
+    struct stat st;
+    file_header header{};
+    if( ::fstat( fd_, &st ) < 0 ||
+        static_cast< size_t >( st.st_size ) < sizeof(header) ||
+        sizeof(header) != ::pread( fd_, &header, sizeof(header), 0 ) ||
+        0 != memcmp( header.magic_, "EVS1", 4 ) ||
+        sizeof(slot) != header.slot_size_ ||
+        header.slots_ < probe_window ||
+        0 != (header.slots_ & (header.slots_ - 1)) ||
+        static_cast< uint64_t >( st.st_size ) <
+            sizeof(header) + header.slots_ * sizeof(slot) )
+      throw runtime_error( "invalid verdict store file: " + file_name );
+
+    mapping_size_ = static_cast< size_t >( sizeof(header) + header.slots_ * sizeof(slot) );
+    void * p = ::mmap( nullptr, mapping_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED, fd_, 0 );
+    if( MAP_FAILED == p )
+      throw runtime_error( "unable to mmap " + file_name );
+    ::madvise( p, mapping_size_, MADV_RANDOM );
+
+    mapping_ = p;
+    slots_ = reinterpret_cast< slot * >( static_cast< char * >( p ) + sizeof(header) );
+    mask_ = header.slots_ - 1;
+    seed_ = header.seed_;
+  }
+#endif
+
+  // Ячейка для нового вердикта: та, где уже есть этот ключ, или
+  // свободная, или устаревшая, или та, срок хранения которой
+  // заканчивается раньше всех. Выбор приблизительный, т.к. ячейки
+  // могут меняться, пока они просматриваются.
+  slot & choose_slot( const verdict_key & key, uint64_t rules_version, uint64_t now ) {
+    slot * victim = nullptr;
+    uint64_t victim_expires = numeric_limits< uint64_t >::max();
+    for( uint64_t i = 0; i != probe_window; ++i ) {
+      slot & s = slots_[ (key.hi_ + i) & mask_ ];
+      const auto expires = s.expires_at_.load( memory_order_relaxed );
+      if( expires <= now ||
+          s.rules_version_.load( memory_order_relaxed ) != rules_version ||
+          (s.key_hi_.load( memory_order_relaxed ) == key.hi_ &&
+              s.key_lo_.load( memory_order_relaxed ) == key.lo_) )
+        return s;
+
+      if( expires < victim_expires ) {
+        victim = &s;
+        victim_expires = expires;
+      }
+    }
+    return *victim;
+  }
+};
+
+constexpr uint64_t verdict_store::probe_window;
+
+//
+// Версия правил проверки, с которой запоминаются вердикты.
+//
+// Складывается из EMAIL_RULES_VERSION (ее нужно менять при изменении
+// самих проверок), из имен, размеров и времени изменения файлов
+// с правилами, которые загружаются один раз (EMAIL_BAD_DOMAINS,
+// EMAIL_FUZZY_DB, EMAIL_SPAM_MODEL, EMAIL_IMITATION), и из версии
+// списка заблокированных адресов, который может перестраиваться
+// на ходу.
+//
+uint64_t current_rules_version() {
+  static const uint64_t fixed = []{
+    string description;
+    if( const char * v = getenv( "EMAIL_RULES_VERSION" ) )
+      description += string( "rules=" ) + v + "\n";
+
+    for( const char * name :
+        { "EMAIL_BAD_DOMAINS", "EMAIL_FUZZY_DB", "EMAIL_SPAM_MODEL", "EMAIL_IMITATION" } ) {
+      const char * path = getenv( name );
+      if( !path )
+        continue;
+
+      description += string( name ) + "=" + path;
+      struct stat st;
+      if( 0 == stat( path, &st ) )
+        description += ":" + to_string( st.st_size ) + ":" + to_string( st.st_mtime );
+      description += "\n";
+    }
+    return hash_email_content( description.data(), description.size(), 0 ).hi_;
+  }();
+
+  return verdict_store_details::mix64( fixed ^ global_ip_blocklist().version() );
+}
+
+// Хранилище, указанное в переменной окружения EMAIL_VERDICT_STORE.
+// Если переменная не задана, то возвращается nullptr и вердикты
+// не запоминаются.
+verdict_store * global_verdict_store() {
+  static const unique_ptr< verdict_store > store = []{
+    const char * path = getenv( "EMAIL_VERDICT_STORE" );
+    if( !path )
+      return unique_ptr< verdict_store >{};
+
+    const char * slots = getenv( "EMAIL_VERDICT_STORE_SLOTS" );
+    const char * ttl = getenv( "EMAIL_VERDICT_TTL" );
+    return make_unique< verdict_store >( path,
+        slots ? static_cast< uint64_t >( atoll( slots ) ) : uint64_t{ 1 } << 20,
+        chrono::seconds( ttl ? atol( ttl ) : 24 * 60 * 60 ) );
+  }();
+  return store.get();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <common/messages.hpp>
+
+#include <functional>
+#include <queue>
+
+//
+// Планировщик событий в виртуальном времени.
+//
+// Время продвигается не само по себе, а скачком к моменту ближайшего
+// запланированного события, поэтому модель с задержками в секунды
+// выполняется со скоростью процессора. События с одинаковым временем
+// выполняются в порядке их планирования, так что при одних и тех же
+// исходных данных последовательность событий всегда одна и та же.
+//
+// Все выполняется на одной нити, синхронизации нет.
+//
+
+class virtual_scheduler {
+public :
+  using duration = chrono::microseconds;
+  using event_id = uint64_t;
+
+  // Текущее виртуальное время от начала моделирования.
+  duration now() const { return now_; }
+
+  // Выполнение action через delay от текущего момента.
+  event_id schedule( duration delay, function< void() > action ) {
+    const auto id = next_id_++;
+    queue_.push( event{ now_ + max( delay, duration::zero() ), id, move(action) } );
+    cancelled_.push_back( false );
+    return id;
+  }
+
+  // Отмена еще не выполненного события. Отмена уже выполненного
+  // события ничего не делает.
+  void cancel( event_id id ) {
+    if( id < cancelled_.size() )
+      cancelled_[ id ] = true;
+  }
+
+  // Выполнение всех событий, пока они есть. Возвращается количество
+  // выполненных событий.
+  uint64_t run() {
+    uint64_t executed = 0;
+    while( !queue_.empty() ) {
+      // Объект события перемещается из очереди до выполнения, т.к.
+      // действие может планировать новые события.
+      auto e = move( const_cast< event & >( queue_.top() ) );
+      queue_.pop();
+      if( cancelled_[ e.id_ ] )
+        continue;
+
+      cancelled_[ e.id_ ] = true;
+      now_ = e.at_;
+      e.action_();
+      ++executed;
+    }
+    return executed;
+  }
+
+private :
+  struct event {
+    duration at_;
+    event_id id_;
+    function< void() > action_;
+  };
+
+  struct later {
+    bool operator()( const event & a, const event & b ) const {
+      return a.at_ != b.at_ ? a.at_ > b.at_ : a.id_ > b.id_;
+    }
+  };
+
+  duration now_{ duration::zero() };
+  event_id next_id_{ 0 };
+  priority_queue< event, vector< event >, later > queue_;
+  // Для каждого запланированного события: отменено ли оно (или уже
+  // выполнено).
+  vector< bool > cancelled_;
+};
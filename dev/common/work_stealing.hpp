@@ -0,0 +1,387 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//
+// Пул рабочих нитей с перехватом работы (work stealing).
+//
+// У каждой рабочей нити есть своя деку задач Chase-Lev: сама нить
+// кладет и забирает задачи с одного конца деки без блокировок, а
+// остальные нити, когда у них кончается работа, перехватывают задачи
+// с другого конца. Задачи, которые ставятся в очередь не рабочими
+// нитями пула, распределяются по почтовым ящикам нитей по кругу, так что
+// и для них нет одной общей очереди, за которую бы конкурировали все
+// нити сразу.
+//
+// Сам пул ничего не знает о SObjectizer: задачей может быть любой
+// наследник stealable_task (см. work_stealing_disp.hpp).
+//
+
+// Задача для пула.
+class stealable_task {
+public :
+  virtual void execute() = 0;
+
+protected :
+  ~stealable_task() = default;
+};
+
+//
+// Деку Chase-Lev с указателями на задачи.
+//
+// Реализация по статье N.M. Le, A. Pop, A. Cohen, F. Zappa Nardelli
+// "Correct and Efficient Work-Stealing for Weak Memory Models" (2013).
+// push() и take() вызывает только нить-владелец, steal() -- любая нить.
+// При заполнении массив удваивается; старые массивы не освобождаются
+// до уничтожения деки, т.к. их в этот момент могут читать перехватчики.
+//
+class chase_lev_deque {
+  struct ring {
+    explicit ring( int64_t capacity )
+      : mask_( capacity - 1 )
+      , items_( new std::atomic< stealable_task * >[ static_cast< size_t >( capacity ) ] )
+    {}
+
+    int64_t capacity() const { return mask_ + 1; }
+
+    stealable_task * get( int64_t i ) const {
+      return items_[ static_cast< size_t >( i & mask_ ) ].load( std::memory_order_relaxed );
+    }
+    void put( int64_t i, stealable_task * t ) {
+      items_[ static_cast< size_t >( i & mask_ ) ].store( t, std::memory_order_relaxed );
+    }
+
+    const int64_t mask_;
+    std::unique_ptr< std::atomic< stealable_task * >[] > items_;
+  };
+
+public :
+  explicit chase_lev_deque( int64_t capacity = 256 ) {
+    rings_.emplace_back( new ring( capacity ) );
+    ring_.store( rings_.back().get(), std::memory_order_relaxed );
+  }
+
+  void push( stealable_task * task ) {
+    const auto b = bottom_.load( std::memory_order_relaxed );
+    const auto t = top_.load( std::memory_order_acquire );
+    auto * r = ring_.load( std::memory_order_relaxed );
+    if( b - t > r->capacity() - 1 )
+      r = grow( r, t, b );
+
+    r->put( b, task );
+    std::atomic_thread_fence( std::memory_order_release );
+    bottom_.store( b + 1, std::memory_order_relaxed );
+  }
+
+  stealable_task * take() {
+    const auto b = bottom_.load( std::memory_order_relaxed ) - 1;
+    auto * r = ring_.load( std::memory_order_relaxed );
+    bottom_.store( b, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    auto t = top_.load( std::memory_order_relaxed );
+
+    stealable_task * task = nullptr;
+    if( t <= b ) {
+      task = r->get( b );
+      if( t == b ) {
+        // Последний элемент: его может одновременно перехватывать
+        // другая нить.
+        if( !top_.compare_exchange_strong( t, t + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed ) )
+          task = nullptr;
+        bottom_.store( b + 1, std::memory_order_relaxed );
+      }
+    }
+    else
+      bottom_.store( b + 1, std::memory_order_relaxed );
+
+    return task;
+  }
+
+  stealable_task * steal() {
+    auto t = top_.load( std::memory_order_acquire );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    const auto b = bottom_.load( std::memory_order_acquire );
+    if( t >= b )
+      return nullptr;
+
+    auto * r = ring_.load( std::memory_order_acquire );
+    auto * task = r->get( t );
+    if( !top_.compare_exchange_strong( t, t + 1,
+        std::memory_order_seq_cst, std::memory_order_relaxed ) )
+      // Элемент забрал кто-то другой.
+      return nullptr;
+    return task;
+  }
+
+  bool empty() const {
+    return bottom_.load( std::memory_order_relaxed ) <=
+        top_.load( std::memory_order_relaxed );
+  }
+
+private :
+  // top_ и bottom_ меняются разными нитями, поэтому разнесены
+  // по разным строкам кэша.
+  alignas( 64 ) std::atomic< int64_t > top_{ 0 };
+  alignas( 64 ) std::atomic< int64_t > bottom_{ 0 };
+  std::atomic< ring * > ring_;
+  // Все когда-либо созданные массивы. Меняется только владельцем.
+  std::vector< std::unique_ptr< ring > > rings_;
+
+  ring * grow( ring * old, int64_t t, int64_t b ) {
+    rings_.emplace_back( new ring( old->capacity() * 2 ) );
+    auto * r = rings_.back().get();
+    for( auto i = t; i != b; ++i )
+      r->put( i, old->get( i ) );
+    ring_.store( r, std::memory_order_release );
+    return r;
+  }
+};
+
+// Показатели работы пула.
+struct work_stealing_stats {
+  // Сколько задач выполнено.
+  uint64_t executed_{};
+  // Сколько задач перехвачено у других нитей.
+  uint64_t stolen_{};
+  // Сколько раз при обращении к почтовому ящику пришлось ждать
+  // освобождения его замка.
+  uint64_t contended_{};
+  // Сколько раз рабочие нити засыпали из-за отсутствия работы.
+  uint64_t sleeps_{};
+};
+
+class work_stealing_pool {
+  // Задачи, которые поставлены в очередь извне пула.
+  struct mailbox {
+    std::mutex lock_;
+    std::deque< stealable_task * > tasks_;
+    std::atomic< size_t > size_{ 0 };
+  };
+
+  struct alignas( 64 ) worker {
+    chase_lev_deque deque_;
+    mailbox mailbox_;
+    std::thread thread_;
+    // Счетчики меняет только сама нить, поэтому обычные переменные;
+    // читаются после остановки пула.
+    uint64_t ticks_{};
+    uint64_t executed_{};
+    uint64_t stolen_{};
+    uint64_t sleeps_{};
+    std::atomic< uint64_t > contended_{ 0 };
+  };
+
+public :
+  explicit work_stealing_pool( size_t threads )
+    : workers_( threads ? threads : 1 )
+  {}
+
+  ~work_stealing_pool() {
+    stop();
+    join();
+  }
+
+  void start() {
+    for( size_t i = 0; i != workers_.size(); ++i )
+      workers_[ i ].thread_ = std::thread( [this, i]{ body( i ); } );
+  }
+
+  void stop() {
+    {
+      std::lock_guard< std::mutex > lock{ sleep_lock_ };
+      shutdown_ = true;
+    }
+    sleep_cv_.notify_all();
+  }
+
+  void join() {
+    for( auto & w : workers_ )
+      if( w.thread_.joinable() )
+        w.thread_.join();
+  }
+
+  size_t size() const { return workers_.size(); }
+
+  // Постановка задачи в очередь. Если вызывается на рабочей нити этого
+  // же пула, то задача кладется в деку этой нити, иначе -- в почтовый
+  // ящик очередной нити.
+  void schedule( stealable_task * task ) {
+    const auto & self = current();
+    if( this == self.pool_ )
+      workers_[ self.index_ ].deque_.push( task );
+    else
+      post( workers_[ next_mailbox_.fetch_add( 1, std::memory_order_relaxed )
+          % workers_.size() ], task );
+    wake_one();
+  }
+
+  // Повторная постановка задачи, которая уже выполнялась и не
+  // закончила работу. Задача ставится в конец почтового ящика текущей
+  // нити, чтобы не мешать остальным задачам из деки.
+  void reschedule( stealable_task * task ) {
+    const auto & self = current();
+    if( this == self.pool_ ) {
+      post( workers_[ self.index_ ], task );
+      wake_one();
+    }
+    else
+      schedule( task );
+  }
+
+  // Суммарные показатели. Точны только после остановки пула.
+  work_stealing_stats stats() const {
+    work_stealing_stats s;
+    for( const auto & w : workers_ ) {
+      s.executed_ += w.executed_;
+      s.stolen_ += w.stolen_;
+      s.sleeps_ += w.sleeps_;
+      s.contended_ += w.contended_.load( std::memory_order_relaxed );
+    }
+    return s;
+  }
+
+private :
+  struct current_worker {
+    const work_stealing_pool * pool_;
+    size_t index_;
+  };
+
+  std::vector< worker > workers_;
+  std::atomic< size_t > next_mailbox_{ 0 };
+
+  std::mutex sleep_lock_;
+  std::condition_variable sleep_cv_;
+  std::atomic< size_t > sleepers_{ 0 };
+  // Количество еще не использованных пробуждений.
+  size_t wakeups_{ 0 };
+  bool shutdown_{ false };
+
+  static current_worker & current() {
+    thread_local current_worker w{ nullptr, 0 };
+    return w;
+  }
+
+  static void post( worker & w, stealable_task * task ) {
+    std::unique_lock< std::mutex > lock{ w.mailbox_.lock_, std::try_to_lock };
+    if( !lock.owns_lock() ) {
+      w.contended_.fetch_add( 1, std::memory_order_relaxed );
+      lock.lock();
+    }
+    w.mailbox_.tasks_.push_back( task );
+    w.mailbox_.size_.fetch_add( 1, std::memory_order_release );
+  }
+
+  static stealable_task * fetch( worker & w, worker & by ) {
+    if( !w.mailbox_.size_.load( std::memory_order_acquire ) )
+      return nullptr;
+
+    std::unique_lock< std::mutex > lock{ w.mailbox_.lock_, std::try_to_lock };
+    if( !lock.owns_lock() ) {
+      by.contended_.fetch_add( 1, std::memory_order_relaxed );
+      lock.lock();
+    }
+    if( w.mailbox_.tasks_.empty() )
+      return nullptr;
+    auto * task = w.mailbox_.tasks_.front();
+    w.mailbox_.tasks_.pop_front();
+    w.mailbox_.size_.fetch_sub( 1, std::memory_order_relaxed );
+    return task;
+  }
+
+  void wake_one() {
+    // Пара с барьером в sleep(): либо засыпающая нить увидит новую
+    // задачу, либо здесь будет видно, что она собирается заснуть.
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+    if( sleepers_.load( std::memory_order_relaxed ) ) {
+      {
+        std::lock_guard< std::mutex > lock{ sleep_lock_ };
+        ++wakeups_;
+      }
+      sleep_cv_.notify_one();
+    }
+  }
+
+  bool has_work() const {
+    for( const auto & w : workers_ )
+      if( !w.deque_.empty() || w.mailbox_.size_.load( std::memory_order_relaxed ) )
+        return true;
+    return false;
+  }
+
+  stealable_task * next_task( size_t index ) {
+    auto & self = workers_[ index ];
+
+    // Время от времени почтовый ящик проверяется первым, чтобы задачи
+    // извне не ждали, пока опустеет деку.
+    if( 0 == (++self.ticks_ % 61) )
+      if( auto * t = fetch( self, self ) )
+        return t;
+
+    if( auto * t = self.deque_.take() )
+      return t;
+    if( auto * t = fetch( self, self ) )
+      return t;
+
+    for( size_t k = 1; k != workers_.size(); ++k ) {
+      auto & victim = workers_[ (index + k) % workers_.size() ];
+      auto * t = victim.deque_.steal();
+      if( !t )
+        t = fetch( victim, self );
+      if( t ) {
+        ++self.stolen_;
+        return t;
+      }
+    }
+    return nullptr;
+  }
+
+  // Возвращает false, если пул остановлен.
+  bool sleep( size_t index ) {
+    sleepers_.fetch_add( 1, std::memory_order_relaxed );
+    std::atomic_thread_fence( std::memory_order_seq_cst );
+
+    bool running = true;
+    if( !has_work() ) {
+      ++workers_[ index ].sleeps_;
+      std::unique_lock< std::mutex > lock{ sleep_lock_ };
+      sleep_cv_.wait( lock, [this]{ return shutdown_ || wakeups_; } );
+      if( wakeups_ )
+        --wakeups_;
+      running = !shutdown_;
+    }
+
+    sleepers_.fetch_sub( 1, std::memory_order_relaxed );
+    return running;
+  }
+
+  void body( size_t index ) {
+    current() = current_worker{ this, index };
+    auto & self = workers_[ index ];
+
+    for(;;) {
+      if( auto * task = next_task( index ) ) {
+        task->execute();
+        ++self.executed_;
+        continue;
+      }
+
+      // Прежде чем заснуть, немного подождем: короткие задачи
+      // обычно приходят пачками.
+      bool found = false;
+      for( int i = 0; i != 64 && !found; ++i ) {
+        std::this_thread::yield();
+        found = has_work();
+      }
+      if( !found && !sleep( index ) )
+        break;
+    }
+  }
+};
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <common/messages.hpp>
+#include <common/work_stealing.hpp>
+
+#include <deque>
+#include <map>
+#include <mutex>
+
+//
+// Диспетчер SObjectizer на основе work_stealing_pool.
+//
+// Предназначен для большого количества короткоживущих агентов с
+// короткими обработчиками (например, checker-ов из v7). У стандартного
+// thread_pool-диспетчера одна общая очередь готовых к работе агентов,
+// и когда таких агентов тысячи, за замок этой очереди конкурируют все
+// рабочие нити и все нити, которые отсылают агентам сообщения.
+//
+// Здесь у каждого агента своя очередь событий. Когда в пустую очередь
+// приходит событие, сама очередь агента ставится в пул как задача, и
+// ее выполняет одна из рабочих нитей: обрабатывает несколько событий
+// подряд и, если события еще остались, ставит очередь в пул повторно.
+// Поэтому события одного агента никогда не обрабатываются параллельно,
+// а события разных агентов (в том числе из одной кооперации)
+// обрабатываются независимо, как при fifo_t::individual у thread_pool.
+//
+// Диспетчер регистрируется в SObjectizer Environment под именем, а
+// агенты привязываются к нему так же, как к именованному thread_pool:
+//
+//   params.add_named_dispatcher( "checkers", create_work_stealing_disp( 8 ) );
+//   ...
+//   introduce_child_coop( *this,
+//       create_work_stealing_disp_binder( "checkers" ), ... );
+//
+
+namespace work_stealing_disp_details {
+
+// Очередь событий одного агента.
+class agent_queue final : public event_queue_t, public stealable_task {
+  // Сколько событий обрабатывается за один раз, прежде чем дать
+  // поработать другим агентам.
+  static constexpr unsigned max_demands_at_once = 4;
+
+public :
+  explicit agent_queue( work_stealing_pool & pool ) : pool_( pool ) {}
+
+  virtual void push( execution_demand_t demand ) override {
+    bool need_schedule = false;
+    {
+      lock_guard< mutex > lock{ lock_ };
+      demands_.push_back( move(demand) );
+      if( !scheduled_ ) {
+        scheduled_ = true;
+        need_schedule = true;
+      }
+    }
+
+    if( need_schedule ) {
+      // Пока очередь стоит в пуле, она не должна быть уничтожена.
+      add_ref();
+      pool_.schedule( this );
+    }
+  }
+
+  virtual void execute() override {
+    const auto thread_id = query_current_thread_id();
+    for( unsigned i = 0; i != max_demands_at_once; ++i ) {
+      unique_lock< mutex > lock{ lock_ };
+      if( demands_.empty() ) {
+        scheduled_ = false;
+        lock.unlock();
+        release();
+        return;
+      }
+
+      auto demand = move( demands_.front() );
+      demands_.pop_front();
+      lock.unlock();
+
+      demand.call_handler( thread_id );
+    }
+
+    bool more;
+    {
+      lock_guard< mutex > lock{ lock_ };
+      more = !demands_.empty();
+      if( !more )
+        scheduled_ = false;
+    }
+    if( more )
+      pool_.reschedule( this );
+    else
+      release();
+  }
+
+  void add_ref() {
+    references_.fetch_add( 1, memory_order_relaxed );
+  }
+
+  void release() {
+    if( 1 == references_.fetch_sub( 1, memory_order_acq_rel ) )
+      delete this;
+  }
+
+private :
+  work_stealing_pool & pool_;
+
+  mutex lock_;
+  deque< execution_demand_t > demands_;
+  // Стоит ли очередь в пуле (или выполняется).
+  bool scheduled_{ false };
+  // Одна ссылка у привязки агента, еще одна -- пока очередь в пуле.
+  atomic< int > references_{ 1 };
+};
+
+class dispatcher final : public dispatcher_t {
+public :
+  explicit dispatcher( size_t threads ) : pool_( threads ) {}
+
+  virtual void start( environment_t & ) override { pool_.start(); }
+  virtual void shutdown() override { pool_.stop(); }
+  virtual void wait() override { pool_.join(); }
+  virtual void set_data_sources_name_base( const string & ) override {}
+
+  work_stealing_pool & pool() { return pool_; }
+
+private :
+  work_stealing_pool pool_;
+};
+
+class binder final : public disp_binder_t {
+public :
+  explicit binder( string disp_name ) : disp_name_( move(disp_name) ) {}
+
+  virtual disp_binding_activator_t bind_agent(
+    environment_t & env,
+    agent_ref_t agent ) override
+  {
+    const auto disp_ref = env.query_named_dispatcher( disp_name_ );
+    auto * disp = dynamic_cast< dispatcher * >( disp_ref.get() );
+    if( !disp )
+      throw runtime_error( "no work stealing dispatcher named " + disp_name_ );
+
+    auto * queue = new agent_queue( disp->pool() );
+    {
+      lock_guard< mutex > lock{ lock_ };
+      queues_[ agent.get() ] = queue;
+    }
+    return [agent, queue]{ agent->so_bind_to_dispatcher( *queue ); };
+  }
+
+  virtual void unbind_agent( environment_t &, agent_ref_t agent ) override {
+    agent_queue * queue = nullptr;
+    {
+      lock_guard< mutex > lock{ lock_ };
+      const auto it = queues_.find( agent.get() );
+      if( it == queues_.end() )
+        return;
+      queue = it->second;
+      queues_.erase( it );
+    }
+    queue->release();
+  }
+
+private :
+  const string disp_name_;
+  mutex lock_;
+  map< const agent_t *, agent_queue * > queues_;
+};
+
+} /* namespace work_stealing_disp_details */
+
+// Создание диспетчера для регистрации под именем в environment_params_t.
+dispatcher_unique_ptr_t create_work_stealing_disp( size_t threads ) {
+  return dispatcher_unique_ptr_t(
+      new work_stealing_disp_details::dispatcher( threads ) );
+}
+
+// Привязка агентов к диспетчеру, зарегистрированному под именем disp_name.
+disp_binder_unique_ptr_t create_work_stealing_disp_binder( string disp_name ) {
+  return disp_binder_unique_ptr_t(
+      new work_stealing_disp_details::binder( move(disp_name) ) );
+}
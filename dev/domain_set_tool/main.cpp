@@ -0,0 +1,51 @@
+// Построение файла с множеством плохих доменов для EMAIL_BAD_DOMAINS.
+//
+// На вход подается текстовый файл, в котором каждая строка содержит
+// одно доменное имя. Пустые строки и строки, начинающиеся с '#',
+// пропускаются.
+//
+// Использование: domain_set_tool <список доменов> <файл множества>
+
+#include <common/domain_set.hpp>
+
+#include <fstream>
+
+int main( int argc, char ** argv ) {
+  try {
+    if( 3 != argc )
+      throw runtime_error( "usage: domain_set_tool <domains.txt> <domains.eds>" );
+
+    ifstream in( argv[1] );
+    if( !in )
+      throw runtime_error( string( "unable to open " ) + argv[1] );
+
+    vector< string > names;
+    string line;
+    while( getline( in, line ) ) {
+      // Поиск выполняется по именам в нижнем регистре и без
+      // завершающей точки.
+      while( !line.empty() && (isspace( static_cast< unsigned char >( line.back() ) ) ||
+          '.' == line.back()) )
+        line.pop_back();
+      if( line.empty() || '#' == line[ 0 ] )
+        continue;
+      transform( line.begin(), line.end(), line.begin(),
+          []( char c ) { return static_cast< char >( tolower( static_cast< unsigned char >( c ) ) ); } );
+      names.push_back( line );
+    }
+
+    const auto content = build_domain_set( names );
+    ofstream out( argv[2], ios::binary );
+    out.write( content.data(), static_cast< streamsize >( content.size() ) );
+    if( !out )
+      throw runtime_error( string( "unable to write " ) + argv[2] );
+
+    cout << names.size() << " domain(s), " << content.size() << " bytes" << endl;
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
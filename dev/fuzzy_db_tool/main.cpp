@@ -0,0 +1,75 @@
+// Построение строк базы известного спама для EMAIL_FUZZY_DB.
+//
+// На вход подаются файлы с email-ами: либо один email в файле (как
+// в maildir), либо mbox-файл, если файл начинается со строки "From ".
+// Для тела каждого email-а строится нечеткий отпечаток, и в cout
+// выводится строка "<вердикт> <отпечаток>". Отпечаток строится так же,
+// как при проверке (см. check_body() в stuff.hpp), поэтому вывод можно
+// сразу дописывать в файл из EMAIL_FUZZY_DB.
+//
+// Тела, которые слишком коротки для сравнения, пропускаются.
+//
+// Использование: fuzzy_db_tool <suspicious|dangerous> <файл>... >> spam.db
+
+#include <common/stuff.hpp>
+#include <common/mbox_splitter.hpp>
+
+#include <fstream>
+#include <sstream>
+
+string read_file( const string & path ) {
+  ifstream in( path, ios::binary );
+  if( !in )
+    throw runtime_error( "unable to open " + path );
+
+  ostringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+int main( int argc, char ** argv ) {
+  try {
+    const string verdict = argc > 1 ? argv[1] : "";
+    if( argc < 3 || ("suspicious" != verdict && "dangerous" != verdict) )
+      throw runtime_error(
+          "usage: fuzzy_db_tool <suspicious|dangerous> <email-or-mbox>..." );
+
+    size_t written = 0;
+    size_t skipped = 0;
+    const auto add = [&]( const char * data, size_t size ) {
+      basic_parsed_email< allocator< char > > email;
+      email.parse( data, size );
+
+      const auto fp = make_body_fingerprint(
+          email.body().data(), email.body().size() );
+      if( !fp.valid() ) {
+        ++skipped;
+        return;
+      }
+      cout << verdict << ' ' << format_fingerprint( fp ) << '\n';
+      ++written;
+    };
+
+    for( int i = 2; i < argc; ++i ) {
+      const auto content = read_file( argv[ i ] );
+      if( 0 == content.compare( 0, 5, "From " ) )
+        for( const auto & m : split_mbox( content.data(), content.size() ) )
+          add( content.data() + m.offset_, static_cast< size_t >( m.length_ ) );
+      else
+        add( content.data(), content.size() );
+    }
+
+    cout.flush();
+    if( !cout )
+      throw runtime_error( "unable to write fingerprints" );
+
+    cerr << written << " fingerprint(s), " << skipped
+        << " email(s) too short to fingerprint" << endl;
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
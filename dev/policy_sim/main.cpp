@@ -0,0 +1,546 @@
+// Модель конвейера v7 в виртуальном времени для экспериментов
+// с политиками агента-менеджера.
+//
+// В настоящем конвейере IO-агент и checker-ы имитируют свою работу
+// отложенными сообщениями, поэтому прогон 5000 email-ов занимает
+// минуты, а порядок событий зависит от планирования нитей. Здесь
+// менеджер, email_analyzer, IO-агенты и checker-ы v7 повторены как
+// обработчики событий планировщика virtual_scheduler. Задержки и отказы
+// берутся из тех же правил, что и в конвейере (common/imitation.hpp,
+// в том числе из файла EMAIL_IMITATION),
+// но время не ждется, а сразу переставляется к следующему событию.
+// Поэтому прогон занимает доли секунды, а при одних и тех же параметрах
+// последовательность событий совпадает до бита (что проверяется
+// по хэшу трассы результатов).
+//
+// Доставка сообщения моделируется событием с нулевой задержкой, т.е.
+// сообщения обрабатываются в порядке отсылки. Рабочие нити диспетчеров
+// не моделируются: все агенты конвейера обрабатывают свои события
+// за пренебрежимо малое время, а ждут только таймеров.
+//
+// Использование: policy_sim [параметр=значение[,значение...]]...
+//
+// Для параметра можно указать несколько значений через запятую, тогда
+// выполняются прогоны для всех сочетаний значений. Параметры:
+//
+//   emails               количество email-ов (5000);
+//   max_parallel         максимум одновременных анализаторов (16);
+//   order                порядок выборки из списка ожидания: fifo или lifo;
+//   lifetime_ms          максимальное время в списке ожидания (10000);
+//   io_timeout_ms        тайм-аут ожидания IO-агента (1500);
+//   checkers_timeout_ms  тайм-аут ожидания checker-ов (750);
+//   budget_ms            время на проверку одного email-а, 0 - без
+//                        ограничения (0);
+//   rate                 email-ов в секунду, 0 - все сразу (0);
+//   io_shards            количество IO-агентов (2);
+//   seed                 добавка к seed из правил имитации, позволяет
+//                        повторить прогон с другими случайными числами (0).
+//
+// Например:
+//
+//   policy_sim max_parallel=8,16,32 order=fifo,lifo budget_ms=0,3000
+
+#include <common/imitation.hpp>
+#include <common/io_hedging.hpp>
+#include <common/virtual_time.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+
+using vtime = virtual_scheduler::duration;
+
+struct sim_config {
+  size_t emails_{ 5000 };
+  size_t max_parallel_{ 16 };
+  bool lifo_{ false };
+  chrono::milliseconds lifetime_{ 10000 };
+  chrono::milliseconds io_timeout_{ 1500 };
+  chrono::milliseconds checkers_timeout_{ 750 };
+  chrono::milliseconds budget_{ 0 };
+  double rate_{ 0 };
+  unsigned io_shards_{ 2 };
+  uint64_t seed_{ 0 };
+};
+
+struct sim_result {
+  vtime makespan_{};
+  vector< vtime > latencies_;
+  array< size_t, 5 > statuses_{};
+  uint64_t events_{};
+  // FNV-1a, начальное значение -- стандартное смещение.
+  uint64_t trace_hash_{ 0xcbf29ce484222325ULL };
+};
+
+//
+// Сама модель. Один объект на один прогон.
+//
+class pipeline_model {
+  // Аналог состояний email_analyzer.
+  enum class phase { pending, wait_io, wait_checkers, finished };
+
+  struct analyzer {
+    phase phase_{ phase::pending };
+    vtime arrived_at_{};
+    vtime deadline_{ vtime::max() };
+    vtime io_requested_at_{};
+    int io_requests_in_flight_{};
+    check_status status_{ check_status::check_failure };
+    uint32_t checks_passed_{};
+    virtual_scheduler::event_id time_limit_{ ~uint64_t{} };
+    virtual_scheduler::event_id hedge_timer_{ ~uint64_t{} };
+  };
+
+  // Три checker-а имитируют длительную проверку, четвертый (score)
+  // отвечает сразу, как и в v7.
+  static constexpr unsigned imitated_checkers = 3;
+  static constexpr uint32_t all_checks_passed = (1u << (imitated_checkers + 1)) - 1;
+
+public :
+  explicit pipeline_model( const sim_config & config )
+    : config_( config )
+    , analyzers_( config.emails_ )
+    , io_counters_( config.io_shards_, 0u )
+    , rng_( model_.seed_ + config.seed_ )
+  {
+    result_.latencies_.reserve( config.emails_ );
+  }
+
+  sim_result run() {
+    if( config_.emails_ ) {
+      scheduler_.schedule( vtime::zero(), [this]{ on_arrival( 0 ); } );
+      lifetime_timer_ = scheduler_.schedule(
+          chrono::milliseconds( 500 ), [this]{ on_check_lifetime(); } );
+    }
+    result_.events_ = scheduler_.run();
+    result_.makespan_ = scheduler_.now();
+    return move( result_ );
+  }
+
+private :
+  const sim_config config_;
+  virtual_scheduler scheduler_;
+  vector< analyzer > analyzers_;
+
+  // Состояние агента-менеджера.
+  deque< size_t > pending_;
+  size_t active_analyzers_{ 0 };
+  virtual_scheduler::event_id lifetime_timer_{};
+
+  // У каждого IO-агента свой счетчик запросов, счетчик проверок
+  // у checker-ов общий. Все агенты модели работают на одной нити,
+  // поэтому и генератор случайных чисел у них один.
+  const imitation_model & model_{ global_imitation_model() };
+  vector< unsigned > io_counters_;
+  unsigned checker_counter_{ 0 };
+  imitation_rng rng_;
+  io_hedging hedging_;
+
+  sim_result result_;
+
+  void deliver( function< void() > action ) {
+    scheduler_.schedule( vtime::zero(), move(action) );
+  }
+
+  // Аналог time_left() для виртуального времени.
+  chrono::milliseconds left( const analyzer & a, chrono::milliseconds limit ) const {
+    if( vtime::max() == a.deadline_ )
+      return limit;
+    const auto l = chrono::duration_cast< chrono::milliseconds >(
+        a.deadline_ - scheduler_.now() );
+    return max( chrono::milliseconds::zero(), min( l, limit ) );
+  }
+
+  bool expired( const analyzer & a ) const {
+    return a.deadline_ <= scheduler_.now();
+  }
+
+  static size_t name_length( size_t email ) {
+    char name[ 32 ];
+    return static_cast< size_t >(
+        snprintf( name, sizeof(name), "email_%zu.mbox", email ) );
+  }
+
+  //
+  // Поступление запросов (requests_initiator).
+  //
+  void on_arrival( size_t email ) {
+    auto & a = analyzers_[ email ];
+    a.arrived_at_ = scheduler_.now();
+    if( config_.budget_.count() )
+      a.deadline_ = a.arrived_at_ + config_.budget_;
+
+    // Аналог on_new_check_request.
+    pending_.push_back( email );
+    deliver( [this]{ on_create_new_analyzer(); } );
+
+    if( email + 1 < config_.emails_ ) {
+      const auto next = config_.rate_ > 0 ?
+          chrono::duration_cast< vtime >(
+              chrono::duration< double >( (email + 1) / config_.rate_ ) ) - a.arrived_at_ :
+          vtime::zero();
+      scheduler_.schedule( next, [this, email]{ on_arrival( email + 1 ); } );
+    }
+  }
+
+  void on_result( size_t email, check_status status ) {
+    const auto now = scheduler_.now();
+    result_.latencies_.push_back( now - analyzers_[ email ].arrived_at_ );
+    ++result_.statuses_[ static_cast< size_t >( status ) ];
+
+    // FNV-1a по моменту, номеру email-а и статусу.
+    const uint64_t items[] = {
+        static_cast< uint64_t >( now.count() ), email,
+        static_cast< uint64_t >( status ) };
+    for( auto v : items )
+      for( int i = 0; i != 8; ++i ) {
+        result_.trace_hash_ ^= (v >> (i * 8)) & 0xff;
+        result_.trace_hash_ *= 0x100000001b3ULL;
+      }
+
+    if( result_.latencies_.size() == config_.emails_ )
+      // Больше ничего не будет, периодический таймер не нужен.
+      scheduler_.cancel( lifetime_timer_ );
+  }
+
+  //
+  // Агент-менеджер (basic_analyzer_manager).
+  //
+  void on_create_new_analyzer() {
+    if( active_analyzers_ >= config_.max_parallel_ )
+      return;
+
+    launch_new_analyzer();
+
+    if( !pending_.empty() && active_analyzers_ < config_.max_parallel_ )
+      deliver( [this]{ on_create_new_analyzer(); } );
+  }
+
+  void on_analyzer_finished() {
+    --active_analyzers_;
+
+    if( !pending_.empty() )
+      launch_new_analyzer();
+  }
+
+  void on_check_lifetime() {
+    const auto now = scheduler_.now();
+    for( auto it = pending_.begin(); it != pending_.end(); ) {
+      const auto & a = analyzers_[ *it ];
+      if( a.arrived_at_ + config_.lifetime_ < now || a.deadline_ <= now ) {
+        reply_timedout( *it );
+        it = pending_.erase( it );
+      }
+      else
+        ++it;
+    }
+    lifetime_timer_ = scheduler_.schedule(
+        chrono::milliseconds( 500 ), [this]{ on_check_lifetime(); } );
+  }
+
+  void reply_timedout( size_t email ) {
+    analyzers_[ email ].phase_ = phase::finished;
+    deliver( [this, email]{ on_result( email, check_status::check_timedout ); } );
+  }
+
+  size_t take_next() {
+    size_t email;
+    if( config_.lifo_ ) {
+      email = pending_.back();
+      pending_.pop_back();
+    }
+    else {
+      email = pending_.front();
+      pending_.pop_front();
+    }
+    return email;
+  }
+
+  void launch_new_analyzer() {
+    while( !pending_.empty() ) {
+      const auto email = take_next();
+      if( expired( analyzers_[ email ] ) ) {
+        reply_timedout( email );
+        continue;
+      }
+
+      ++active_analyzers_;
+      deliver( [this, email]{ on_analyzer_start( email ); } );
+      return;
+    }
+  }
+
+  //
+  // email_analyzer.
+  //
+  bool enter_waiting_state( size_t email, phase p, chrono::milliseconds timeout ) {
+    auto & a = analyzers_[ email ];
+    scheduler_.cancel( a.time_limit_ );
+    const auto l = left( a, timeout );
+    if( l <= chrono::milliseconds::zero() ) {
+      finish( email, a.status_ );
+      return false;
+    }
+
+    a.phase_ = p;
+    a.time_limit_ = scheduler_.schedule( l, [this, email]{
+        finish( email, analyzers_[ email ].status_ );
+      } );
+    return true;
+  }
+
+  void on_analyzer_start( size_t email ) {
+    if( !enter_waiting_state( email, phase::wait_io, config_.io_timeout_ ) )
+      return;
+
+    auto & a = analyzers_[ email ];
+    a.io_requested_at_ = scheduler_.now();
+    send_io_request( email, primary_io_shard( email ) );
+    hedging_.on_request_sent();
+
+    a.hedge_timer_ = scheduler_.schedule( hedging_.hedge_delay(),
+        [this, email]{ on_hedge_io( email ); } );
+  }
+
+  unsigned primary_io_shard( size_t email ) const {
+    return static_cast< unsigned >( email % config_.io_shards_ );
+  }
+
+  void send_io_request( size_t email, unsigned shard ) {
+    ++analyzers_[ email ].io_requests_in_flight_;
+    deliver( [this, email, shard]{ on_io_request( email, shard ); } );
+  }
+
+  void on_hedge_io( size_t email ) {
+    if( phase::wait_io != analyzers_[ email ].phase_ )
+      return;
+    if( config_.io_shards_ > 1 && hedging_.try_hedge() )
+      send_io_request( email, (primary_io_shard( email ) + 1) % config_.io_shards_ );
+  }
+
+  void on_io_reply( size_t email, bool succeed ) {
+    auto & a = analyzers_[ email ];
+    // Опоздавшие ответы выбрасываются.
+    if( phase::wait_io != a.phase_ )
+      return;
+
+    if( !succeed ) {
+      if( 0 == --a.io_requests_in_flight_ ) {
+        scheduler_.cancel( a.hedge_timer_ );
+        finish( email, a.status_ );
+      }
+      return;
+    }
+
+    scheduler_.cancel( a.hedge_timer_ );
+    hedging_.on_reply( scheduler_.now() - a.io_requested_at_ );
+
+    if( !enter_waiting_state( email, phase::wait_checkers, config_.checkers_timeout_ ) )
+      return;
+
+    for( unsigned i = 0; i != imitated_checkers; ++i )
+      deliver( [this, email, i]{ on_checker_start( email, i ); } );
+    // Финальный checker отвечает сразу.
+    deliver( [this, email]{
+        deliver( [this, email]{
+            on_checker_result( email, imitated_checkers, check_status::safe );
+          } );
+      } );
+  }
+
+  void on_checker_result( size_t email, unsigned checker, check_status status ) {
+    auto & a = analyzers_[ email ];
+    if( phase::wait_checkers != a.phase_ )
+      return;
+
+    if( check_status::safe != status ) {
+      a.status_ = status;
+      finish( email, status );
+    }
+    else {
+      a.checks_passed_ |= 1u << checker;
+      if( all_checks_passed == a.checks_passed_ )
+        finish( email, check_status::safe );
+    }
+  }
+
+  void finish( size_t email, check_status status ) {
+    auto & a = analyzers_[ email ];
+    a.phase_ = phase::finished;
+    scheduler_.cancel( a.time_limit_ );
+    scheduler_.cancel( a.hedge_timer_ );
+
+    if( check_status::check_failure == status && expired( a ) )
+      status = check_status::check_timedout;
+
+    deliver( [this, email, status]{ on_result( email, status ); } );
+    // Уведомление о дерегистрации кооперации анализатора.
+    deliver( [this]{ on_analyzer_finished(); } );
+  }
+
+  //
+  // IO-агенты и checker-ы.
+  //
+  void on_io_request( size_t email, unsigned shard ) {
+    const auto & a = analyzers_[ email ];
+    const auto reply = [this, email]( vtime pause, bool succeed ) {
+      scheduler_.schedule( pause, [this, email, succeed]{
+          on_io_reply( email, succeed );
+        } );
+    };
+
+    if( expired( a ) ) {
+      reply( vtime::zero(), false );
+      return;
+    }
+
+    const auto imitation = model_.io_request(
+        ++io_counters_[ shard ], name_length( email ), rng_ );
+    if( imitation.lost_ )
+      return;
+
+    const auto pause = imitation.pause_;
+    if( left( a, pause ) < pause )
+      reply( vtime::zero(), false );
+    else
+      reply( pause, !imitation.failed_ );
+  }
+
+  void on_checker_start( size_t email, unsigned checker ) {
+    const auto & a = analyzers_[ email ];
+    const auto reply = [this, email, checker]( vtime pause, check_status status ) {
+      scheduler_.schedule( pause, [this, email, checker, status]{
+          on_checker_result( email, checker, status );
+        } );
+    };
+
+    if( expired( a ) ) {
+      reply( vtime::zero(), check_status::check_timedout );
+      return;
+    }
+
+    const auto imitation = model_.check( ++checker_counter_, rng_ );
+    if( imitation.lost_ )
+      return;
+
+    const auto pause = imitation.pause_;
+    if( left( a, pause ) < pause )
+      reply( vtime::zero(), check_status::check_timedout );
+    else
+      reply( pause, imitation.status_ );
+  }
+};
+
+constexpr unsigned pipeline_model::imitated_checkers;
+constexpr uint32_t pipeline_model::all_checks_passed;
+
+// Установка одного параметра из командной строки.
+void set_param( sim_config & config, const string & name, const string & value ) {
+  const auto ms = [&]{ return chrono::milliseconds( stoul( value ) ); };
+
+  if( "emails" == name ) config.emails_ = stoul( value );
+  else if( "max_parallel" == name ) config.max_parallel_ = max< size_t >( 1, stoul( value ) );
+  else if( "order" == name ) {
+    if( "fifo" != value && "lifo" != value )
+      throw runtime_error( "order must be fifo or lifo: " + value );
+    config.lifo_ = "lifo" == value;
+  }
+  else if( "lifetime_ms" == name ) config.lifetime_ = ms();
+  else if( "io_timeout_ms" == name ) config.io_timeout_ = ms();
+  else if( "checkers_timeout_ms" == name ) config.checkers_timeout_ = ms();
+  else if( "budget_ms" == name ) config.budget_ = ms();
+  else if( "rate" == name ) config.rate_ = stod( value );
+  else if( "io_shards" == name )
+    config.io_shards_ = max( 1u, static_cast< unsigned >( stoul( value ) ) );
+  else if( "seed" == name ) config.seed_ = stoull( value );
+  else
+    throw runtime_error( "unknown parameter: " + name );
+}
+
+void report( const string & params, const sim_result & r, double wall_ms ) {
+  auto latencies = r.latencies_;
+  sort( latencies.begin(), latencies.end() );
+  const auto percentile = [&]( double p ) {
+    if( latencies.empty() )
+      return 0.0;
+    const auto i = min( latencies.size() - 1,
+        static_cast< size_t >( p * static_cast< double >( latencies.size() ) ) );
+    return chrono::duration< double, milli >( latencies[ i ] ).count();
+  };
+  const double makespan = chrono::duration< double >( r.makespan_ ).count();
+
+  char line[ 512 ];
+  snprintf( line, sizeof(line),
+      " makespan_s=%.3f throughput=%.1f"
+      " p50_ms=%.1f p90_ms=%.1f p99_ms=%.1f max_ms=%.1f"
+      " safe=%zu suspicious=%zu dangerous=%zu failure=%zu timedout=%zu"
+      " events=%llu wall_ms=%.1f trace=%016llx",
+      makespan,
+      makespan > 0 ? static_cast< double >( latencies.size() ) / makespan : 0.0,
+      percentile( 0.5 ), percentile( 0.9 ), percentile( 0.99 ), percentile( 1.0 ),
+      r.statuses_[ 0 ], r.statuses_[ 1 ], r.statuses_[ 2 ],
+      r.statuses_[ 3 ], r.statuses_[ 4 ],
+      static_cast< unsigned long long >( r.events_ ), wall_ms,
+      static_cast< unsigned long long >( r.trace_hash_ ) );
+  cout << "sim:" << params << line << endl;
+}
+
+using sweep_t = vector< pair< string, vector< string > > >;
+
+// Прогоны для всех сочетаний значений параметров, начиная с index-ого.
+void run_sweep( const sweep_t & sweep, size_t index,
+  sim_config config, const string & params )
+{
+  if( index == sweep.size() ) {
+    const auto started_at = chrono::steady_clock::now();
+    const auto result = pipeline_model( config ).run();
+    const chrono::duration< double, milli > wall =
+        chrono::steady_clock::now() - started_at;
+    report( params, result, wall.count() );
+    return;
+  }
+
+  for( const auto & value : sweep[ index ].second ) {
+    set_param( config, sweep[ index ].first, value );
+    run_sweep( sweep, index + 1, config,
+        params + " " + sweep[ index ].first + "=" + value );
+  }
+}
+
+int main( int argc, char ** argv ) {
+  try {
+    sweep_t sweep;
+    for( int i = 1; i < argc; ++i ) {
+      const string arg = argv[ i ];
+      const auto eq = arg.find( '=' );
+      if( string::npos == eq )
+        throw runtime_error( "usage: policy_sim [name=value[,value...]]..." );
+
+      vector< string > values;
+      for( size_t from = eq + 1;; ) {
+        const auto comma = arg.find( ',', from );
+        values.push_back( arg.substr( from, comma - from ) );
+        if( string::npos == comma )
+          break;
+        from = comma + 1;
+      }
+      sweep.emplace_back( arg.substr( 0, eq ), move(values) );
+    }
+
+    // Неправильные параметры лучше обнаружить до первого прогона.
+    sim_config check;
+    for( const auto & p : sweep )
+      for( const auto & v : p.second )
+        set_param( check, p.first, v );
+    // Как и файл правил из EMAIL_IMITATION.
+    global_imitation_model();
+
+    run_sweep( sweep, 0, sim_config{}, string() );
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
@@ -0,0 +1,481 @@
+// Проверки корректности тех частей конвейера, результат которых
+// не виден в замерах: неправильный ответ в них выглядит так же, как
+// правильный, только приходит быстрее.
+//
+// Каждая проверка сравнивает результат с заведомо правильным, который
+// получается самым простым способом, и при расхождении сообщает о нем.
+// Код возврата 0 означает, что все проверки прошли.
+//
+// Использование: self_check [название проверки]
+
+#include <common/stuff.hpp>
+#include <common/email_stream.hpp>
+#include <common/spam_classifier.hpp>
+#include <common/uds_bridge.hpp>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <random>
+
+// Неудачная проверка.
+struct check_failed : public runtime_error {
+  using runtime_error::runtime_error;
+};
+
+void expect( bool condition, const string & what ) {
+  if( !condition )
+    throw check_failed( what );
+}
+
+//
+// Потоковый режим: порции приходят в случайные моменты, checker-ы
+// подтверждают их в случайном порядке, а из разосланных порций
+// должен собраться исходный email без пропусков и повторов.
+//
+
+// То же, что load_email_chunk, но без зависимости от IO-агента.
+struct test_chunk {
+  email_content content_;
+  uint64_t offset_;
+  bool last_;
+};
+
+string make_long_email( mt19937 & rng, size_t body_size ) {
+  string r;
+  for( int i = 0; i != 30; ++i )
+    r += "X-Header-" + to_string( i ) + ": " + string( rng() % 200, 'h' ) + "\r\n";
+  r += "\r\n";
+  while( r.size() < body_size ) {
+    const auto length = rng() % 120;
+    for( unsigned i = 0; i != length; ++i )
+      r += static_cast< char >( 'a' + rng() % 26 );
+    r += "\r\n";
+  }
+  return r;
+}
+
+void check_stream_reassembly() {
+  const unsigned consumers = 4;
+  mt19937 rng( 48 );
+
+  for( unsigned round = 0; round != 200; ++round ) {
+    const size_t chunk_size = 64 + rng() % 4096;
+    const auto email = make_long_email( rng, chunk_size * (3 + rng() % 10) );
+
+    chunk_flow< test_chunk > flow( consumers );
+    streaming_email_parser parser;
+
+    // Запрос к загрузчику, на который еще не пришел ответ.
+    bool requested = false;
+    uint64_t requested_offset = 0;
+    // Сколько подтверждений еще не отослано.
+    unsigned confirmations = 0;
+    // Сколько порций загружено, но еще не подтверждено всеми.
+    unsigned alive = 0;
+    unsigned max_alive = 0;
+
+    string content, body;
+    vector< string > headers;
+    bool finished = false;
+
+    const auto request = [&]( uint64_t offset ) {
+      expect( !requested, "second chunk request before the answer" );
+      requested = true;
+      requested_offset = offset;
+    };
+    const auto publish = [&]( const test_chunk & c ) {
+      expect( c.offset_ == content.size(), "chunk published out of order" );
+      if( !c.last_ )
+        request( c.offset_ + c.content_.size() );
+
+      const auto chunk = parser.feed( c.content_, c.last_ );
+      content.append( chunk.content_.data(), chunk.content_.size() );
+      headers.insert( headers.end(), chunk.headers_.begin(), chunk.headers_.end() );
+      body.append( chunk.body(), chunk.body_size() );
+      finished = c.last_;
+      confirmations += consumers;
+    };
+
+    request( 0 );
+    while( requested || confirmations ) {
+      // Случайно выбираем, что произойдет раньше: ответ загрузчика
+      // или очередное подтверждение.
+      if( requested && (!confirmations || 0 == rng() % 3) ) {
+        requested = false;
+        const auto length = min< uint64_t >( chunk_size, email.size() - requested_offset );
+        test_chunk c{
+            email_content{ acquire_email_arena(),
+                email.data() + requested_offset, static_cast< size_t >( length ) },
+            requested_offset,
+            requested_offset + length == email.size() };
+        max_alive = max( max_alive, ++alive );
+        flow.loaded( c, publish );
+      }
+      else {
+        --confirmations;
+        // Последнее подтверждение порции освобождает ее.
+        if( 0 == confirmations % consumers )
+          --alive;
+        flow.consumed( publish );
+      }
+    }
+
+    expect( finished, "last chunk was not published" );
+    expect( content == email, "reassembled email differs from the original" );
+    expect( max_alive <= 2, "more than two chunks of one email in memory" );
+
+    basic_parsed_email< allocator< char > > whole;
+    whole.parse( email.data(), email.size() );
+    expect( vector< string >( whole.headers().begin(), whole.headers().end() ) == headers,
+        "streamed headers differ from the parsed ones" );
+    expect( whole.body() == body, "streamed body differs from the parsed one" );
+  }
+}
+
+//
+// Список заблокированных адресов: поиск в дереве префиксов должен давать
+// тот же результат, что и перебор всех префиксов, а строки с ошибками
+// не должны попадать в список.
+//
+
+string format_address( const ip_address & a ) {
+  char buf[ 64 ];
+  if( a.v4_ )
+    snprintf( buf, sizeof(buf), "%u.%u.%u.%u",
+        static_cast< unsigned >( a.hi_ >> 56 ), static_cast< unsigned >( (a.hi_ >> 48) & 0xff ),
+        static_cast< unsigned >( (a.hi_ >> 40) & 0xff ), static_cast< unsigned >( (a.hi_ >> 32) & 0xff ) );
+  else {
+    string r;
+    for( int i = 0; i != 8; ++i ) {
+      const auto group = ((i < 4 ? a.hi_ : a.lo_) >> (16 * (3 - i % 4))) & 0xffff;
+      snprintf( buf, sizeof(buf), i ? ":%x" : "%x", static_cast< unsigned >( group ) );
+      r += buf;
+    }
+    return r;
+  }
+  return buf;
+}
+
+// Адрес, у которого первые length бит совпадают с base, а остальные
+// случайные.
+ip_address random_address_in( mt19937_64 & rng, const ip_address & base, unsigned length ) {
+  ip_address r = base;
+  const unsigned bits = base.v4_ ? 32 : 128;
+  for( unsigned i = length; i != bits; ++i ) {
+    const uint64_t mask = uint64_t{ 1 } << (63 - i % 64);
+    auto & word = i < 64 ? r.hi_ : r.lo_;
+    word = (rng() & 1) ? (word | mask) : (word & ~mask);
+  }
+  return r;
+}
+
+// Значение самого длинного подходящего префикса. При одинаковой длине
+// действует тот, что указан в файле позже.
+check_status brute_force_find(
+  const vector< prefix_trie::prefix > & prefixes, const ip_address & a )
+{
+  int best = -1;
+  uint8_t value = 0;
+  for( const auto & p : prefixes ) {
+    if( p.key_.v4_ != a.v4_ || static_cast< int >( p.length_ ) < best )
+      continue;
+    bool match = true;
+    for( unsigned offset = 0; match && offset < p.length_; offset += 64 ) {
+      const auto count = min( 64u, p.length_ - offset );
+      match = p.key_.bits( offset, count ) == a.bits( offset, count );
+    }
+    if( match ) {
+      best = static_cast< int >( p.length_ );
+      value = p.value_;
+    }
+  }
+  return 1 == value ? check_status::suspicious :
+      2 == value ? check_status::dangerous : check_status::safe;
+}
+
+void check_ip_blocklist() {
+  mt19937_64 rng( 38 );
+  const string file_name = "self_check_ip_blocklist.txt";
+
+  // Строки с ошибками, каждая из которых при неверном разборе
+  // заблокировала бы все адреса.
+  const char * const malformed =
+      "10.0.0.1/\n10.0.0.0/x\n10.0.0.0/-1\n10.0.0.0/ 8\n10.0.0.0/+8\n"
+      "10.0.0.0/33\n::ffff:10.0.0.0/95\n::ffff:10.0.0.0/\n2001:db8::/129\n";
+  {
+    ofstream file( file_name );
+    file << malformed;
+  }
+  const auto empty = load_ip_blocklist( file_name );
+  for( unsigned i = 0; i != 1000; ++i ) {
+    ip_address a;
+    a.v4_ = 0 != i % 2;
+    a.hi_ = a.v4_ ? rng() & 0xffffffff00000000ULL : rng();
+    a.lo_ = a.v4_ ? 0 : rng();
+    expect( check_status::safe == empty.find( a ),
+        "malformed line blocks " + format_address( a ) );
+  }
+
+  for( unsigned round = 0; round != 20; ++round ) {
+    vector< prefix_trie::prefix > expected;
+    ofstream file( file_name );
+    file << "# comment\n\n" << malformed;
+
+    for( unsigned i = 0; i != 2000; ++i ) {
+      ip_address key;
+      key.v4_ = 0 != rng() % 3;
+      key.hi_ = key.v4_ ? rng() & 0xffffffff00000000ULL : rng();
+      key.lo_ = key.v4_ ? 0 : rng();
+      const unsigned bits = key.v4_ ? 32 : 128;
+      // Много коротких префиксов, чтобы они перекрывались.
+      const unsigned length = static_cast< unsigned >( rng() % 3 ? rng() % (bits / 2 + 1) : rng() % (bits + 1) );
+      const uint8_t value = static_cast< uint8_t >( 1 + rng() % 2 );
+
+      // Адрес записывается без обнуления битов за пределами префикса,
+      // как это часто бывает в настоящих списках.
+      if( key.v4_ && 0 == rng() % 4 )
+        file << "::ffff:" << format_address( key ) << "/" << length + 96;
+      else
+        file << format_address( key ) << "/" << length;
+      file << (1 == value ? " suspicious\n" : " dangerous\n");
+      expected.push_back( prefix_trie::prefix{ key, length, value } );
+    }
+    file.close();
+
+    const auto blocklist = load_ip_blocklist( file_name );
+    for( unsigned i = 0; i != 20000; ++i ) {
+      const auto & p = expected[ rng() % expected.size() ];
+      const auto a = random_address_in( rng, p.key_, static_cast< unsigned >( rng() % (p.length_ + 1) ) );
+      expect( blocklist.find( a ) == brute_force_find( expected, a ),
+          "blocklist lookup differs from brute force for " + format_address( a ) );
+    }
+  }
+  remove( file_name.c_str() );
+
+  // Скорость поиска в списке из 100 тысяч префиксов. Только для
+  // сведения: на результат проверки не влияет.
+  vector< prefix_trie::prefix > v4;
+  for( unsigned i = 0; i != 100000; ++i ) {
+    ip_address key;
+    key.v4_ = true;
+    key.hi_ = rng() & 0xffffffff00000000ULL;
+    v4.push_back( prefix_trie::prefix{ key, 16 + static_cast< unsigned >( rng() % 17 ), 2 } );
+  }
+  const ip_blocklist big{ v4, {} };
+  vector< ip_address > addresses( 1 << 16 );
+  for( auto & a : addresses ) {
+    a.v4_ = true;
+    a.hi_ = rng() & 0xffffffff00000000ULL;
+  }
+
+  const size_t lookups = 10000000;
+  size_t blocked = 0;
+  const auto started_at = chrono::steady_clock::now();
+  for( size_t i = 0; i != lookups; ++i )
+    if( check_status::safe != big.find( addresses[ i & 0xffff ] ) )
+      ++blocked;
+  const chrono::duration< double, nano > elapsed = chrono::steady_clock::now() - started_at;
+  cout << "  ip_blocklist lookup: " << elapsed.count() / lookups << " ns ("
+      << blocked * 100 / lookups << "% blocked)" << endl;
+}
+
+//
+// Статистическая оценка: вариант с AVX2 gather должен давать ту же
+// сумму весов, что и простой цикл (с точностью до порядка сложения).
+//
+
+void check_spam_classifier() {
+  using namespace spam_classifier_details;
+
+  mt19937 rng( 36 );
+  const uint32_t bits = 20;
+  const string file_name = "self_check_spam_model.bin";
+  {
+    ofstream file( file_name, ios::binary );
+    const uint32_t header_bits = bits;
+    const float thresholds[] = { 0.0f, 1.0f, 2.0f };
+    file.write( "ESM1", 4 );
+    file.write( reinterpret_cast< const char * >( &header_bits ), sizeof(header_bits) );
+    file.write( reinterpret_cast< const char * >( thresholds ), sizeof(thresholds) );
+    uniform_real_distribution< float > weight( -0.5f, 0.5f );
+    for( uint32_t i = 0; i != (uint32_t{ 1 } << bits); ++i ) {
+      const float w = weight( rng );
+      file.write( reinterpret_cast< const char * >( &w ), sizeof(w) );
+    }
+  }
+
+  {
+    vector< float > weights( 1 << 12 );
+    uniform_real_distribution< float > weight( -0.5f, 0.5f );
+    for( auto & w : weights )
+      w = weight( rng );
+
+    uint32_t indexes[ 256 ];
+    uint32_t signs[ 256 ];
+    for( unsigned round = 0; round != 10000; ++round ) {
+      const size_t count = rng() % 257;
+      for( size_t i = 0; i != count; ++i ) {
+        indexes[ i ] = rng() & (weights.size() - 1);
+        signs[ i ] = rng() & 0x80000000u;
+      }
+      const auto expected = scalar_signed_sum( weights.data(), indexes, signs, count );
+      const auto actual = signed_gather_sum( weights.data(), indexes, signs, count );
+      expect( fabs( expected - actual ) <= 1e-3f,
+          "gather sum " + to_string( actual ) + " instead of " + to_string( expected ) );
+    }
+  }
+
+  // Скорость оценки email-ов с телом в 4 КБ. Только для сведения.
+  const spam_model model{ file_name };
+  vector< string > bodies;
+  const char * const words[] = { "free", "offer", "meeting", "report", "click",
+      "Here", "invoice", "tomorrow", "unsubscribe", "price", "http", "www" };
+  for( unsigned i = 0; i != 64; ++i ) {
+    string body;
+    while( body.size() < 4096 )
+      body += string( words[ rng() % 12 ] ) + (rng() % 8 ? " " : ".\r\n");
+    bodies.push_back( move(body) );
+  }
+  const vector< string > headers{ "Subject: quarterly report", "From: a@example.com" };
+
+  const size_t emails = 20000;
+  float total = 0.0f;
+  size_t bytes = 0;
+  const auto started_at = chrono::steady_clock::now();
+  for( size_t i = 0; i != emails; ++i ) {
+    const auto & body = bodies[ i % bodies.size() ];
+    total += model.score( headers, body );
+    bytes += body.size();
+  }
+  const chrono::duration< double, micro > elapsed = chrono::steady_clock::now() - started_at;
+  remove( file_name.c_str() );
+
+  cout << "  spam_model score: " << elapsed.count() * 1024 / static_cast< double >( bytes )
+      << " us per KB (" << (avx2_gather_available() ? "avx2" : "scalar")
+      << ", checksum " << total << ")" << endl;
+}
+
+//
+// Кадры моста между процессами: что записал frame_writer, то и должен
+// разобрать frame_reader. Имена передаются временными строками, как
+// это делает bridge_front, так что writer должен хранить их сам
+// до flush().
+//
+
+void check_bridge_frames() {
+  using namespace bridge_proto;
+
+  mt19937 rng( 30 );
+  int fds[ 2 ];
+  expect( 0 == ::socketpair( AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds ),
+      "socketpair failed" );
+
+  struct sent_request {
+    uint64_t id_;
+    string name_;
+    email_slice_t slice_;
+  };
+  vector< sent_request > requests;
+  vector< email_id_t > ids;
+
+  frame_writer writer;
+  for( uint64_t id = 1; id != 200; ++id ) {
+    // И короткие имена, которые хранятся внутри объекта string,
+    // и длинные, под которые выделяется память.
+    string name = "dir/new/" + to_string( id ) +
+        string( rng() % 2 ? rng() % 300 : 0, 'n' );
+    const email_slice_t slice{ rng() % 1000, rng() % 1000 };
+    const auto email = intern_email_name( name );
+    ids.push_back( email );
+
+    expect( writer.add_request( id, email_name( email ), slice, no_deadline ),
+        "request " + to_string( id ) + " rejected" );
+    requests.push_back( sent_request{ id, move(name), slice } );
+    if( id % 7 == 0 )
+      writer.add_result( id, check_status::dangerous );
+    if( id % 11 == 0 )
+      writer.add_ping( frame_type::ping, id );
+  }
+  expect( !writer.add_request( 0, string( max_name_size + 1, 'x' ),
+        email_slice_t{}, no_deadline ),
+      "overlong name accepted" );
+  for( auto id : ids )
+    release_email_name( id );
+
+  expect( writer.flush( fds[ 0 ] ), "flush failed" );
+  ::close( fds[ 0 ] );
+
+  frame_reader reader;
+  size_t next_request = 0;
+  size_t results = 0;
+  size_t pings = 0;
+  while( reader.read_from( fds[ 1 ] ) > 0 )
+    expect( reader.consume( [&]( frame_type type, const char * data, size_t size ) {
+        request_body r;
+        result_body result;
+        ping_body p;
+        if( frame_type::request == type ) {
+          expect( read_body( data, size, r ) && size == sizeof(r) + r.name_size_,
+              "bad request frame" );
+          expect( next_request < requests.size(), "extra request frame" );
+          const auto & e = requests[ next_request++ ];
+          expect( e.id_ == r.id_ &&
+              e.name_ == string( data + sizeof(r), r.name_size_ ) &&
+              e.slice_.offset_ == r.offset_ && e.slice_.length_ == r.length_ &&
+              0 == r.budget_ms_,
+              "request " + to_string( e.id_ ) + " corrupted" );
+        }
+        else if( frame_type::result == type ) {
+          expect( read_body( data, size, result ) && 0 == result.id_ % 7 &&
+              static_cast< uint8_t >( check_status::dangerous ) == result.status_,
+              "bad result frame" );
+          ++results;
+        }
+        else if( frame_type::ping == type ) {
+          expect( read_body( data, size, p ) && 0 == p.stamp_ % 11, "bad ping frame" );
+          ++pings;
+        }
+        else
+          expect( false, "unknown frame type" );
+      } ),
+      "oversized frame" );
+  ::close( fds[ 1 ] );
+
+  expect( requests.size() == next_request,
+      to_string( next_request ) + " of " + to_string( requests.size() ) + " requests received" );
+  expect( 28 == results && 18 == pings, "results or pings lost" );
+}
+
+const pair< const char *, function< void() > > checks[] = {
+  { "stream_reassembly", check_stream_reassembly },
+  { "ip_blocklist", check_ip_blocklist },
+  { "spam_classifier", check_spam_classifier },
+  { "bridge_frames", check_bridge_frames },
+};
+
+int main( int argc, char ** argv ) {
+  const string only = argc > 1 ? argv[1] : "";
+  int failed = 0;
+  bool found = false;
+  for( const auto & c : checks ) {
+    if( !only.empty() && only != c.first )
+      continue;
+    found = true;
+    try {
+      c.second();
+      cout << c.first << ": ok" << endl;
+    }
+    catch( const exception & x ) {
+      cout << c.first << ": FAILED: " << x.what() << endl;
+      ++failed;
+    }
+  }
+
+  if( !found ) {
+    cerr << "unknown check: " << only << endl;
+    return 2;
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,378 @@
+// Сравнение диспетчера с перехватом работы (work_stealing_disp.hpp)
+// со стандартным thread_pool-диспетчером на коротких задачах.
+//
+// Замеры двух видов:
+//
+// - pool: сами пулы нитей без SObjectizer. Пул с одной общей очередью
+//   под замком (так устроена очередь готовых агентов у thread_pool)
+//   против work_stealing_pool. Задачи ставят четыре внешние нити
+//   (external), либо внешние нити ставят задачи-"анализаторы", каждая
+//   из которых ставит еще четыре задачи-"checker-а" уже с рабочей нити
+//   (fanout). Выводятся количество задач в секунду, количество
+//   ожиданий на замках очередей и количество перехваченных задач
+//   на тысячу задач;
+//
+// - so: кооперации из четырех агентов, которые сразу же отвечают и
+//   завершаются (как checker-ы в v7), на именованном диспетчере
+//   "checkers": thread_pool или work stealing. Выводится количество
+//   коопераций в секунду.
+//
+// Каждый замер выполняется для 2, 8 и 32 рабочих нитей.
+//
+// Использование: steal_bench [pool|so|all] [количество задач]
+
+#include <common/messages.hpp>
+#include <common/work_stealing_disp.hpp>
+
+#include <iomanip>
+
+using clock_type = chrono::steady_clock;
+
+// Имитация короткой проверки: несколько сотен наносекунд работы.
+void short_work() {
+  volatile unsigned v = 0;
+  for( unsigned i = 0; i != 200; ++i )
+    v = v + i;
+}
+
+//
+// Пул с одной общей очередью для сравнения.
+//
+class shared_queue_pool {
+public :
+  explicit shared_queue_pool( size_t threads ) : threads_( threads ) {}
+
+  ~shared_queue_pool() {
+    stop();
+    join();
+  }
+
+  void start() {
+    for( auto & t : threads_ )
+      t = thread( [this]{ body(); } );
+  }
+
+  void stop() {
+    {
+      lock_guard< mutex > lock{ lock_ };
+      shutdown_ = true;
+    }
+    cv_.notify_all();
+  }
+
+  void join() {
+    for( auto & t : threads_ )
+      if( t.joinable() )
+        t.join();
+  }
+
+  void schedule( stealable_task * task ) {
+    bool wake;
+    {
+      auto lock = acquire();
+      tasks_.push_back( task );
+      wake = 0 != sleepers_;
+    }
+    if( wake )
+      cv_.notify_one();
+  }
+
+  uint64_t contended() const { return contended_.load( memory_order_relaxed ); }
+
+private :
+  vector< thread > threads_;
+  mutex lock_;
+  condition_variable cv_;
+  deque< stealable_task * > tasks_;
+  size_t sleepers_{ 0 };
+  bool shutdown_{ false };
+  atomic< uint64_t > contended_{ 0 };
+
+  unique_lock< mutex > acquire() {
+    unique_lock< mutex > lock{ lock_, try_to_lock };
+    if( !lock.owns_lock() ) {
+      contended_.fetch_add( 1, memory_order_relaxed );
+      lock.lock();
+    }
+    return lock;
+  }
+
+  void body() {
+    for(;;) {
+      auto lock = acquire();
+      while( tasks_.empty() && !shutdown_ ) {
+        ++sleepers_;
+        cv_.wait( lock );
+        --sleepers_;
+      }
+      if( tasks_.empty() )
+        return;
+
+      auto * task = tasks_.front();
+      tasks_.pop_front();
+      lock.unlock();
+      task->execute();
+    }
+  }
+};
+
+//
+// Задачи для замера pool.
+//
+template< typename POOL >
+struct pool_workload {
+  POOL & pool_;
+  atomic< size_t > remaining_;
+  // Сколько задач-"checker-ов" ставит каждая задача-"анализатор".
+  const unsigned fanout_;
+
+  struct task final : public stealable_task {
+    pool_workload * owner_;
+    // Номер первой дочерней задачи или 0, если дочерних нет.
+    size_t children_;
+
+    virtual void execute() override {
+      short_work();
+      if( children_ )
+        for( unsigned i = 0; i != owner_->fanout_; ++i )
+          owner_->pool_.schedule( &owner_->tasks_[ children_ + i ] );
+      owner_->remaining_.fetch_sub( 1, memory_order_release );
+    }
+  };
+
+  vector< task > tasks_;
+
+  pool_workload( POOL & pool, size_t total, unsigned fanout )
+    : pool_( pool ), remaining_( total ), fanout_( fanout ), tasks_( total )
+  {
+    for( auto & t : tasks_ )
+      t.owner_ = this;
+  }
+};
+
+struct pool_result {
+  double tasks_per_sec_{};
+  double contended_per_1000_{};
+  double stolen_per_1000_{};
+};
+
+uint64_t contended_of( const shared_queue_pool & pool ) { return pool.contended(); }
+uint64_t contended_of( const work_stealing_pool & pool ) { return pool.stats().contended_; }
+uint64_t stolen_of( const shared_queue_pool & ) { return 0; }
+uint64_t stolen_of( const work_stealing_pool & pool ) { return pool.stats().stolen_; }
+
+template< typename POOL >
+pool_result run_pool_bench( size_t threads, size_t total, unsigned fanout ) {
+  const unsigned producers = 4;
+
+  POOL pool( threads );
+  pool_workload< POOL > workload( pool, total, fanout );
+
+  // Номера задач, которые ставят внешние нити. При fanout за каждой
+  // такой задачей идут ее дочерние.
+  vector< size_t > roots;
+  for( size_t i = 0; i < total; i += 1 + fanout ) {
+    if( fanout && i + fanout < total )
+      workload.tasks_[ i ].children_ = i + 1;
+    else
+      // Хвост, на котором не хватает места для дочерних задач.
+      for( size_t j = i + 1; j < min( total, i + 1 + fanout ); ++j )
+        roots.push_back( j );
+    roots.push_back( i );
+  }
+
+  pool.start();
+  const auto started_at = clock_type::now();
+
+  vector< thread > sources;
+  for( unsigned p = 0; p != producers; ++p )
+    sources.emplace_back( [&, p]{
+        for( size_t i = p; i < roots.size(); i += producers )
+          pool.schedule( &workload.tasks_[ roots[ i ] ] );
+      } );
+  for( auto & t : sources )
+    t.join();
+  while( workload.remaining_.load( memory_order_acquire ) )
+    this_thread::yield();
+
+  const chrono::duration< double > elapsed = clock_type::now() - started_at;
+  pool.stop();
+  pool.join();
+
+  const auto per_1000 = [total]( uint64_t v ) {
+    return static_cast< double >( v ) * 1000.0 / static_cast< double >( total );
+  };
+  return pool_result{
+      static_cast< double >( total ) / elapsed.count(),
+      per_1000( contended_of( pool ) ),
+      per_1000( stolen_of( pool ) ) };
+}
+
+//
+// Агенты для замера so.
+//
+class short_checker final : public agent_t {
+public :
+  struct done : public signal_t {};
+
+  // Сколько checker-ов кооперации еще не закончили работу.
+  using coop_counter = shared_ptr< atomic< unsigned > >;
+
+  short_checker( context_t ctx, mbox_t reply_to, coop_counter left )
+    : agent_t( ctx ), reply_to_( move(reply_to) ), left_( move(left) )
+  {}
+
+  virtual void so_evt_start() override {
+    short_work();
+    send< done >( reply_to_ );
+    // Последний из checker-ов кооперации уничтожает ее.
+    if( 1 == left_->fetch_sub( 1, memory_order_acq_rel ) )
+      so_deregister_agent_coop_normally();
+  }
+
+private :
+  const mbox_t reply_to_;
+  const coop_counter left_;
+};
+
+class coop_driver final : public agent_t {
+  // Сколько коопераций checker-ов существует одновременно.
+  static constexpr size_t in_flight = 256;
+  static constexpr unsigned checkers_per_coop = 4;
+
+public :
+  coop_driver( context_t ctx, bool work_stealing, size_t total, double & coops_per_sec )
+    : agent_t( ctx )
+    , work_stealing_( work_stealing )
+    , total_( total )
+    , coops_per_sec_( coops_per_sec )
+  {
+    so_subscribe_self().event< short_checker::done >( &coop_driver::on_done );
+  }
+
+  virtual void so_evt_start() override {
+    started_at_ = clock_type::now();
+    while( started_ < min( total_, in_flight ) )
+      start_coop();
+  }
+
+private :
+  const bool work_stealing_;
+  const size_t total_;
+  double & coops_per_sec_;
+
+  clock_type::time_point started_at_;
+  size_t started_{ 0 };
+  size_t replies_{ 0 };
+
+  void start_coop() {
+    ++started_;
+    introduce_child_coop( *this,
+      work_stealing_ ?
+          create_work_stealing_disp_binder( "checkers" ) :
+          disp::thread_pool::create_disp_binder(
+              "checkers", disp::thread_pool::bind_params_t{} ),
+      [this]( coop_t & coop ) {
+        auto left = make_shared< atomic< unsigned > >( checkers_per_coop );
+        for( unsigned i = 0; i != checkers_per_coop; ++i )
+          coop.make_agent< short_checker >( so_direct_mbox(), left );
+      } );
+  }
+
+  void on_done() {
+    ++replies_;
+    // Каждые checkers_per_coop ответов -- это одна завершенная
+    // кооперация, вместо которой запускается новая.
+    if( 0 == replies_ % checkers_per_coop && started_ < total_ )
+      start_coop();
+
+    if( replies_ == total_ * checkers_per_coop ) {
+      const chrono::duration< double > elapsed = clock_type::now() - started_at_;
+      coops_per_sec_ = static_cast< double >( total_ ) / elapsed.count();
+      so_environment().stop();
+    }
+  }
+};
+
+constexpr size_t coop_driver::in_flight;
+constexpr unsigned coop_driver::checkers_per_coop;
+
+double run_so_bench( bool work_stealing, size_t threads, size_t coops ) {
+  double coops_per_sec = 0;
+  so_5::launch( [&]( environment_t & env ) {
+      env.introduce_coop( [&]( coop_t & coop ) {
+        coop.make_agent< coop_driver >( work_stealing, coops, coops_per_sec );
+      } );
+    },
+    [work_stealing, threads]( environment_params_t & params ) {
+      params.add_named_dispatcher( "checkers",
+          work_stealing ?
+              create_work_stealing_disp( threads ) :
+              disp::thread_pool::create_disp( threads ) );
+    } );
+  return coops_per_sec;
+}
+
+const size_t thread_counts[] = { 2, 8, 32 };
+
+void pool_bench( size_t tasks ) {
+  cout << "pool: " << tasks << " task(s)\n\n"
+      << setw( 10 ) << "workload"
+      << setw( 8 ) << "threads"
+      << setw( 16 ) << "pool"
+      << setw( 14 ) << "tasks/s"
+      << setw( 16 ) << "waits/1000"
+      << setw( 16 ) << "steals/1000" << endl;
+
+  for( unsigned fanout : { 0u, 4u } )
+    for( auto threads : thread_counts ) {
+      const auto print = [&]( const char * name, const pool_result & r ) {
+        cout << setw( 10 ) << (fanout ? "fanout" : "external")
+            << setw( 8 ) << threads
+            << setw( 16 ) << name
+            << setw( 14 ) << static_cast< uint64_t >( r.tasks_per_sec_ )
+            << setw( 16 ) << fixed << setprecision( 2 ) << r.contended_per_1000_
+            << setw( 16 ) << r.stolen_per_1000_ << endl;
+      };
+      print( "shared_queue",
+          run_pool_bench< shared_queue_pool >( threads, tasks, fanout ) );
+      print( "work_stealing",
+          run_pool_bench< work_stealing_pool >( threads, tasks, fanout ) );
+    }
+  cout << endl;
+}
+
+void so_bench( size_t coops ) {
+  cout << "so: " << coops << " coop(s) of 4 checkers\n\n"
+      << setw( 8 ) << "threads"
+      << setw( 16 ) << "thread_pool"
+      << setw( 16 ) << "work_stealing" << "  (coops/s)" << endl;
+
+  for( auto threads : thread_counts )
+    cout << setw( 8 ) << threads
+        << setw( 16 ) << static_cast< uint64_t >( run_so_bench( false, threads, coops ) )
+        << setw( 16 ) << static_cast< uint64_t >( run_so_bench( true, threads, coops ) )
+        << endl;
+  cout << endl;
+}
+
+int main( int argc, char ** argv ) {
+  try {
+    const string what = argc > 1 ? argv[1] : "all";
+    const size_t count = argc > 2 ? stoul( argv[2] ) : 1000000;
+    if( "pool" != what && "so" != what && "all" != what )
+      throw runtime_error( "usage: steal_bench [pool|so|all] [tasks]" );
+
+    if( "so" != what )
+      pool_bench( count );
+    if( "pool" != what )
+      // Создание кооперации намного дороже короткой задачи.
+      so_bench( max< size_t >( 1, count / 20 ) );
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
@@ -0,0 +1,185 @@
+// Замер производительности механизмов таймеров SObjectizer на той смеси
+// таймеров, которая возникает в конвейере проверки email-ов:
+//
+// - отложенный ответ IO-агента: 10 мс на символ имени (около 120 мс);
+// - тайм-аут ожидания ответа IO-агента: 1500 мс, почти всегда отменяется;
+// - отложенный ответ checker-а: 50 + (i % 7) * 110 мс;
+// - тайм-аут ожидания checker-ов: 750 мс, почти всегда отменяется.
+//
+// Для каждого механизма (wheel, heap, list) измеряются:
+// - скорость взведения таймеров;
+// - скорость отмены тайм-аутов;
+// - отклонение момента срабатывания от заданного (p50, p99, max).
+
+#include <common/messages.hpp>
+#include <common/timer_mechanism.hpp>
+
+#include <algorithm>
+#include <iomanip>
+
+using clock_type = chrono::steady_clock;
+
+struct bench_result {
+  double arm_per_sec_{};
+  double cancel_per_sec_{};
+  chrono::microseconds jitter_p50_{};
+  chrono::microseconds jitter_p99_{};
+  chrono::microseconds jitter_max_{};
+};
+
+// Задержка i-го таймера в смеси. Возвращается также признак того,
+// что это тайм-аут, который в конвейере обычно отменяется.
+pair< chrono::milliseconds, bool > pipeline_timer( size_t i ) {
+  switch( i % 6 ) {
+    case 0: return { chrono::milliseconds( 120 ), false };
+    case 1: return { chrono::milliseconds( 1500 ), true };
+    case 2: return { chrono::milliseconds( 750 ), true };
+    default: return { chrono::milliseconds( 50 + (i % 7) * 110 ), false };
+  }
+}
+
+class timer_bench final : public agent_t {
+  struct dummy : public signal_t {};
+
+  struct fired {
+    clock_type::time_point expected_;
+  };
+
+public :
+  timer_bench(
+    context_t ctx,
+    size_t armed_timers,
+    size_t fired_timers,
+    bench_result & result )
+    : agent_t( ctx )
+    , armed_timers_( armed_timers )
+    , fired_timers_( fired_timers )
+    , result_( result )
+  {
+    so_subscribe_self()
+      .event< dummy >( []{} )
+      .event( &timer_bench::on_fired );
+  }
+
+  virtual void so_evt_start() override {
+    measure_arm_and_cancel();
+
+    // Теперь взводим таймеры, срабатывание которых будем дожидаться.
+    lateness_.reserve( fired_timers_ );
+    const auto now = clock_type::now();
+    for( size_t i = 0; i != fired_timers_; ++i ) {
+      const auto delay = pipeline_timer( i * 6 + 3 ).first;
+      send_delayed< fired >( *this, delay, now + delay );
+    }
+  }
+
+private :
+  const size_t armed_timers_;
+  const size_t fired_timers_;
+  bench_result & result_;
+
+  vector< chrono::microseconds > lateness_;
+
+  void measure_arm_and_cancel() {
+    vector< timer_id_t > timers;
+    timers.reserve( armed_timers_ );
+
+    const auto arm_started = clock_type::now();
+    for( size_t i = 0; i != armed_timers_; ++i )
+      // Однократный таймер, но с возможностью отмены.
+      timers.push_back( send_periodic< dummy >( *this,
+          pipeline_timer( i ).first, chrono::milliseconds::zero() ) );
+    const auto arm_finished = clock_type::now();
+
+    size_t cancelled = 0;
+    for( size_t i = 0; i != armed_timers_; ++i )
+      if( pipeline_timer( i ).second ) {
+        timers[ i ].release();
+        ++cancelled;
+      }
+    const auto cancel_finished = clock_type::now();
+
+    // Оставшиеся таймеры тоже отменяем, чтобы они не мешали замеру
+    // точности срабатывания.
+    timers.clear();
+
+    result_.arm_per_sec_ = per_second( armed_timers_, arm_finished - arm_started );
+    result_.cancel_per_sec_ = per_second( cancelled, cancel_finished - arm_finished );
+  }
+
+  void on_fired( const fired & msg ) {
+    lateness_.push_back( chrono::duration_cast< chrono::microseconds >(
+        clock_type::now() - msg.expected_ ) );
+
+    if( lateness_.size() == fired_timers_ ) {
+      sort( lateness_.begin(), lateness_.end() );
+      result_.jitter_p50_ = lateness_[ lateness_.size() / 2 ];
+      result_.jitter_p99_ = lateness_[ lateness_.size() * 99 / 100 ];
+      result_.jitter_max_ = lateness_.back();
+      so_environment().stop();
+    }
+  }
+
+  static double per_second( size_t count, clock_type::duration d ) {
+    const auto sec = chrono::duration< double >( d ).count();
+    return sec > 0 ? static_cast< double >( count ) / sec : 0.0;
+  }
+};
+
+bench_result run_bench( timer_mechanism m, size_t armed, size_t fired ) {
+  bench_result result;
+  so_5::launch( [&]( environment_t & env ) {
+      env.introduce_coop( [&]( coop_t & coop ) {
+        coop.make_agent< timer_bench >( armed, fired, result );
+      } );
+    },
+    [m]( environment_params_t & params ) {
+      use_timer_mechanism( params, m );
+    } );
+  return result;
+}
+
+int main( int argc, char ** argv ) {
+  try {
+    const size_t armed = argc > 1 ? stoul( argv[1] ) : 300000;
+    const size_t fired = argc > 2 ? stoul( argv[2] ) : 50000;
+
+    cout << "armed timers: " << armed << ", fired timers: " << fired << "\n\n"
+        << setw( 6 ) << "timer"
+        << setw( 10 ) << "armed"
+        << setw( 10 ) << "fired"
+        << setw( 14 ) << "arm/s"
+        << setw( 14 ) << "cancel/s"
+        << setw( 12 ) << "p50, us"
+        << setw( 12 ) << "p99, us"
+        << setw( 12 ) << "max, us" << endl;
+
+    for( auto m : { timer_mechanism::wheel, timer_mechanism::heap, timer_mechanism::list } ) {
+      // Взведение таймера в list в худшем случае требует просмотра всего
+      // списка, поэтому на полном объеме замер занял бы слишком много
+      // времени. Это относится и к взведению, и к срабатыванию, так что
+      // ограничиваются оба количества. В каждой строке выводятся те
+      // количества, которые использовались на самом деле.
+      const size_t list_limit = 20000;
+      const auto armed_count = timer_mechanism::list == m ?
+          min( armed, list_limit ) : armed;
+      const auto fired_count = timer_mechanism::list == m ?
+          min( fired, list_limit ) : fired;
+      const auto r = run_bench( m, armed_count, fired_count );
+      cout << setw( 6 ) << timer_mechanism_name( m )
+          << setw( 10 ) << armed_count
+          << setw( 10 ) << fired_count
+          << setw( 14 ) << static_cast< uint64_t >( r.arm_per_sec_ )
+          << setw( 14 ) << static_cast< uint64_t >( r.cancel_per_sec_ )
+          << setw( 12 ) << r.jitter_p50_.count()
+          << setw( 12 ) << r.jitter_p99_.count()
+          << setw( 12 ) << r.jitter_max_.count() << endl;
+    }
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
@@ -1,16 +1,20 @@
 #include <common/stuff.hpp>
 
+#if defined(EMAIL_COUNT_ALLOCATIONS)
+  #include <common/counting_new.hpp>
+#endif
+
 // Агент для анализа содержимого одного email-а.
 // Получает все нужные ему параметры в конструкторе,
 // выполняет все свои действия в единственном методе so_evt_start.
 class email_analyzer : public agent_t {
 public :
   email_analyzer( context_t ctx,
-    // Имя файла с email для анализа.
-    string email_file,
+    // Идентификатор файла с email для анализа.
+    email_id_t email_file,
     // Куда нужно отослать результат анализа.
     mbox_t reply_to )
-    : agent_t(ctx), email_file_(move(email_file)), reply_to_(move(reply_to))
+    : agent_t(ctx), email_file_(email_file), reply_to_(move(reply_to))
   {}
 
   virtual void so_evt_start() override {
@@ -37,7 +41,7 @@ public :
   }
 
 private :
-  const string email_file_;
+  const email_id_t email_file_;
   const mbox_t reply_to_;
 };
 
@@ -82,7 +86,7 @@ private :
 
 int main() {
   try {
-    do_imitation< analyzer_manager >( 5000 );
+    do_imitation< analyzer_manager >( 5000, timer_mechanism_from_env() );
     return 0;
   }
   catch( const exception & x ) {
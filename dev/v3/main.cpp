@@ -1,5 +1,9 @@
 #include <common/stuff.hpp>
 
+#if defined(EMAIL_COUNT_ALLOCATIONS)
+  #include <common/counting_new.hpp>
+#endif
+
 #include <list>
 
 // Агент для анализа содержимого одного email-а.
@@ -8,11 +12,11 @@
 class email_analyzer : public agent_t {
 public :
   email_analyzer( context_t ctx,
-    // Имя файла с email для анализа.
-    string email_file,
+    // Идентификатор файла с email для анализа.
+    email_id_t email_file,
     // Куда нужно отослать результат анализа.
     mbox_t reply_to )
-    : agent_t(ctx), email_file_(move(email_file)), reply_to_(move(reply_to))
+    : agent_t(ctx), email_file_(email_file), reply_to_(move(reply_to))
   {}
 
   virtual void so_evt_start() override {
@@ -39,7 +43,7 @@ public :
   }
 
 private :
-  const string email_file_;
+  const email_id_t email_file_;
   const mbox_t reply_to_;
 };
 
@@ -135,7 +139,7 @@ private :
 
 int main() {
   try {
-    do_imitation< analyzer_manager >( 5000 );
+    do_imitation< analyzer_manager >( 5000, timer_mechanism_from_env() );
     return 0;
   }
   catch( const exception & x ) {
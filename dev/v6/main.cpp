@@ -1,6 +1,10 @@
 #include <common/stuff.hpp>
 #include <common/io_agent.hpp>
 
+#if defined(EMAIL_COUNT_ALLOCATIONS)
+  #include <common/counting_new.hpp>
+#endif
+
 #include <list>
 
 class email_analyzer : public agent_t {
@@ -10,9 +14,9 @@ class email_analyzer : public agent_t {
 
 public :
   email_analyzer( context_t ctx,
-    string email_file,
+    email_id_t email_file,
     mbox_t reply_to )
-    : agent_t(ctx), email_file_(move(email_file)), reply_to_(move(reply_to))
+    : agent_t(ctx), email_file_(email_file), reply_to_(move(reply_to))
   {}
 
   virtual void so_define_agent() override {
@@ -36,7 +40,7 @@ public :
   }
 
 private :
-  const string email_file_;
+  const email_id_t email_file_;
   const mbox_t reply_to_;
 
   void on_load_succeed( const load_email_succeed & msg ) {
@@ -182,7 +186,9 @@ private :
   }
 };
 
-void do_imitation() {
+void do_imitation( timer_mechanism timer ) {
+  load_check_data();
+
   so_5::launch( [=]( environment_t & env ) {
     // Запускаем IO-агента, который уже должен работать к моменту,
     // когда появятся первые агенты email_analyzer.
@@ -205,12 +211,15 @@ void do_imitation() {
       [checker_mbox]( coop_t & coop ) {
         coop.make_agent< requests_initiator >( checker_mbox, 5000u );
       } );
+  },
+  [timer]( environment_params_t & params ) {
+    use_timer_mechanism( params, timer );
   } );
 }
 
 int main() {
   try {
-    do_imitation();
+    do_imitation( timer_mechanism_from_env() );
     return 0;
   }
   catch( const exception & x ) {
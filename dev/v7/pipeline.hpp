@@ -0,0 +1,838 @@
+#pragma once
+
+//
+// Конвейер проверки email-ов из v7: IO-агент, агенты-checker-ы,
+// email_analyzer и analyzer_manager.
+//
+// Вынесен в отдельный файл для того, чтобы его можно было использовать
+// не только с имитатором запросов, но и с другими источниками email-ов.
+//
+
+#include <common/stuff.hpp>
+#include <common/io_agent.hpp>
+#include <common/email_stream.hpp>
+#include <common/imitation.hpp>
+#include <common/thread_placement.hpp>
+#include <common/work_stealing_disp.hpp>
+#include <common/io_hedging.hpp>
+#include <common/spam_classifier.hpp>
+#include <common/verdict_store.hpp>
+
+#include <list>
+
+// Имитация агентов-checker-ов конкретных частей сообщения.
+// Поскольку все имитаторы будут одинаковыми, используем шаблон,
+// который будет параметризоваться типами-тегами.
+// Тег определяет, какую часть разобранного email-а проверяет checker,
+// и как выполняется быстрая проверка этой части. Если быстрая проверка
+// окончательная (final_check), то длительная проверка не имитируется.
+// Для потокового режима тег задает состояние проверки по порциям
+// (см. email_stream.hpp).
+struct headers_checker_tag {
+  static constexpr bool final_check = false;
+  using stream = headers_stream;
+  static const auto & data( const parsed_email & email ) {
+    return email.headers();
+  }
+  static check_status check( const parsed_email & email ) {
+    return check_headers( data( email ) );
+  }
+};
+struct body_checker_tag {
+  static constexpr bool final_check = false;
+  using stream = body_stream;
+  static const auto & data( const parsed_email & email ) {
+    return email.body();
+  }
+  static check_status check( const parsed_email & email ) {
+    return check_body( data( email ) );
+  }
+};
+struct attach_checker_tag {
+  static constexpr bool final_check = false;
+  using stream = attachments_stream;
+  static const auto & data( const parsed_email & email ) {
+    return email.attachments();
+  }
+  static check_status check( const parsed_email & email ) {
+    return check_attachments( data( email ) );
+  }
+};
+// Статистическая оценка всего email-а целиком. Она занимает единицы
+// микросекунд, поэтому ничего не имитирует.
+struct score_checker_tag {
+  static constexpr bool final_check = true;
+  using stream = score_stream;
+  static const parsed_email & data( const parsed_email & email ) {
+    return email;
+  }
+  static check_status check( const parsed_email & email ) {
+    return score_email( data( email ) );
+  }
+};
+
+// Агенты-checker-ы работают на именованном диспетчере "checkers".
+// По умолчанию это thread_pool, а при EMAIL_CHECKERS_DISP=work_stealing
+// -- диспетчер с перехватом работы (см. common/work_stealing_disp.hpp).
+bool checkers_use_work_stealing() {
+  static const bool v = []{
+    const char * name = getenv( "EMAIL_CHECKERS_DISP" );
+    if( !name || 0 == strcmp( name, "thread_pool" ) )
+      return false;
+    if( 0 == strcmp( name, "work_stealing" ) )
+      return true;
+    throw runtime_error( string( "unknown EMAIL_CHECKERS_DISP: " ) + name );
+  }();
+  return v;
+}
+
+disp_binder_unique_ptr_t make_checkers_disp_binder() {
+  if( checkers_use_work_stealing() )
+    return create_work_stealing_disp_binder( "checkers" );
+  return disp::thread_pool::create_disp_binder(
+      "checkers", disp::thread_pool::bind_params_t{} );
+}
+
+// Результат checker-а. У каждого checker-а свой тип результата.
+template< typename TAG >
+struct checker_result { check_status status_; };
+
+// Ответ checker-а по результату быстрой проверки. Если быстрая проверка
+// не дала отрицательного результата и не окончательная, то
+// имитируется длительная проверка.
+template< typename TAG >
+void reply_checker_verdict(
+  agent_t & checker,
+  const mbox_t & reply_to,
+  deadline_t deadline,
+  check_status quick )
+{
+  using result = checker_result< TAG >;
+
+  // Если быстрая проверка уже дала отрицательный результат, то
+  // имитировать длительную проверку не нужно.
+  if( check_status::safe != quick || TAG::final_check ) {
+    send< result >( reply_to, quick );
+    return;
+  }
+
+  const auto imitation = imitate_checker();
+  if( imitation.lost_ )
+    // Вообще ничего не возвращаем.
+    // У email_analyzer-а должен сработать тайм-аут.
+    return;
+
+  const auto pause = imitation.pause_;
+  if( time_left( deadline, pause ) < pause )
+    // Результат опоздает, поэтому сразу сообщаем о тайм-ауте.
+    send< result >( reply_to, check_status::check_timedout );
+  else
+    send_delayed< result >(
+        checker.so_environment(), reply_to, pause, imitation.status_ );
+}
+
+template< typename TAG >
+class checker_template : public agent_t {
+public :
+  using result = checker_result< TAG >;
+
+  // Вместо копии проверяемых данных checker получает ссылку на
+  // разобранный email. Данные при этом остаются в арене email-а,
+  // которая не будет освобождена, пока checker жив.
+  checker_template(
+    context_t ctx,
+    mbox_t reply_to,
+    parsed_email_ref email,
+    deadline_t deadline )
+    : agent_t(ctx)
+    , reply_to_(move(reply_to) )
+    , email_(move(email))
+    , deadline_(deadline)
+  {}
+
+  virtual void so_evt_start() override {
+    pin_current_thread( placement_role::checkers );
+
+    if( deadline_expired( deadline_ ) ) {
+      // Проверять уже поздно.
+      send< result >( reply_to_, check_status::check_timedout );
+      return;
+    }
+
+    reply_checker_verdict< TAG >( *this, reply_to_, deadline_,
+        TAG::check( *email_ ) );
+  }
+
+private :
+  mbox_t reply_to_;
+  const parsed_email_ref email_;
+  const deadline_t deadline_;
+};
+
+// Checker для потокового режима. Получает порции email-а через mbox,
+// общий для всех checker-ов email-а, и подтверждает каждую порцию,
+// даже если его результат уже известен.
+template< typename TAG >
+class streaming_checker_template : public agent_t {
+public :
+  using result = checker_result< TAG >;
+
+  streaming_checker_template(
+    context_t ctx,
+    mbox_t reply_to,
+    mbox_t chunks,
+    deadline_t deadline )
+    : agent_t(ctx)
+    , reply_to_(move(reply_to))
+    , chunks_(move(chunks))
+    , deadline_(deadline)
+  {}
+
+  virtual void so_define_agent() override {
+    so_subscribe( chunks_ ).event( &streaming_checker_template::on_chunk );
+  }
+
+  virtual void so_evt_start() override {
+    pin_current_thread( placement_role::checkers );
+  }
+
+private :
+  const mbox_t reply_to_;
+  const mbox_t chunks_;
+  const deadline_t deadline_;
+
+  typename TAG::stream state_;
+  bool done_{ false };
+
+  void on_chunk( const email_chunk & chunk ) {
+    if( !done_ && deadline_expired( deadline_ ) ) {
+      done_ = true;
+      send< result >( reply_to_, check_status::check_timedout );
+    }
+    else if( !done_ && state_.feed( chunk ) ) {
+      done_ = true;
+      reply_checker_verdict< TAG >( *this, reply_to_, deadline_, state_.status_ );
+    }
+
+    send< email_chunk_consumed >( reply_to_ );
+  }
+};
+
+using email_headers_checker = checker_template< headers_checker_tag >;
+using email_body_checker = checker_template< body_checker_tag >;
+using email_attach_checker = checker_template< attach_checker_tag >;
+using email_score_checker = checker_template< score_checker_tag >;
+
+// Список тегов checker-ов, который известен во время компиляции.
+// По нему генерируются подписки на результаты, создание checker-ов
+// и подсчет полученных результатов, поэтому для добавления нового
+// checker-а достаточно добавить его тег в список.
+template< typename... TAGS >
+struct checker_tags {
+  static constexpr unsigned size = sizeof...(TAGS);
+};
+
+namespace checker_tags_details {
+
+template< typename T >
+struct type_tag { using type = T; };
+
+template< typename TAG, typename... TAGS >
+struct index_of;
+
+template< typename TAG, typename... TAGS >
+struct index_of< TAG, TAG, TAGS... > {
+  static constexpr unsigned value = 0;
+};
+
+template< typename TAG, typename HEAD, typename... TAGS >
+struct index_of< TAG, HEAD, TAGS... > {
+  static constexpr unsigned value = 1 + index_of< TAG, TAGS... >::value;
+};
+
+} /* namespace checker_tags_details */
+
+// Вызов f( type_tag< TAG >{} ) для каждого тега из списка.
+template< typename... TAGS, typename F >
+void for_each_checker_tag( checker_tags< TAGS... >, F && f ) {
+  const int expand[] = { 0, (f( checker_tags_details::type_tag< TAGS >{} ), 0)... };
+  (void)expand;
+}
+
+// Порядковый номер тега в списке.
+template< typename TAG, typename... TAGS >
+constexpr unsigned checker_tag_index( checker_tags< TAGS... > ) {
+  return checker_tags_details::index_of< TAG, TAGS... >::value;
+}
+
+using v7_checker_tags = checker_tags<
+    headers_checker_tag,
+    body_checker_tag,
+    attach_checker_tag,
+    score_checker_tag >;
+
+// Количество IO-агентов. Запрос к IO-агенту, который долго не отвечает,
+// дублируется другому IO-агенту.
+const unsigned io_agent_shards = 2;
+
+class email_analyzer : public agent_t {
+  // Сигнал о том, что ответ от IO-агента задерживается, и пора
+  // отсылать дублирующий запрос.
+  struct hedge_io : public signal_t {};
+
+  state_t st_wait_io{ this };
+  state_t st_wait_checkers{ this };
+  // Большой email загружается порциями, и checker-ы работают
+  // одновременно с загрузкой (см. email_stream.hpp).
+  state_t st_streaming{ this };
+
+  state_t st_finishing{ this };
+  state_t st_failure{  initial_substate_of{ st_finishing } };
+  state_t st_success{ substate_of{ st_finishing } };
+
+public :
+  email_analyzer( context_t ctx,
+    email_id_t email_file,
+    mbox_t reply_to,
+    email_slice_t slice,
+    deadline_t deadline,
+    memory_ticket memory )
+    : agent_t(ctx)
+    , email_file_(email_file)
+    , reply_to_(move(reply_to))
+    , slice_(slice)
+    , deadline_(deadline)
+    , memory_(move(memory))
+  {}
+
+  virtual void so_define_agent() override {
+    // Опоздавшие ответы IO-агентов приходят уже в других состояниях,
+    // в которых для них нет обработчиков, поэтому они просто
+    // выбрасываются.
+    st_wait_io
+      .event( &email_analyzer::on_load_succeed )
+      .event( &email_analyzer::on_load_failed )
+      .event< hedge_io >( &email_analyzer::on_hedge_io );
+
+    st_streaming
+      .event( &email_analyzer::on_chunk_loaded )
+      .event( [this]( const load_email_failed & ) { st_failure.activate(); } )
+      .event< email_chunk_consumed >( &email_analyzer::on_chunk_consumed );
+
+    // У каждого checker-а свой тип результата, поэтому по результату
+    // сразу известно, от какого checker-а он пришел.
+    for_each_checker_tag( checkers{}, [this]( auto tag ) {
+        using TAG = typename decltype(tag)::type;
+        const auto handler =
+          [this]( const checker_result< TAG > & msg ) {
+            on_checker_result(
+                checker_tag_index< TAG >( checkers{} ), msg.status_ );
+          };
+        st_wait_checkers.event( handler );
+        st_streaming.event( handler );
+      } );
+
+    // Тайм-ауты для ожидания ответов назначаются при переходе в
+    // состояния ожидания, т.к. зависят от оставшегося до deadline
+    // времени.
+
+    // Для состояний, которые отвечают за завершение работы,
+    // нужно определить только обработчики входа.
+    st_finishing.on_enter( [this]{ so_deregister_agent_coop_normally(); } );
+    st_failure.on_enter( [this]{
+        // Если неудача вызвана исчерпанием отведенного времени,
+        // то об этом нужно сообщить явно.
+        if( check_status::check_failure == status_ &&
+            deadline_expired( deadline_ ) )
+          status_ = check_status::check_timedout;
+        send< check_result >( reply_to_, email_file_, status_, slice_ );
+      } );
+    st_success.on_enter( [this]{
+        send< check_result >(
+            reply_to_, email_file_, check_status::safe, slice_ );
+      } );
+  }
+
+  virtual void so_evt_start() override {
+    pin_current_thread( placement_role::analyzers );
+
+    if( email_should_stream( slice_ ) ) {
+      // Дублирование запросов для порций не используется.
+      if( enter_waiting_state( st_streaming, io_timeout_ + checkers_timeout_ ) )
+        start_streaming();
+      return;
+    }
+
+    // Пока запрос ждал своей очереди, время могло закончиться.
+    if( !enter_waiting_state( st_wait_io, io_timeout_ ) )
+      return;
+
+    // При старте сразу же отправляем запрос IO-агенту для загрузки
+    // содержимого email файла.
+    io_requested_at_ = chrono::steady_clock::now();
+    send_io_request( primary_io_shard() );
+    global_io_hedging().on_request_sent();
+
+    // Если ответ задержится дольше, чем обычно, будет отослан дубль.
+    hedge_timer_ = send_periodic< hedge_io >( *this,
+        global_io_hedging().hedge_delay(), chrono::milliseconds::zero() );
+  }
+
+private :
+  const email_id_t email_file_;
+  const mbox_t reply_to_;
+  const email_slice_t slice_;
+  const deadline_t deadline_;
+  // Память email-а в бюджете, которую учитывают загрузчик и арена.
+  const memory_ticket memory_;
+
+  // Максимальное время ожидания ответов. Если до deadline осталось
+  // меньше, то ждать будем меньше.
+  const chrono::milliseconds io_timeout_{ 1500 };
+  const chrono::milliseconds checkers_timeout_{ 750 };
+
+  // Храним последний отрицательный результат для того, чтобы отослать
+  // его при входе в состояние st_failure.
+  check_status status_{ check_status::check_failure };
+
+  // Какие checker-ы создаются для каждого email-а.
+  using checkers = v7_checker_tags;
+  static_assert( checkers::size <= 32, "too many checkers" );
+  static constexpr uint32_t all_checks_passed =
+      static_cast< uint32_t >( (uint64_t{ 1 } << checkers::size) - 1 );
+  // Биты checker-ов, которые уже прислали положительный результат.
+  uint32_t checks_passed_{};
+
+  // Хранилище вердиктов (если используется) и ключ этого email-а в нем.
+  // Ключ вычисляется только после загрузки email-а целиком, поэтому
+  // в потоковом режиме хранилище не используется.
+  verdict_store * const verdicts_{ global_verdict_store() };
+  bool verdict_key_known_{ false };
+  verdict_key verdict_key_{};
+  // Версия правил, по которым проверяется email.
+  uint64_t rules_version_{};
+
+  // Сколько запросов к IO-агентам еще не получили ответа.
+  int io_requests_in_flight_{};
+  chrono::steady_clock::time_point io_requested_at_;
+  timer_id_t hedge_timer_;
+
+  // Данные потокового режима.
+  struct stream_data {
+    // Через этот mbox порции рассылаются checker-ам.
+    mbox_t chunks_;
+    streaming_email_parser parser_;
+    chunk_flow< load_email_chunk > flow_{ checkers::size };
+  };
+  unique_ptr< stream_data > stream_;
+
+  // Переход в состояние ожидания с тайм-аутом, который не выходит
+  // за deadline. Если время уже истекло, то сразу переходим в st_failure
+  // и возвращаем false.
+  bool enter_waiting_state( state_t & state, chrono::milliseconds timeout ) {
+    const auto left = time_left( deadline_, timeout );
+    if( left <= chrono::milliseconds::zero() ) {
+      st_failure.activate();
+      return false;
+    }
+
+    state.time_limit( left, st_failure );
+    state.activate();
+    return true;
+  }
+
+  unsigned primary_io_shard() const {
+    return static_cast< unsigned >( email_file_.value() % io_agent_shards );
+  }
+
+  void send_io_request( unsigned shard ) {
+    ++io_requests_in_flight_;
+    send< load_email_request >(
+        so_environment().create_mbox( io_agent_mbox_name( shard ) ),
+        email_file_,
+        so_direct_mbox(),
+        slice_,
+        deadline_,
+        memory_ );
+  }
+
+  void start_streaming() {
+    stream_ = make_unique< stream_data >();
+    stream_->chunks_ = so_environment().create_mbox();
+
+    introduce_child_coop( *this,
+      make_checkers_disp_binder(),
+      [&]( coop_t & coop ) {
+        for_each_checker_tag( checkers{}, [&]( auto tag ) {
+            using TAG = typename decltype(tag)::type;
+            coop.make_agent< streaming_checker_template< TAG > >(
+                so_direct_mbox(), stream_->chunks_, deadline_ );
+          } );
+      } );
+
+    request_chunk( 0 );
+  }
+
+  void request_chunk( uint64_t offset ) {
+    send< load_email_request >(
+        so_environment().create_mbox( io_agent_mbox_name( primary_io_shard() ) ),
+        email_file_,
+        so_direct_mbox(),
+        slice_,
+        deadline_,
+        memory_,
+        offset,
+        stream_chunk_size() );
+  }
+
+  void on_chunk_loaded( const load_email_chunk & msg ) {
+    stream_->flow_.loaded( msg,
+        [this]( const load_email_chunk & c ) { publish_chunk( c ); } );
+  }
+
+  void on_chunk_consumed() {
+    stream_->flow_.consumed(
+        [this]( const load_email_chunk & c ) { publish_chunk( c ); } );
+  }
+
+  void publish_chunk( const load_email_chunk & msg ) {
+    // Следующая порция загружается, пока checker-ы заняты этой.
+    if( !msg.last_ )
+      request_chunk( msg.offset_ + msg.content_.size() );
+
+    send< email_chunk >( stream_->chunks_,
+        stream_->parser_.feed( msg.content_, msg.last_ ) );
+  }
+
+  void on_hedge_io() {
+    if( io_agent_shards > 1 && global_io_hedging().try_hedge() )
+      send_io_request( (primary_io_shard() + 1) % io_agent_shards );
+  }
+
+  void on_load_succeed( const load_email_succeed & msg ) {
+    // Дубль уже не нужен.
+    hedge_timer_.release();
+    global_io_hedging().on_reply(
+        chrono::steady_clock::now() - io_requested_at_ );
+
+    // Если такое же содержимое уже проверялось, то checker-ы не нужны.
+    if( verdicts_ && use_known_verdict( msg.content_ ) )
+      return;
+
+    // Меняем состояние т.к. переходим к следующей операции.
+    if( !enter_waiting_state( st_wait_checkers, checkers_timeout_ ) )
+      return;
+
+    try {
+      auto parsed_data = parse_email( msg.content_ );
+      introduce_child_coop( *this,
+        // Агенты-checker-ы будут работать на своем собственном
+        // диспетчере, который был создан заранее под специальным именем.
+        make_checkers_disp_binder(),
+        [&]( coop_t & coop ) {
+          for_each_checker_tag( checkers{}, [&]( auto tag ) {
+              using TAG = typename decltype(tag)::type;
+              coop.make_agent< checker_template< TAG > >(
+                  so_direct_mbox(), parsed_data, deadline_ );
+            } );
+        } );
+    }
+    catch( const exception & ) {
+      st_failure.activate();
+    }
+  }
+
+  void on_load_failed( const load_email_failed & ) {
+    // Если есть еще запрос без ответа, то подождем его.
+    if( 0 == --io_requests_in_flight_ ) {
+      hedge_timer_.release();
+      st_failure.activate();
+    }
+  }
+
+  bool use_known_verdict( const email_content & content ) {
+    verdict_key_ = verdicts_->key_of( content.data(), content.size() );
+    verdict_key_known_ = true;
+    // Версия фиксируется до проверки: если правила поменяются во время
+    // проверки, то вердикт будет запомнен для старых правил.
+    rules_version_ = current_rules_version();
+
+    check_status known;
+    if( !verdicts_->find( verdict_key_, rules_version_, known ) )
+      return false;
+
+    if( check_status::safe == known )
+      st_success.activate();
+    else {
+      status_ = known;
+      st_failure.activate();
+    }
+    return true;
+  }
+
+  void remember_verdict( check_status status ) {
+    if( verdict_key_known_ )
+      verdicts_->remember( verdict_key_, rules_version_, status );
+  }
+
+  void on_checker_result( unsigned checker, check_status status ) {
+    // На первом же неудачном результате прерываем свою работу.
+    if( check_status::safe != status ) {
+      status_ = status;
+      remember_verdict( status );
+      st_failure.activate();
+    }
+    else {
+      checks_passed_ |= uint32_t{ 1 } << checker;
+      if( all_checks_passed == checks_passed_ ) {
+        // Все результаты получены. Можно завершать проверку с
+        // положительным результатом.
+        remember_verdict( check_status::safe );
+        st_success.activate();
+      }
+    }
+  }
+};
+
+// Менеджер параметризуется типом анализатора, чтобы с тем же конвейером
+// можно было использовать другие реализации email_analyzer
+// (например, на сопрограммах, см. v7_coro).
+template< typename ANALYZER >
+class basic_analyzer_manager final : public agent_t {
+  struct try_create_next_analyzer : public signal_t {};
+  struct analyzer_finished : public signal_t {};
+
+  // Потребуется еще один сигнал для таймера проверки времени жизни
+  // заявки в списке ожидания.
+  struct check_lifetime : public signal_t {};
+
+  // Кроме того, нам потребуется другая структура для хранения заявки
+  // в списке ожидания. Кроме самой заявки нужно будет хранить еще
+  // и время поступления в список ожидания.
+  using clock = chrono::steady_clock;
+  struct pending_request {
+    clock::time_point stored_at_;
+    check_request request_;
+  };
+
+public :
+  basic_analyzer_manager( context_t ctx )
+    : agent_t( ctx )
+    , analyzers_disp_(
+        disp::thread_pool::create_private_disp(
+            so_environment(),
+            // Без EMAIL_PLACEMENT по количеству ядер.
+            global_placement_plan().analyzer_threads_ ) )
+  {
+    so_subscribe_self()
+      .event( &basic_analyzer_manager::on_new_check_request )
+      .template event< try_create_next_analyzer >(
+          &basic_analyzer_manager::on_create_new_analyzer )
+      .template event< analyzer_finished >(
+          &basic_analyzer_manager::on_analyzer_finished )
+      // Для обработки таймера нам нужен еще одно событие-обработчик.
+      .template event< check_lifetime >( &basic_analyzer_manager::on_check_lifetime );
+  }
+
+  // Используем стартовый метод для того, чтобы запустить периодический таймер.
+  virtual void so_evt_start() override {
+    // Для периодических таймеров нужно сохранять возвращаемый timer_id,
+    // иначе таймер будет автоматически отменен.
+    check_lifetime_timer_ = send_periodic< check_lifetime >( *this, 500ms, 500ms );
+  }
+
+private :
+  const size_t max_parallel_analyzers_{ 16 };
+  size_t active_analyzers_{ 0 };
+
+  disp::thread_pool::private_dispatcher_handle_t analyzers_disp_;
+
+  // Ограничение на время пребывания заявки в списке ожидания.
+  const chrono::seconds max_lifetime_{ 10 };
+  // Идентификатор таймера для периодического сигнала check_lifetime.
+  timer_id_t check_lifetime_timer_;
+
+  list< pending_request > pending_requests_;
+
+  void on_new_check_request( const check_request & msg ) {
+    // Теперь при сохранении фиксируем время.
+    pending_requests_.push_back( pending_request{ clock::now(), msg } );
+    send< try_create_next_analyzer >( *this );
+  }
+
+  void on_create_new_analyzer() {
+    if( active_analyzers_ >= max_parallel_analyzers_ )
+      return;
+
+    // Если для очередной заявки не хватило памяти, то следующая попытка
+    // будет сделана после завершения одного из анализаторов.
+    if( lauch_new_analyzer()
+        && !pending_requests_.empty()
+        && active_analyzers_ < max_parallel_analyzers_ )
+      send< try_create_next_analyzer >( *this );
+  }
+
+  void on_analyzer_finished() {
+    --active_analyzers_;
+
+    if( !pending_requests_.empty() )
+      lauch_new_analyzer();
+  }
+
+  void on_check_lifetime() {
+    // У заявок может быть собственный deadline, поэтому заявки, которые
+    // подлежат изъятию, могут находиться в любом месте списка.
+    const auto now = clock::now();
+    for( auto it = pending_requests_.begin(); it != pending_requests_.end(); ) {
+      if( it->stored_at_ + max_lifetime_ < now ||
+          it->request_.deadline_ <= now )
+      {
+        reply_timedout( it->request_ );
+        it = pending_requests_.erase( it );
+      }
+      else
+        ++it;
+    }
+
+    // Память, которую занимали email-ы, освобождается не сразу после
+    // завершения анализаторов (например, ее еще держат опоздавшие
+    // ответы IO-агентов), поэтому периодически пробуем снова.
+    if( !pending_requests_.empty() )
+      send< try_create_next_analyzer >( *this );
+  }
+
+  // Отсылаем неудачный результат проверки email-а самостоятельно.
+  void reply_timedout( const check_request & request ) {
+    send< check_result >(
+      request.reply_to_,
+      request.email_file_,
+      check_status::check_timedout,
+      request.slice_ );
+  }
+
+  // Предварительная оценка памяти для email-а: его содержимое и
+  // примерно столько же для разобранного email-а. Размер email-а
+  // из большого файла известен заранее, для остальных берется
+  // типичный размер. Email, который загружается порциями, занимает
+  // не больше двух порций.
+  static size_t admission_estimate( const check_request & request ) {
+    if( email_should_stream( request.slice_ ) )
+      return 2 * stream_chunk_size();
+
+    const size_t typical_email_size = 64 * 1024;
+    return 2 * (request.slice_.empty() ?
+        typical_email_size : static_cast< size_t >( request.slice_.length_ ));
+  }
+
+  // Заявка принимается в работу, только если для нее есть место
+  // в бюджете памяти. Если же в работе нет ни одного email-а, то
+  // заявка принимается в любом случае, иначе email, который больше
+  // всего бюджета, не был бы проверен никогда.
+  memory_ticket admit( const check_request & request ) {
+    const auto estimate = admission_estimate( request );
+    if( !active_analyzers_ )
+      return make_memory_ticket( global_memory_budget(), estimate );
+    return try_make_memory_ticket( global_memory_budget(), estimate );
+  }
+
+  // Возвращает false, если заявка не принята из-за нехватки памяти.
+  bool lauch_new_analyzer() {
+    // Нет смысла создавать анализатора для заявки, время которой
+    // уже истекло.
+    while( !pending_requests_.empty() &&
+        deadline_expired( pending_requests_.front().request_.deadline_ ) )
+    {
+      reply_timedout( pending_requests_.front().request_ );
+      pending_requests_.pop_front();
+    }
+    if( pending_requests_.empty() )
+      return true;
+
+    auto memory = admit( pending_requests_.front().request_ );
+    if( !memory )
+      return false;
+
+    introduce_child_coop( *this,
+      analyzers_disp_->binder( disp::thread_pool::bind_params_t() ),
+      [this, &memory]( coop_t & coop ) {
+        coop.make_agent< ANALYZER >(
+          pending_requests_.front().request_.email_file_,
+          pending_requests_.front().request_.reply_to_,
+          pending_requests_.front().request_.slice_,
+          pending_requests_.front().request_.deadline_,
+          move(memory) );
+
+        coop.add_dereg_notificator(
+          [this]( environment_t &, const string &, const coop_dereg_reason_t & ) {
+            send< analyzer_finished >( *this );
+          } );
+      } );
+
+    ++active_analyzers_;
+
+    pending_requests_.pop_front();
+    return true;
+  }
+};
+
+using analyzer_manager = basic_analyzer_manager< email_analyzer >;
+
+// Запуск IO-агента и агента-менеджера. Возвращается mbox, на который
+// нужно отсылать запросы check_request.
+template< typename ANALYZER = email_analyzer >
+mbox_t make_pipeline( environment_t & env ) {
+  // Запускаем IO-агентов, которые уже должны работать к моменту,
+  // когда появятся первые агенты email_analyzer.
+  // У IO-агентов своя рабочая нить, чтобы их можно было вместе
+  // с таймерной нитью держать в стороне от нитей анализаторов.
+  make_io_agent( env, io_agent_shards,
+      disp::one_thread::create_private_disp( env )->binder() );
+
+  if( global_placement_plan().enabled_ )
+    make_placement_reporter( env );
+
+  // Список заблокированных адресов будет перестраиваться при изменении
+  // его файла, не останавливая проверки.
+  make_ip_blocklist_reloader( env );
+
+  // Теперь можно запускать агента-менеджера.
+  mbox_t checker_mbox;
+  env.introduce_coop( [&]( coop_t & coop ) {
+    auto manager = coop.make_agent< basic_analyzer_manager< ANALYZER > >();
+    // mbox агента-менеджера потребуется для формирования потока запросов.
+    checker_mbox = manager->so_direct_mbox();
+  } );
+
+  return checker_mbox;
+}
+
+// Настройка параметров SObjectizer Environment, которые нужны конвейеру.
+void tune_pipeline_params(
+  environment_params_t & params,
+  timer_mechanism timer = timer_mechanism_from_env() )
+{
+  use_timer_mechanism( params, timer );
+
+  // Все файлы из переменных окружения загружаются до старта
+  // SObjectizer Environment, чтобы ошибка в любом из них обнаружилась
+  // при запуске, а не при проверке первого email-а.
+  load_check_data();
+  load_from_env( "EMAIL_SPAM_MODEL", []{ global_spam_model(); } );
+  load_from_env( "EMAIL_VERDICT_STORE", []{ global_verdict_store(); } );
+
+  // Параметры настраиваются на той нити, которая затем запускает
+  // SObjectizer, поэтому ее привязку к CPU унаследуют все нити
+  // SObjectizer-а, включая таймерную.
+  apply_service_placement();
+
+  // Нужно создать диспетчера, на котором будут работать агенты-checker-ы.
+  params.add_named_dispatcher(
+      // По этому имени затем агенты-checker-ы будут привязываться
+      // к данному диспетчеру.
+      "checkers",
+      // Для демонстрации отводим агентам-checker-ам всего
+      // две рабочие нити (если не задана EMAIL_PLACEMENT).
+      checkers_use_work_stealing() ?
+          create_work_stealing_disp( global_placement_plan().checker_threads_ ) :
+          disp::thread_pool::create_disp( global_placement_plan().checker_threads_ ) );
+}
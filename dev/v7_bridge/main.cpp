@@ -0,0 +1,63 @@
+#include <v7/pipeline.hpp>
+#include <common/uds_bridge.hpp>
+
+// Фронтальный процесс: имитатор запросов отсылает их не
+// analyzer_manager-у, а агенту bridge_front, который раздает их
+// рабочим процессам.
+void run_front( size_t total_requests, vector< string > workers ) {
+  so_5::launch( [&]( environment_t & env ) {
+    mbox_t checker_mbox;
+    env.introduce_coop( [&]( coop_t & coop ) {
+      checker_mbox = coop.make_agent< bridge_front >( move(workers) )
+          ->so_direct_mbox();
+    } );
+
+    env.introduce_coop(
+      disp::one_thread::create_private_disp( env )->binder(),
+      [checker_mbox, total_requests]( coop_t & coop ) {
+        coop.make_agent< requests_initiator >( checker_mbox, total_requests );
+      } );
+  },
+  []( environment_params_t & params ) {
+    use_timer_mechanism( params, timer_mechanism_from_env() );
+  } );
+}
+
+// Рабочий процесс: обычный конвейер из v7, запросы для которого
+// приходят через сокет.
+void run_worker( string socket_path ) {
+  so_5::launch( [&]( environment_t & env ) {
+    const auto checker_mbox = make_pipeline( env );
+
+    env.introduce_coop(
+      disp::one_thread::create_private_disp( env )->binder(),
+      [&]( coop_t & coop ) {
+        coop.make_agent< bridge_worker >( checker_mbox, move(socket_path) );
+      } );
+  },
+  []( environment_params_t & params ) {
+    tune_pipeline_params( params );
+  } );
+}
+
+int main( int argc, char ** argv ) {
+  const string mode = argc > 1 ? argv[1] : "";
+  if( !( ("worker" == mode && 3 == argc) || ("front" == mode && argc > 3) ) ) {
+    cerr << "Usage: " << argv[0] << " worker <socket>\n"
+        "       " << argv[0] << " front <requests> <socket>..." << endl;
+    return 1;
+  }
+
+  try {
+    if( "worker" == mode )
+      run_worker( argv[2] );
+    else
+      run_front( stoul( argv[2] ), vector< string >( argv + 3, argv + argc ) );
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
@@ -0,0 +1,265 @@
+// Вариант email_analyzer из v7, написанный как сопрограмма C++20.
+//
+// В v7 одна линейная последовательность действий (загрузить email,
+// раздать его checker-ам, собрать результаты, ответить) разнесена
+// по состояниям st_wait_io, st_wait_checkers, st_finishing и по
+// нескольким обработчикам. Здесь та же последовательность записана
+// одной функцией, а все ее данные живут в кадре сопрограммы.
+//
+// Пример также является замером: запускается тот же конвейер, что и в v7,
+// с одним из двух вариантов анализатора, и выводятся затраты процессора
+// на один email и расход памяти на один анализатор.
+//
+// Использование: v7_coro [coroutine|state_machine] [количество email-ов]
+
+#include <v7/pipeline.hpp>
+#include <common/agent_coroutine.hpp>
+
+#if defined(EMAIL_COUNT_ALLOCATIONS)
+  #include <common/counting_new.hpp>
+#endif
+
+#include <optional>
+
+#include <sys/resource.h>
+
+class coro_email_analyzer final : public coroutine_agent_t {
+public :
+  coro_email_analyzer( context_t ctx,
+    email_id_t email_file,
+    mbox_t reply_to,
+    email_slice_t slice,
+    deadline_t deadline,
+    memory_ticket memory )
+    : coroutine_agent_t(ctx)
+    , email_file_(email_file)
+    , reply_to_(move(reply_to))
+    , slice_(slice)
+    , deadline_(deadline)
+    , memory_(move(memory))
+  {}
+
+  virtual void so_define_agent() override {
+    subscribe_awaited< load_email_succeed, load_email_failed >();
+    for_each_checker_tag( checkers{}, [this]( auto tag ) {
+        using TAG = typename decltype(tag)::type;
+        subscribe_awaited< typename checker_template< TAG >::result >();
+      } );
+  }
+
+  virtual void so_evt_start() override {
+    pin_current_thread( placement_role::analyzers );
+    start_coroutine( analyze() );
+  }
+
+private :
+  using clock = chrono::steady_clock;
+  using checkers = v7_checker_tags;
+
+  static constexpr uint32_t all_checks_passed =
+      static_cast< uint32_t >( (uint64_t{ 1 } << checkers::size) - 1 );
+
+  const email_id_t email_file_;
+  const mbox_t reply_to_;
+  const email_slice_t slice_;
+  const deadline_t deadline_;
+  // Память email-а в бюджете, которую учитывают загрузчик и арена.
+  const memory_ticket memory_;
+
+  // Максимальное время ожидания ответов, как и в email_analyzer.
+  const chrono::milliseconds io_timeout_{ 1500 };
+  const chrono::milliseconds checkers_timeout_{ 750 };
+
+  agent_task analyze() {
+    // Результат, который будет отослан, если что-то пойдет не так.
+    auto status = check_status::check_failure;
+    optional< parsed_email_ref > email;
+    // Вердикт, который уже есть в хранилище вердиктов.
+    optional< check_status > known;
+    verdict_store * const verdicts = global_verdict_store();
+    verdict_key key{};
+    const auto rules_version = verdicts ? current_rules_version() : 0;
+
+    // Загрузка email-а. Если ответ задержится дольше, чем обычно,
+    // то запрос дублируется другому IO-агенту.
+    const auto io_left = time_left( deadline_, io_timeout_ );
+    if( io_left > chrono::milliseconds::zero() ) {
+      const auto requested_at = clock::now();
+      const auto io_until = requested_at + io_left;
+      auto hedge_at = requested_at + global_io_hedging().hedge_delay();
+      int in_flight = 1;
+      send_io_request( primary_io_shard() );
+      global_io_hedging().on_request_sent();
+
+      for( auto now = requested_at; now < io_until && !email; now = clock::now() ) {
+        const auto r = co_await receive< load_email_succeed, load_email_failed >(
+            min( hedge_at, io_until ) - now );
+
+        if( const auto * loaded = r.get< load_email_succeed >() ) {
+          global_io_hedging().on_reply( clock::now() - requested_at );
+          if( verdicts ) {
+            key = verdicts->key_of( loaded->content_.data(), loaded->content_.size() );
+            check_status v;
+            if( verdicts->find( key, rules_version, v ) ) {
+              known = v;
+              break;
+            }
+          }
+          try {
+            email = parse_email( loaded->content_ );
+          }
+          catch( const exception & ) {
+            break;
+          }
+        }
+        else if( r.get< load_email_failed >() ) {
+          // Если есть еще запрос без ответа, то подождем его.
+          if( 0 == --in_flight )
+            break;
+        }
+        else if( hedge_at < io_until ) {
+          hedge_at = clock::time_point::max();
+          if( io_agent_shards > 1 && global_io_hedging().try_hedge() ) {
+            ++in_flight;
+            send_io_request( (primary_io_shard() + 1) % io_agent_shards );
+          }
+        }
+      }
+    }
+
+    // Проверка email-а checker-ами.
+    const auto checkers_left = time_left( deadline_, checkers_timeout_ );
+    if( known )
+      status = *known;
+    else if( email && checkers_left > chrono::milliseconds::zero() ) {
+      introduce_child_coop( *this,
+        make_checkers_disp_binder(),
+        [&]( coop_t & coop ) {
+          for_each_checker_tag( checkers{}, [&]( auto tag ) {
+              using TAG = typename decltype(tag)::type;
+              coop.make_agent< checker_template< TAG > >(
+                  so_direct_mbox(), *email, deadline_ );
+            } );
+        } );
+
+      const auto until = clock::now() + checkers_left;
+      uint32_t passed = 0;
+      for( auto now = clock::now(); now < until; now = clock::now() ) {
+        const auto r = co_await receive_results( checkers{}, until - now );
+        if( r.timed_out() )
+          break;
+
+        auto result = check_status::safe;
+        r.visit( [&]( const auto & msg ) { result = msg.status_; } );
+        if( check_status::safe != result ) {
+          // На первом же неудачном результате прекращаем проверку.
+          status = result;
+          break;
+        }
+
+        passed |= uint32_t{ 1 } << r.index();
+        if( all_checks_passed == passed ) {
+          status = check_status::safe;
+          break;
+        }
+      }
+
+      if( verdicts )
+        verdicts->remember( key, rules_version, status );
+    }
+
+    if( check_status::check_failure == status && deadline_expired( deadline_ ) )
+      status = check_status::check_timedout;
+
+    send< check_result >( reply_to_, email_file_, status, slice_ );
+    so_deregister_agent_coop_normally();
+  }
+
+  // Ожидание результата от любого из checker-ов списка.
+  template< typename... TAGS >
+  receive_awaiter< typename checker_template< TAGS >::result... >
+  receive_results( checker_tags< TAGS... >, clock::duration timeout ) {
+    return receive< typename checker_template< TAGS >::result... >( timeout );
+  }
+
+  unsigned primary_io_shard() const {
+    return static_cast< unsigned >( email_file_.value() % io_agent_shards );
+  }
+
+  void send_io_request( unsigned shard ) {
+    send< load_email_request >(
+        so_environment().create_mbox( io_agent_mbox_name( shard ) ),
+        email_file_,
+        so_direct_mbox(),
+        slice_,
+        deadline_,
+        memory_ );
+  }
+};
+
+double cpu_seconds() {
+  rusage usage{};
+  getrusage( RUSAGE_SELF, &usage );
+  const auto seconds = []( const timeval & t ) {
+    return static_cast< double >( t.tv_sec ) + t.tv_usec / 1e6;
+  };
+  return seconds( usage.ru_utime ) + seconds( usage.ru_stime );
+}
+
+long peak_rss_kib() {
+  rusage usage{};
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss;
+}
+
+template< typename ANALYZER >
+void do_imitation( size_t requests ) {
+  so_5::launch( [requests]( environment_t & env ) {
+    const auto checker_mbox = make_pipeline< ANALYZER >( env );
+
+    env.introduce_coop(
+      disp::one_thread::create_private_disp( env )->binder(),
+      [checker_mbox, requests]( coop_t & coop ) {
+        coop.make_agent< requests_initiator >( checker_mbox, requests );
+      } );
+  },
+  []( environment_params_t & params ) {
+    tune_pipeline_params( params );
+  } );
+}
+
+int main( int argc, char ** argv ) {
+  try {
+    const string variant = argc > 1 ? argv[1] : "coroutine";
+    const size_t requests = argc > 2 ? stoul( argv[2] ) : 1000;
+    if( "coroutine" != variant && "state_machine" != variant )
+      throw runtime_error( "usage: v7_coro [coroutine|state_machine] [emails]" );
+
+    const auto cpu_started = cpu_seconds();
+    size_t analyzer_size;
+    if( "coroutine" == variant ) {
+      do_imitation< coro_email_analyzer >( requests );
+      analyzer_size = sizeof(coro_email_analyzer);
+    }
+    else {
+      do_imitation< email_analyzer >( requests );
+      analyzer_size = sizeof(email_analyzer);
+    }
+    const auto cpu = cpu_seconds() - cpu_started;
+
+    const auto & frames = global_coroutine_frame_stats();
+    const size_t frame_size = frames.frames_ ? frames.bytes_ / frames.frames_ : 0;
+
+    cerr << variant << ": " << requests << " email(s)"
+        << ", cpu per email: " << cpu / requests * 1e6 << "us"
+        << ", analyzer: " << analyzer_size << " bytes"
+        << ", coroutine frame: " << frame_size << " bytes"
+        << ", peak rss: " << peak_rss_kib() << "KiB" << endl;
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
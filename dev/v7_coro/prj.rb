@@ -0,0 +1,20 @@
+#!/usr/bin/ruby
+require 'rubygems'
+
+gem 'Mxx_ru', '>= 1.3.0'
+
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+  target 'v7_coro_app'
+
+  required_prj 'so_5/prj_s.rb'
+
+  # Сопрограммы требуют C++20, тогда как остальные примеры собираются
+  # в режиме C++14. Опция цели указывается после общей -std=c++14,
+  # поэтому компилятор использует именно ее.
+  compiler_option '-std=c++20'
+
+  cpp_source 'main.cpp'
+}
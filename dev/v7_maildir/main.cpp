@@ -0,0 +1,41 @@
+#include <v7/pipeline.hpp>
+#include <common/maildir_watcher.hpp>
+
+// Проверка писем, которые доставляются в Maildir-ы, заданные в командной
+// строке. Работа продолжается до получения SIGINT или SIGTERM.
+void do_watching( const vector< string > & maildirs ) {
+  // Каталоги проверяются до запуска SObjectizer: ошибка в командной
+  // строке должна завершать приложение с понятным сообщением.
+  auto watch = make_unique< maildir_watch >( maildirs );
+
+  so_5::launch( [&]( environment_t & env ) {
+    const auto checker_mbox = make_pipeline( env );
+
+    env.introduce_coop(
+      disp::one_thread::create_private_disp( env )->binder(),
+      [&]( coop_t & coop ) {
+        coop.make_agent< maildir_watcher >( checker_mbox, move(watch) );
+      } );
+  },
+  []( environment_params_t & params ) {
+    tune_pipeline_params( params );
+  } );
+}
+
+int main( int argc, char ** argv ) {
+  if( argc < 2 ) {
+    cerr << "Usage: " << argv[0] << " <maildir>..." << endl;
+    return 1;
+  }
+
+  try {
+    block_termination_signals();
+    do_watching( vector< string >( argv + 1, argv + argc ) );
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
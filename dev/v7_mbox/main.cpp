@@ -0,0 +1,37 @@
+#include <v7/pipeline.hpp>
+#include <common/mbox_ingestor.hpp>
+
+// Проверка писем из mbox-файлов, имена которых заданы в командной строке.
+void do_ingestion( vector< string > files ) {
+  so_5::launch( [&]( environment_t & env ) {
+    const auto checker_mbox = make_pipeline( env );
+
+    // Разбиение mbox-файлов занимает заметное время, поэтому агент-источник
+    // работает на собственной рабочей нити.
+    env.introduce_coop(
+      disp::one_thread::create_private_disp( env )->binder(),
+      [&]( coop_t & coop ) {
+        coop.make_agent< mbox_ingestor >( checker_mbox, move(files) );
+      } );
+  },
+  []( environment_params_t & params ) {
+    tune_pipeline_params( params );
+  } );
+}
+
+int main( int argc, char ** argv ) {
+  if( argc < 2 ) {
+    cerr << "Usage: " << argv[0] << " <mbox-file>..." << endl;
+    return 1;
+  }
+
+  try {
+    do_ingestion( vector< string >( argv + 1, argv + argc ) );
+    return 0;
+  }
+  catch( const exception & x ) {
+    cerr << "Oops! " << x.what() << endl;
+  }
+
+  return 2;
+}
@@ -0,0 +1,23 @@
+#!/usr/bin/ruby
+require 'rubygems'
+
+gem 'Mxx_ru', '>= 1.3.0'
+
+require 'mxx_ru/cpp'
+
+MxxRu::Cpp::exe_target {
+
+  target 'v7_mbox_app'
+
+  required_prj 'so_5/prj_s.rb'
+
+  # Чтение .mbox.zst требует libzstd и включается только по запросу:
+  #   EMAIL_WITH_ZSTD=1 ruby build.rb
+  if ENV[ 'EMAIL_WITH_ZSTD' ]
+    define 'EMAIL_WITH_ZSTD'
+    lib 'zstd'
+  end
+
+  cpp_source 'main.cpp'
+}
+